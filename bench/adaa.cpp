@@ -0,0 +1,188 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * Compares the BitCrusher quantizer with antiderivative anti-aliasing (see BitCrusher::setAntiAliasing())
+ * against the plain quantizer and the plain quantizer running at 2x and 4x oversampling (see Oversampler)
+ *
+ * A 5 kHz sine is crushed to 8 bits and the output spectrum is analysed using coherent sampling (the sine
+ * completes an integer, odd amount of periods within the transform) so each harmonic of the staircase lands on
+ * a single bin. Harmonics below Nyquist are the intended distortion, all remaining bins hold the harmonics that
+ * folded back, e.g. the aliasing. The cost is measured as the processing time of a stereo buffer.
+ *
+ * Built when configured with -DBUILD_BENCHMARKS=ON, run from the build directory as ./bench_adaa
+ */
+#include "../src/bitcrusher.h"
+#include "../src/fft.h"
+#include "../src/global.h"
+#include "../src/oversampler.h"
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+
+using namespace Igorski;
+
+float VST::SAMPLE_RATE = 44100.f;
+int VST::BUFFER_SIZE   = 512;
+
+namespace {
+
+    const int    AMOUNT_OF_CHANNELS = 2;
+    const float  BITS               = 8.f;
+    const int    FFT_SIZE           = 16384;
+    const int    SINE_BIN           = 1857;  // ~5 kHz at 44.1 kHz, odd so it shares no factor with FFT_SIZE
+    const float  SINE_AMPLITUDE     = .9f;
+    const int    WARMUP_BUFFERS     = 16;    // lets the oversampling filters settle
+    const int    TIMED_BUFFERS      = 20000;
+    const double TWO_PI             = 6.283185307179586;
+
+    struct Mode {
+        const char* name;
+        bool antiAliasing;
+        int oversampling;
+    };
+
+    const Mode MODES[] = {
+        { "plain",    false, 1 },
+        { "ADAA",     true,  1 },
+        { "plain 2x", false, 2 },
+        { "plain 4x", false, 4 },
+        { "ADAA 2x",  true,  2 },
+    };
+
+    // a periodic sine (the phase is derived from the sample index modulo FFT_SIZE so all periods are identical)
+
+    void renderSine( AudioBuffer* buffer, long long offset, int bufferSize )
+    {
+        for ( int c = 0; c < buffer->amountOfChannels; ++c ) {
+            float* channelBuffer = buffer->getBufferForChannel( c );
+            for ( int i = 0; i < bufferSize; ++i ) {
+                long long index = (( offset + i ) * SINE_BIN ) % FFT_SIZE;
+                channelBuffer[ i ] = SINE_AMPLITUDE * ( float ) sin( TWO_PI * ( double ) index / FFT_SIZE );
+            }
+        }
+    }
+
+    struct Result {
+        float fundamental; // level of the sine in dBFS
+        float aliasing;    // summed power of the folded harmonics relative to the sine, in dB
+        double time;       // in microseconds per buffer
+    };
+
+    Result run( const Mode& mode )
+    {
+        int bufferSize = VST::BUFFER_SIZE;
+
+        BitCrusher crusher(( BITS - 1.f ) / 15.f, 1.f, 1.f, AMOUNT_OF_CHANNELS ); // see BitCrusher::calcBits()
+        Oversampler oversampler( AMOUNT_OF_CHANNELS, bufferSize );
+        AudioBuffer buffer( AMOUNT_OF_CHANNELS, bufferSize );
+
+        crusher.setAntiAliasing( mode.antiAliasing );
+        crusher.setProcessingRate(( float ) mode.oversampling );
+        oversampler.setFactor( mode.oversampling );
+
+        auto stage = [ &crusher ]( AudioBuffer* stageBuffer, int stageSize ) {
+            crusher.process( stageBuffer, stageSize );
+        };
+
+        long long offset = 0;
+
+        for ( int b = 0; b < WARMUP_BUFFERS; ++b, offset += bufferSize ) {
+            renderSine( &buffer, offset, bufferSize );
+            oversampler.process( &buffer, bufferSize, stage );
+        }
+
+        // capture a single period of the analysis
+
+        std::vector<float> output( FFT_SIZE );
+        for ( int i = 0; i < FFT_SIZE; i += bufferSize, offset += bufferSize ) {
+            renderSine( &buffer, offset, bufferSize );
+            oversampler.process( &buffer, bufferSize, stage );
+            std::copy( buffer.getBufferForChannel( 0 ), buffer.getBufferForChannel( 0 ) + bufferSize, output.begin() + i );
+        }
+
+        FFT fft( FFT_SIZE );
+        std::vector<float> real( fft.getAmountOfBins() );
+        std::vector<float> imag( fft.getAmountOfBins() );
+        fft.forward( output.data(), real.data(), imag.data() );
+
+        double fundamentalPower = 0.0;
+        double aliasPower       = 0.0;
+
+        for ( int k = 1; k < fft.getAmountOfBins(); ++k ) {
+            double power = ( double ) real[ k ] * real[ k ] + ( double ) imag[ k ] * imag[ k ];
+
+            if ( k == SINE_BIN ) {
+                fundamentalPower = power;
+            } else if ( k % SINE_BIN != 0 ) {
+                aliasPower += power; // not a harmonic below Nyquist
+            }
+        }
+
+        Result result;
+        result.fundamental = 10.f * log10f(( float ) ( fundamentalPower / ( FFT_SIZE * FFT_SIZE / 4.0 )));
+        result.aliasing    = 10.f * log10f(( float ) ( aliasPower / fundamentalPower ));
+
+        // timing (the signal is rendered up front so only the crushing is measured)
+
+        std::vector<AudioBuffer*> input;
+        for ( int b = 0; b < 8; ++b, offset += bufferSize ) {
+            input.push_back( new AudioBuffer( AMOUNT_OF_CHANNELS, bufferSize ));
+            renderSine( input.back(), offset, bufferSize );
+        }
+
+        auto start = std::chrono::steady_clock::now();
+
+        for ( int b = 0; b < TIMED_BUFFERS; ++b ) {
+            AudioBuffer* source = input[ b % input.size() ];
+            for ( int c = 0; c < AMOUNT_OF_CHANNELS; ++c ) {
+                std::copy( source->getBufferForChannel( c ), source->getBufferForChannel( c ) + bufferSize, buffer.getBufferForChannel( c ));
+            }
+            oversampler.process( &buffer, bufferSize, stage );
+        }
+        result.time = std::chrono::duration<double, std::micro>( std::chrono::steady_clock::now() - start ).count() / TIMED_BUFFERS;
+
+        for ( AudioBuffer* inputBuffer : input ) {
+            delete inputBuffer;
+        }
+        return result;
+    }
+}
+
+int main()
+{
+    printf( "%d bit quantizer, %.0f Hz sine at %.1f kHz, %d channels x %d samples per buffer\n\n",
+        ( int ) BITS, SINE_BIN * VST::SAMPLE_RATE / FFT_SIZE, VST::SAMPLE_RATE / 1000.f, AMOUNT_OF_CHANNELS, VST::BUFFER_SIZE );
+    printf( "%-10s %12s %12s %14s %10s\n", "mode", "sine (dBFS)", "alias (dBc)", "us per buffer", "cost" );
+
+    double plainTime = 0.0;
+
+    for ( const Mode& mode : MODES ) {
+        Result result = run( mode );
+        if ( plainTime == 0.0 ) {
+            plainTime = result.time;
+        }
+        printf( "%-10s %12.2f %12.2f %14.2f %9.2fx\n", mode.name, result.fundamental, result.aliasing, result.time, result.time / plainTime );
+    }
+    return 0;
+}
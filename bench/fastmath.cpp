@@ -0,0 +1,188 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/**
+ * Verifies the documented maximum errors of the fast math approximations (see fastmath.h) against
+ * the double precision libm implementation and compares their cost to the single precision libm functions
+ *
+ * The error of each function is measured over its documented input range, either by sweeping the float
+ * representations within the range (for functions whose error is relative to the magnitude of the input)
+ * or by evenly spaced values. The program exits with a non-zero status when a documented bound is exceeded.
+ *
+ * Built when configured with -DBUILD_BENCHMARKS=ON, run from the build directory as ./bench_fastmath
+ */
+#include "../src/fastmath.h"
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <vector>
+
+using namespace Igorski;
+
+namespace {
+
+    const int BLOCK_SIZE     = 4096;
+    const int TIMED_BLOCKS   = 20000;
+    const int SWEEP_SIZE     = 1 << 22; // amount of evenly spaced values
+    const int SWEEP_STRIDE   = 61;      // distance between the swept float representations
+
+    enum ErrorType {
+        ABSOLUTE,
+        RELATIVE
+    };
+
+    struct Accuracy {
+        const char* name;
+        ErrorType type;
+        double bound; // as documented in fastmath.h
+        float ( *approximation )( float );
+        double ( *reference )( double );
+        float min;
+        float max;
+        bool sweepRepresentations;
+        bool isOdd; // whether the negated swept representations are measured as well
+    };
+
+    const Accuracy ACCURACIES[] = {
+        { "fastExp2",       RELATIVE, 1.7e-7, Calc::fastExp2,
+          []( double x ) { return exp2( x ); }, -126.f, 126.f, false, false },
+        { "fastLog2",       ABSOLUTE, 5.3e-6, Calc::fastLog2,
+          []( double x ) { return log2( x ); }, 1.17549435e-38f, 3.40282347e+38f, true, false },
+        { "dbToLinear",     RELATIVE, 2.4e-6, Calc::dbToLinear,
+          []( double x ) { return pow( 10.0, x / 20.0 ); }, -200.f, 200.f, false, false },
+        { "linearToDb",     ABSOLUTE, 3.0e-5, Calc::linearToDb,
+          []( double x ) { return 20.0 * log10( std::max(( double ) Calc::MIN_LINEAR, x )); }, Calc::MIN_LINEAR, 1.0e10f, true, false },
+        { "fastTanh",       ABSOLUTE, 2.4e-7, Calc::fastTanh,
+          []( double x ) { return tanh( x ); }, -64.f, 64.f, false, false },
+        { "fastReciprocal", RELATIVE, 2.0e-7, Calc::fastReciprocal,
+          []( double x ) { return 1.0 / x; }, 1.0e-37f, 1.0e37f, true, true },
+    };
+
+    double measureError( const Accuracy& accuracy, float value )
+    {
+        double expected = accuracy.reference(( double ) value );
+        double error    = fabs(( double ) accuracy.approximation( value ) - expected );
+
+        return ( accuracy.type == RELATIVE ) ? error / fabs( expected ) : error;
+    }
+
+    double measureMaxError( const Accuracy& accuracy )
+    {
+        double maxError = 0.0;
+
+        if ( accuracy.sweepRepresentations )
+        {
+            int32_t first = Calc::asInt( accuracy.min );
+            int32_t last  = Calc::asInt( accuracy.max );
+
+            for ( int64_t bits = first; bits <= last; bits += SWEEP_STRIDE ) {
+                float value = Calc::asFloat(( int32_t ) bits );
+                maxError = std::max( maxError, measureError( accuracy, value ));
+                if ( accuracy.isOdd ) {
+                    maxError = std::max( maxError, measureError( accuracy, -value ));
+                }
+            }
+            return maxError;
+        }
+
+        for ( int i = 0; i <= SWEEP_SIZE; ++i ) {
+            float value = accuracy.min + ( accuracy.max - accuracy.min ) * ( float ) (( double ) i / SWEEP_SIZE );
+            maxError = std::max( maxError, measureError( accuracy, value ));
+        }
+        return maxError;
+    }
+
+    // cost of the block variants against the single precision libm functions
+
+    struct Benchmark {
+        const char* name;
+        void ( *approximation )( const float*, float*, int );
+        float ( *reference )( float );
+        float min;
+        float max;
+    };
+
+    const Benchmark BENCHMARKS[] = {
+        { "fastExp2",       Calc::fastExp2,       []( float x ) { return exp2f( x ); },                 -20.f, 20.f },
+        { "fastLog2",       Calc::fastLog2,       []( float x ) { return log2f( x ); },                 1.0e-5f, 10.f },
+        { "dbToLinear",     Calc::dbToLinear,     []( float x ) { return powf( 10.f, x / 20.f ); },     -96.f, 12.f },
+        { "linearToDb",     Calc::linearToDb,     []( float x ) { return 20.f * log10f( x ); },         1.0e-5f, 4.f },
+        { "fastTanh",       Calc::fastTanh,       []( float x ) { return tanhf( x ); },                 -4.f, 4.f },
+        { "fastReciprocal", Calc::fastReciprocal, []( float x ) { return 1.f / x; },                    .1f, 10.f },
+    };
+
+    template <typename Function>
+    double time( Function function )
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        for ( int b = 0; b < TIMED_BLOCKS; ++b ) {
+            function();
+        }
+        double duration = std::chrono::duration<double, std::nano>( std::chrono::steady_clock::now() - start ).count();
+
+        return duration / (( double ) TIMED_BLOCKS * BLOCK_SIZE );
+    }
+}
+
+int main()
+{
+    bool isWithinBounds = true;
+
+    printf( "%-15s %9s %12s %12s\n", "accuracy", "error", "documented", "measured" );
+
+    for ( const Accuracy& accuracy : ACCURACIES ) {
+        double maxError = measureMaxError( accuracy );
+        bool isValid    = maxError <= accuracy.bound;
+
+        printf( "%-15s %9s %12.2e %12.2e %s\n", accuracy.name, accuracy.type == RELATIVE ? "relative" : "absolute",
+            accuracy.bound, maxError, isValid ? "" : "EXCEEDS BOUND" );
+
+        isWithinBounds = isWithinBounds && isValid;
+    }
+
+    printf( "\n%-15s %16s %16s %9s\n", "cost", "fast (ns/value)", "libm (ns/value)", "speedup" );
+
+    std::vector<float> input( BLOCK_SIZE );
+    std::vector<float> output( BLOCK_SIZE );
+    float sink = 0.f; // keeps the results alive
+
+    for ( const Benchmark& benchmark : BENCHMARKS ) {
+        for ( int i = 0; i < BLOCK_SIZE; ++i ) {
+            input[ i ] = benchmark.min + ( benchmark.max - benchmark.min ) * ( float ) i / ( float ) BLOCK_SIZE;
+        }
+        double fastTime = time( [ & ]() {
+            benchmark.approximation( input.data(), output.data(), BLOCK_SIZE );
+            sink += output[ BLOCK_SIZE - 1 ];
+        });
+        double libmTime = time( [ & ]() {
+            for ( int i = 0; i < BLOCK_SIZE; ++i ) {
+                output[ i ] = benchmark.reference( input[ i ]);
+            }
+            sink += output[ BLOCK_SIZE - 1 ];
+        });
+        printf( "%-15s %16.3f %16.3f %8.1fx\n", benchmark.name, fastTime, libmTime, libmTime / fastTime );
+    }
+    printf( "\n%s (%g)\n", isWithinBounds ? "all errors within the documented bounds" : "documented bounds exceeded", sink * 0.f );
+
+    return isWithinBounds ? 0 : 1;
+}
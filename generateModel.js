@@ -34,7 +34,7 @@ const MODEL = [
         value: { min: "0.f", max: "1.f", def: "1.f", type: "percent" },
         ui: { x: 199, y: 165, w: 104, h: 21 },
         // note we treat full resolution as 16-bits (but is in fact whatever host is)
-        customDescr: `sprintf( text, "%.d Bits", ( int ) ( 15 * valueNormalized ) + 1 );`
+        customDescr: `sprintf( text, "%.1f Bits", ( float ) ( 15 * valueNormalized ) + 1.f );`
     },
     {
         name: "bitCrushLfo",
@@ -64,6 +64,398 @@ const MODEL = [
         unitDescr: "%",
         value: { min: "0.f", max: "1.f", type: "percent" },
         ui: { x: 10, y: 180, w: 134, h: 21 }
+    },
+    {
+        name: "decimation",
+        descr: "Downsampling",
+        unitDescr: "%",
+        value: { min: "0.f", max: "1.f", type: "percent" },
+        ui: { x: 199, y: 195, w: 104, h: 21 }
+    },
+    {
+        name: "decimationLfoDepth",
+        descr: "Downsampling LFO depth",
+        unitDescr: "%",
+        value: { min: "0.f", max: "1.f", type: "percent" },
+        ui: { x: 199, y: 225, w: 104, h: 21 }
+    },
+    {
+        name: "dither",
+        descr: "Dither",
+        unitDescr: "",
+        value: { min: "0", max: "1", def: "0", type: "bool" },
+        ui: { x: 360, y: 90, w: 130, h: 21 }
+    },
+    {
+        name: "noiseShaping",
+        descr: "Noise shaping",
+        unitDescr: "",
+        value: { min: "0", max: "1", def: "0", type: "bool" },
+        ui: { x: 360, y: 120, w: 130, h: 21 }
+    },
+    {
+        name: "outputWordLength",
+        descr: "16-bit output",
+        unitDescr: "",
+        value: { min: "0", max: "1", def: "0", type: "bool" },
+        ui: { x: 360, y: 150, w: 130, h: 21 }
+    },
+    {
+        name: "antiAliasing",
+        descr: "Anti-aliasing",
+        unitDescr: "",
+        value: { min: "0", max: "1", def: "0", type: "bool" },
+        ui: { x: 360, y: 180, w: 130, h: 21 }
+    },
+    {
+        name: "bitCrushLfoWaveform",
+        descr: "Bit crush LFO waveform",
+        unitDescr: "",
+        value: { min: "0.f", max: "1.f" },
+        ui: { x: 10, y: 60, w: 134, h: 21 },
+        customDescr: `sprintf( text, "%s", LFO_WAVEFORM_NAMES[ ( int ) round( valueNormalized * 4.f ) ] );`
+    },
+    {
+        name: "modLfoRate",
+        descr: "Mod LFO rate",
+        unitDescr: "Hz",
+        value: { min: "0.f", max: "10.f" },
+        ui: { x: 360, y: 210, w: 134, h: 21 },
+        normalizedDescr: true
+    },
+    {
+        name: "modLfoDepth",
+        descr: "Mod LFO to downsampling",
+        unitDescr: "%",
+        value: { min: "0.f", max: "1.f", def: "0.f", type: "percent" },
+        ui: { x: 360, y: 240, w: 134, h: 21 }
+    },
+    {
+        name: "envelopeDepth",
+        descr: "Envelope to resolution",
+        unitDescr: "%",
+        value: { min: "0.f", max: "1.f", def: "0.f", type: "percent" },
+        ui: { x: 360, y: 270, w: 134, h: 21 }
+    },
+    {
+        name: "oversampling",
+        descr: "Oversampling",
+        unitDescr: "",
+        value: { min: "0.f", max: "1.f", def: "0.f" },
+        ui: { x: 10, y: 210, w: 134, h: 21 },
+        customDescr: `sprintf( text, "%dx", 1 << ( int ) round( valueNormalized * 3.f ));`
+    },
+    {
+        name: "linearPhase",
+        descr: "Linear phase",
+        unitDescr: "",
+        value: { min: "0", max: "1", def: "1", type: "bool" },
+        ui: { x: 10, y: 240, w: 130, h: 21 }
+    },
+    {
+        name: "ecoMode",
+        descr: "Eco mode",
+        unitDescr: "",
+        value: { min: "0", max: "1", def: "0", type: "bool" },
+        ui: { x: 10, y: 270, w: 130, h: 21 }
+    },
+    {
+        name: "convolutionMix",
+        descr: "Convolution mix",
+        unitDescr: "%",
+        value: { min: "0.f", max: "1.f", def: "0.f", type: "percent" },
+        ui: { x: 199, y: 255, w: 104, h: 21 }
+    },
+    {
+        name: "delayTime",
+        descr: "Delay time",
+        unitDescr: "",
+        value: { min: "0.f", max: "1.f", def: "0.f" },
+        ui: { x: 10, y: 310, w: 134, h: 21 },
+        customDescr: `sprintf( text, "%s", DELAY_TIME_NAMES[ ( int ) round( valueNormalized * 4.f ) ] );`
+    },
+    {
+        name: "delayFeedback",
+        descr: "Delay feedback",
+        unitDescr: "%",
+        value: { min: "0.f", max: "1.f", def: "0.f", type: "percent" },
+        ui: { x: 10, y: 340, w: 134, h: 21 }
+    },
+    {
+        name: "delayMix",
+        descr: "Delay mix",
+        unitDescr: "%",
+        value: { min: "0.f", max: "1.f", def: "0.f", type: "percent" },
+        ui: { x: 10, y: 370, w: 134, h: 21 }
+    },
+    {
+        name: "chorusRate",
+        descr: "Delay modulation rate",
+        unitDescr: "Hz",
+        value: { min: "0.f", max: "10.f" },
+        ui: { x: 199, y: 310, w: 104, h: 21 },
+        normalizedDescr: true
+    },
+    {
+        name: "chorusDepth",
+        descr: "Delay modulation depth",
+        unitDescr: "%",
+        value: { min: "0.f", max: "1.f", def: "0.f", type: "percent" },
+        ui: { x: 199, y: 340, w: 104, h: 21 }
+    },
+    {
+        name: "delayInterpolation",
+        descr: "Delay interpolation",
+        unitDescr: "",
+        value: { min: "0.f", max: "1.f", def: "0.f" },
+        ui: { x: 199, y: 370, w: 104, h: 21 },
+        customDescr: `sprintf( text, "%s", DELAY_INTERPOLATION_NAMES[ ( int ) round( valueNormalized * 2.f ) ] );`
+    },
+    {
+        name: "lowCut",
+        descr: "Low cut",
+        unitDescr: "Hz",
+        value: { min: "0.f", max: "1.f", def: "0.f" },
+        ui: { x: 360, y: 310, w: 134, h: 21 },
+        customDescr: `sprintf( text, "%.0f Hz", 20.f * pow( 100.f, valueNormalized ));`
+    },
+    {
+        name: "highCut",
+        descr: "High cut",
+        unitDescr: "Hz",
+        value: { min: "0.f", max: "1.f", def: "1.f" },
+        ui: { x: 360, y: 340, w: 134, h: 21 },
+        customDescr: `sprintf( text, "%.0f Hz", 1000.f * pow( 20.f, valueNormalized ));`
+    },
+    {
+        name: "saturation",
+        descr: "Saturation",
+        unitDescr: "dB",
+        value: { min: "0.f", max: "1.f", def: "0.f" },
+        ui: { x: 10, y: 400, w: 134, h: 21 },
+        customDescr: `sprintf( text, "%.1f dB", valueNormalized * 24.f );`
+    },
+    {
+        name: "saturationCurve",
+        descr: "Saturation curve",
+        unitDescr: "",
+        value: { min: "0.f", max: "1.f", def: "0.f" },
+        ui: { x: 10, y: 430, w: 134, h: 21 },
+        customDescr: `sprintf( text, "%s", SATURATION_CURVE_NAMES[ ( int ) round( valueNormalized * 2.f ) ] );`
+    },
+    {
+        name: "bands",
+        descr: "Crusher bands",
+        unitDescr: "",
+        value: { min: "0.f", max: "1.f", def: "0.f" },
+        ui: { x: 10, y: 460, w: 134, h: 21 },
+        customDescr: `sprintf( text, "%d", 1 + ( int ) round( valueNormalized * 3.f ));`
+    },
+    {
+        name: "crossover1",
+        descr: "Crossover 1",
+        unitDescr: "Hz",
+        value: { min: "0.f", max: "1.f", def: "0.27f" },
+        ui: { x: 10, y: 490, w: 134, h: 21 },
+        customDescr: `sprintf( text, "%.0f Hz", 40.f * pow( 400.f, valueNormalized ));`
+    },
+    {
+        name: "crossover2",
+        descr: "Crossover 2",
+        unitDescr: "Hz",
+        value: { min: "0.f", max: "1.f", def: "0.54f" },
+        ui: { x: 10, y: 520, w: 134, h: 21 },
+        customDescr: `sprintf( text, "%.0f Hz", 40.f * pow( 400.f, valueNormalized ));`
+    },
+    {
+        name: "crossover3",
+        descr: "Crossover 3",
+        unitDescr: "Hz",
+        value: { min: "0.f", max: "1.f", def: "0.81f" },
+        ui: { x: 10, y: 550, w: 134, h: 21 },
+        customDescr: `sprintf( text, "%.0f Hz", 40.f * pow( 400.f, valueNormalized ));`
+    },
+    {
+        name: "band1Resolution",
+        descr: "Band 1 resolution",
+        unitDescr: "%",
+        value: { min: "0.f", max: "1.f", def: "1.f", type: "percent" },
+        ui: { x: 199, y: 460, w: 104, h: 21 }
+    },
+    {
+        name: "band2Resolution",
+        descr: "Band 2 resolution",
+        unitDescr: "%",
+        value: { min: "0.f", max: "1.f", def: "1.f", type: "percent" },
+        ui: { x: 199, y: 490, w: 104, h: 21 }
+    },
+    {
+        name: "band3Resolution",
+        descr: "Band 3 resolution",
+        unitDescr: "%",
+        value: { min: "0.f", max: "1.f", def: "1.f", type: "percent" },
+        ui: { x: 199, y: 520, w: 104, h: 21 }
+    },
+    {
+        name: "band4Resolution",
+        descr: "Band 4 resolution",
+        unitDescr: "%",
+        value: { min: "0.f", max: "1.f", def: "1.f", type: "percent" },
+        ui: { x: 199, y: 550, w: 104, h: 21 }
+    },
+    {
+        name: "band1Decimation",
+        descr: "Band 1 downsampling",
+        unitDescr: "%",
+        value: { min: "0.f", max: "1.f", def: "0.f", type: "percent" },
+        ui: { x: 360, y: 460, w: 134, h: 21 }
+    },
+    {
+        name: "band2Decimation",
+        descr: "Band 2 downsampling",
+        unitDescr: "%",
+        value: { min: "0.f", max: "1.f", def: "0.f", type: "percent" },
+        ui: { x: 360, y: 490, w: 134, h: 21 }
+    },
+    {
+        name: "band3Decimation",
+        descr: "Band 3 downsampling",
+        unitDescr: "%",
+        value: { min: "0.f", max: "1.f", def: "0.f", type: "percent" },
+        ui: { x: 360, y: 520, w: 134, h: 21 }
+    },
+    {
+        name: "band4Decimation",
+        descr: "Band 4 downsampling",
+        unitDescr: "%",
+        value: { min: "0.f", max: "1.f", def: "0.f", type: "percent" },
+        ui: { x: 360, y: 550, w: 134, h: 21 }
+    },
+    {
+        name: "reverbMix",
+        descr: "Reverb mix",
+        unitDescr: "%",
+        value: { min: "0.f", max: "1.f", def: "0.f", type: "percent" },
+        ui: { x: 199, y: 400, w: 104, h: 21 }
+    },
+    {
+        name: "reverbSize",
+        descr: "Reverb size",
+        unitDescr: "%",
+        value: { min: "0.f", max: "1.f", def: "0.5f", type: "percent" },
+        ui: { x: 199, y: 430, w: 104, h: 21 }
+    },
+    {
+        name: "reverbDecay",
+        descr: "Reverb decay",
+        unitDescr: "s",
+        value: { min: "0.f", max: "1.f", def: "0.5f" },
+        ui: { x: 360, y: 370, w: 134, h: 21 },
+        customDescr: `sprintf( text, "%.1f s", 0.2f * pow( 50.f, valueNormalized ));`
+    },
+    {
+        name: "reverbDamping",
+        descr: "Reverb damping",
+        unitDescr: "%",
+        value: { min: "0.f", max: "1.f", def: "0.5f", type: "percent" },
+        ui: { x: 360, y: 400, w: 134, h: 21 }
+    },
+    {
+        name: "spectralMagnitude",
+        descr: "Spectral magnitude resolution",
+        unitDescr: "bits",
+        value: { min: "0.f", max: "1.f", def: "1.f" },
+        ui: { x: 10, y: 580, w: 134, h: 21 },
+        customDescr: `sprintf( text, "%.1f bits", 1.f + valueNormalized * 15.f );`
+    },
+    {
+        name: "spectralPhase",
+        descr: "Spectral phase resolution",
+        unitDescr: "bits",
+        value: { min: "0.f", max: "1.f", def: "1.f" },
+        ui: { x: 10, y: 610, w: 134, h: 21 },
+        customDescr: `sprintf( text, "%.1f bits", 1.f + valueNormalized * 15.f );`
+    },
+    {
+        name: "spectralMix",
+        descr: "Spectral crusher mix",
+        unitDescr: "%",
+        value: { min: "0.f", max: "1.f", def: "1.f", type: "percent" },
+        ui: { x: 199, y: 580, w: 104, h: 21 }
+    },
+    {
+        name: "spectralSize",
+        descr: "Spectral frame size",
+        unitDescr: "samples",
+        value: { min: "0.f", max: "1.f", def: "0.75f" },
+        ui: { x: 199, y: 610, w: 104, h: 21 },
+        customDescr: `sprintf( text, "%d", 256 << ( int ) round( valueNormalized * 4.f ));`
+    },
+    {
+        name: "sidechainDucking",
+        descr: "Sidechain ducking",
+        unitDescr: "%",
+        value: { min: "0.f", max: "1.f", def: "0.f", type: "percent" },
+        ui: { x: 360, y: 580, w: 134, h: 21 }
+    },
+    {
+        name: "sidechainCrush",
+        descr: "Sidechain to resolution",
+        unitDescr: "%",
+        value: { min: "0.f", max: "1.f", def: "0.f", type: "percent" },
+        ui: { x: 360, y: 610, w: 134, h: 21 }
+    },
+    {
+        name: "sequencerCrush",
+        descr: "Sequencer to resolution",
+        unitDescr: "%",
+        value: { min: "0.f", max: "1.f", def: "0.f", type: "percent" },
+        ui: { x: 10, y: 640, w: 134, h: 21 }
+    },
+    {
+        name: "sequencerMix",
+        descr: "Sequencer to mix",
+        unitDescr: "%",
+        value: { min: "0.f", max: "1.f", def: "0.f", type: "percent" },
+        ui: { x: 10, y: 670, w: 134, h: 21 }
+    },
+    {
+        name: "sequencerSteps",
+        descr: "Sequencer steps",
+        unitDescr: "steps",
+        value: { min: "0.f", max: "1.f", def: "0.f" },
+        ui: { x: 199, y: 640, w: 104, h: 21 },
+        customDescr: `sprintf( text, "%d steps", 16 * ( 1 + ( int ) round( valueNormalized * 3.f )));`
+    },
+    {
+        name: "sequencerPattern",
+        descr: "Sequencer pattern",
+        unitDescr: "",
+        value: { min: "0.f", max: "1.f", def: "0.f" },
+        ui: { x: 199, y: 670, w: 104, h: 21 },
+        customDescr: `sprintf( text, "%d", 1 + ( int ) round( valueNormalized * 63.f ));`
+    },
+    {
+        name: "sequencerGlide",
+        descr: "Sequencer glide",
+        unitDescr: "%",
+        value: { min: "0.f", max: "1.f", def: "0.f", type: "percent" },
+        ui: { x: 360, y: 640, w: 134, h: 21 }
+    },
+    {
+        name: "stutter",
+        descr: "Stutter",
+        unitDescr: "",
+        value: { min: "0", max: "1", def: "0", type: "bool" },
+        ui: { x: 360, y: 670, w: 130, h: 21 }
+    },
+    {
+        name: "stutterLength",
+        descr: "Stutter length",
+        unitDescr: "",
+        value: { min: "0.f", max: "1.f", def: "0.5f" },
+        ui: { x: 10, y: 700, w: 134, h: 21 },
+        customDescr: `sprintf( text, "%s", STUTTER_LENGTH_NAMES[ ( int ) round( valueNormalized * 4.f ) ] );`
     }
 ];
 
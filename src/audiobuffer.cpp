@@ -21,24 +21,32 @@
  * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "audiobuffer.h"
+#include "halffloat.h"
 #include <algorithm>
 #include <string.h>
 
-AudioBuffer::AudioBuffer( int aAmountOfChannels, int aBufferSize )
+AudioBuffer::AudioBuffer( int aAmountOfChannels, int aBufferSize, Storage aStorage )
 {
     loopeable        = false;
     amountOfChannels = aAmountOfChannels;
     bufferSize       = aBufferSize;
+    storage          = aStorage;
 
-    // create silent buffers for each channel
+    // create silent buffers for each channel (only the list matching the storage is populated)
 
-    _buffers = new std::vector<float*>( amountOfChannels );
+    _buffers     = new std::vector<float*>( amountOfChannels, nullptr );
+    _halfBuffers = new std::vector<uint16_t*>( amountOfChannels, nullptr );
 
     // fill buffers with silence
 
     for ( int i = 0; i < amountOfChannels; ++i ) {
-        _buffers->at( i ) = new float[ aBufferSize ];
-        memset( _buffers->at( i ), 0, aBufferSize * sizeof( float )); // zero bits should equal 0.f
+        if ( storage == HALF ) {
+            _halfBuffers->at( i ) = new uint16_t[ aBufferSize ];
+            memset( _halfBuffers->at( i ), 0, aBufferSize * sizeof( uint16_t )); // zero bits equal a half 0.f
+        } else {
+            _buffers->at( i ) = new float[ aBufferSize ];
+            memset( _buffers->at( i ), 0, aBufferSize * sizeof( float )); // zero bits should equal 0.f
+        }
     }
 }
 
@@ -47,7 +55,11 @@ AudioBuffer::~AudioBuffer()
     while ( !_buffers->empty()) {
         delete[] _buffers->back(), _buffers->pop_back();
     }
+    while ( !_halfBuffers->empty()) {
+        delete[] _halfBuffers->back(), _halfBuffers->pop_back();
+    }
     delete _buffers;
+    delete _halfBuffers;
 }
 
 /* public methods */
@@ -57,9 +69,30 @@ float* AudioBuffer::getBufferForChannel( int aChannelNum )
     return _buffers->at( aChannelNum );
 }
 
+uint16_t* AudioBuffer::getHalfBufferForChannel( int aChannelNum )
+{
+    return _halfBuffers->at( aChannelNum );
+}
+
+void AudioBuffer::read( int aChannelNum, int aOffset, float* aOutput, int aLength )
+{
+    if ( storage == HALF )
+        Igorski::Calc::halvesToFloats( getHalfBufferForChannel( aChannelNum ) + aOffset, aOutput, aLength );
+    else
+        memcpy( aOutput, getBufferForChannel( aChannelNum ) + aOffset, aLength * sizeof( float ));
+}
+
+void AudioBuffer::write( int aChannelNum, int aOffset, const float* aInput, int aLength )
+{
+    if ( storage == HALF )
+        Igorski::Calc::floatsToHalves( aInput, getHalfBufferForChannel( aChannelNum ) + aOffset, aLength );
+    else
+        memcpy( getBufferForChannel( aChannelNum ) + aOffset, aInput, aLength * sizeof( float ));
+}
+
 int AudioBuffer::mergeBuffers( AudioBuffer* aBuffer, int aReadOffset, int aWriteOffset, float aMixVolume )
 {
-    if ( aBuffer == 0 || aWriteOffset >= bufferSize )
+    if ( aBuffer == 0 || aWriteOffset >= bufferSize || aBuffer->bufferSize <= 0 )
         return 0;
 
     int sourceLength     = aBuffer->bufferSize;
@@ -75,15 +108,20 @@ int AudioBuffer::mergeBuffers( AudioBuffer* aBuffer, int aReadOffset, int aWrite
     int maxWriteOffset = aWriteOffset + writeLength;
     int c;
 
+    // HALF sources are converted in chunks
+
+    float chunk[ CONVERSION_CHUNK_SIZE ];
+
     for ( c = 0; c < amountOfChannels; ++c )
     {
         if ( c > maxSourceChannel )
             break;
 
-        float* srcBuffer    = aBuffer->getBufferForChannel( c );
         float* targetBuffer = getBufferForChannel( c );
 
-        for ( int i = aWriteOffset, r = aReadOffset; i < maxWriteOffset; ++i, ++r )
+        // mix in segments, each ending at the end of the source or this buffer
+
+        for ( int i = aWriteOffset, r = aReadOffset; i < maxWriteOffset; )
         {
             if ( r >= sourceLength )
             {
@@ -92,8 +130,23 @@ int AudioBuffer::mergeBuffers( AudioBuffer* aBuffer, int aReadOffset, int aWrite
                 else
                     break;
             }
-            targetBuffer[ i ] += ( srcBuffer[ r ] * aMixVolume );
-            ++writtenSamples;
+            int length = std::min( maxWriteOffset - i, sourceLength - r );
+            const float* srcBuffer;
+
+            if ( aBuffer->storage == HALF ) {
+                length = std::min( length, CONVERSION_CHUNK_SIZE );
+                aBuffer->read( c, r, chunk, length );
+                srcBuffer = chunk;
+            } else {
+                srcBuffer = aBuffer->getBufferForChannel( c ) + r;
+            }
+
+            for ( int j = 0; j < length; ++j )
+                targetBuffer[ i + j ] += ( srcBuffer[ j ] * aMixVolume );
+
+            i += length;
+            r += length;
+            writtenSamples += length;
         }
     }
     // return the amount of samples written (per buffer)
@@ -107,14 +160,34 @@ int AudioBuffer::mergeBuffers( AudioBuffer* aBuffer, int aReadOffset, int aWrite
 void AudioBuffer::silenceBuffers()
 {
     // use mem set to quickly erase existing buffer contents, zero bits should equal 0.f
-    for ( int i = 0; i < amountOfChannels; ++i )
-        memset( getBufferForChannel( i ), 0, bufferSize * sizeof( float ));
+    for ( int i = 0; i < amountOfChannels; ++i ) {
+        if ( storage == HALF )
+            memset( getHalfBufferForChannel( i ), 0, bufferSize * sizeof( uint16_t ));
+        else
+            memset( getBufferForChannel( i ), 0, bufferSize * sizeof( float ));
+    }
 }
 
 void AudioBuffer::adjustBufferVolumes( float amp )
 {
+    float chunk[ CONVERSION_CHUNK_SIZE ];
+
     for ( int i = 0; i < amountOfChannels; ++i )
     {
+        if ( storage == HALF )
+        {
+            for ( int offset = 0; offset < bufferSize; offset += CONVERSION_CHUNK_SIZE )
+            {
+                int length = std::min( CONVERSION_CHUNK_SIZE, bufferSize - offset );
+                read( i, offset, chunk, length );
+
+                for ( int j = 0; j < length; ++j )
+                    chunk[ j ] *= amp;
+
+                write( i, offset, chunk, length );
+            }
+            continue;
+        }
         float* buffer = getBufferForChannel( i );
 
         for ( int j = 0; j < bufferSize; ++j )
@@ -126,6 +199,17 @@ bool AudioBuffer::isSilent()
 {
     for ( int i = 0; i < amountOfChannels; ++i )
     {
+        if ( storage == HALF )
+        {
+            // all but the sign bit are zero for (negative) zero
+            uint16_t* buffer = getHalfBufferForChannel( i );
+            for ( int j = 0; j < bufferSize; ++j )
+            {
+                if (( buffer[ j ] & 0x7FFF ) != 0 )
+                    return false;
+            }
+            continue;
+        }
         float* buffer = getBufferForChannel( i );
         for ( int j = 0; j < bufferSize; ++j )
         {
@@ -138,10 +222,14 @@ bool AudioBuffer::isSilent()
 
 AudioBuffer* AudioBuffer::clone()
 {
-    AudioBuffer* output = new AudioBuffer( amountOfChannels, bufferSize );
+    AudioBuffer* output = new AudioBuffer( amountOfChannels, bufferSize, storage );
 
     for ( int i = 0; i < amountOfChannels; ++i )
     {
+        if ( storage == HALF ) {
+            memcpy( output->getHalfBufferForChannel( i ), getHalfBufferForChannel( i ), bufferSize * sizeof( uint16_t ));
+            continue;
+        }
         float* sourceBuffer = getBufferForChannel( i );
         float* targetBuffer = output->getBufferForChannel( i );
 
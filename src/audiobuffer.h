@@ -24,24 +24,47 @@
 #define __AUDIOBUFFER_H_INCLUDED__
 
 #include "global.h"
+#include <stdint.h>
 #include <vector>
 
 /**
  * An AudioBuffer represents multiple channels of audio
  * each of equal buffer length.
  * AudioBuffer has convenience methods for cloning, silencing and mixing
+ *
+ * Samples are stored as floats, or as half floats (HALF storage) for long-lived audio
+ * memory, halving its footprint. HALF buffers have no float representation to
+ * process in place, their contents are accessed through read() and write()
  */
 class AudioBuffer
 {
     public:
-        AudioBuffer( int aAmountOfChannels, int aBufferSize );
+        enum Storage {
+            FLOAT = 0,
+            HALF
+        };
+
+        AudioBuffer( int aAmountOfChannels, int aBufferSize, Storage aStorage = FLOAT );
         ~AudioBuffer();
 
         int amountOfChannels;
         int bufferSize;
         bool loopeable;
+        Storage storage;
+
+        // retrieve the samples of given channel, the float variant is only available for FLOAT storage
+        // while the half variant is only available for HALF storage (both return nullptr otherwise)
 
         float* getBufferForChannel( int aChannelNum );
+        uint16_t* getHalfBufferForChannel( int aChannelNum );
+
+        // copy aLength samples of given channel, starting at aOffset, into aOutput (read) or
+        // from aInput (write), converting from and to half floats when using HALF storage
+
+        void read( int aChannelNum, int aOffset, float* aOutput, int aLength );
+        void write( int aChannelNum, int aOffset, const float* aInput, int aLength );
+
+        // mix the contents of aBuffer (of any storage) into this buffer (which must use FLOAT storage)
         int mergeBuffers( AudioBuffer* aBuffer, int aReadOffset, int aWriteOffset, float aMixVolume );
         void silenceBuffers();
         void adjustBufferVolumes( float volume );
@@ -50,6 +73,11 @@ class AudioBuffer
 
     protected:
         std::vector<float*>* _buffers;
+        std::vector<uint16_t*>* _halfBuffers;
+
+        // size of the float chunks used when converting HALF storage
+
+        static constexpr int CONVERSION_CHUNK_SIZE = 64;
 };
 
 #endif
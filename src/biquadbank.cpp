@@ -0,0 +1,349 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "biquadbank.h"
+#include "global.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Igorski {
+
+/* constructor / destructor */
+
+BiquadBank::BiquadBank( int amountOfChannels, int amountOfSections, int maxBufferSize )
+{
+    _amountOfChannels = amountOfChannels;
+    _maxSections      = std::min( MAX_SECTIONS, std::max( 1, amountOfSections ));
+    _amountOfSections = _maxSections;
+    _amountOfGroups   = ( amountOfChannels + LANES - 1 ) / LANES;
+
+    _sections.resize( _amountOfGroups * _maxSections );
+    _frames.resize( maxBufferSize * LANES, 0.f );
+    _channels.resize( amountOfChannels, nullptr );
+
+    for ( int s = 0; s < _maxSections; ++s ) {
+        setFilter( s, BYPASS, 0.f, 0.f );
+    }
+    reset();
+}
+
+BiquadBank::~BiquadBank()
+{
+
+}
+
+/* public methods */
+
+void BiquadBank::setFilter( int section, Type type, float frequency, float q, float gain )
+{
+    if ( section < 0 || section >= _maxSections ) {
+        return;
+    }
+    float coefficients[ 5 ];
+    calculate( type, frequency, q, gain, coefficients );
+
+    for ( int c = 0; c < _amountOfGroups * LANES; ++c ) {
+        store( section, c, coefficients );
+    }
+}
+
+void BiquadBank::setFilter( int section, int channel, Type type, float frequency, float q, float gain )
+{
+    if ( section < 0 || section >= _maxSections || channel < 0 || channel >= _amountOfChannels ) {
+        return;
+    }
+    float coefficients[ 5 ];
+    calculate( type, frequency, q, gain, coefficients );
+
+    store( section, channel, coefficients );
+}
+
+int BiquadBank::getAmountOfSections()
+{
+    return _amountOfSections;
+}
+
+void BiquadBank::setAmountOfSections( int value )
+{
+    _amountOfSections = std::min( _maxSections, std::max( 1, value ));
+}
+
+void BiquadBank::reset()
+{
+    // pending coefficient changes are applied immediately as there is no signal to interpolate across
+
+    for ( auto& section : _sections ) {
+        section.current = section.target;
+        std::fill( section.z1, section.z1 + LANES, 0.f );
+        std::fill( section.z2, section.z2 + LANES, 0.f );
+    }
+    _interpolate = false;
+}
+
+void BiquadBank::process( AudioBuffer* buffer, int bufferSize )
+{
+    int amountOfChannels = std::min( _amountOfChannels, buffer->amountOfChannels );
+
+    for ( int c = 0; c < amountOfChannels; ++c ) {
+        _channels[ c ] = buffer->getBufferForChannel( c );
+    }
+    process( _channels.data(), amountOfChannels, bufferSize );
+}
+
+void BiquadBank::process( float** channels, int amountOfChannels, int bufferSize )
+{
+    amountOfChannels = std::min( _amountOfChannels, amountOfChannels );
+    bufferSize = std::min( bufferSize, ( int ) _frames.size() / LANES );
+
+    bool interpolate = _interpolate;
+    if ( interpolate ) {
+        prepareInterpolation( bufferSize );
+    }
+
+    float* frames = _frames.data();
+
+    for ( int g = 0; g < _amountOfGroups; ++g )
+    {
+        int firstChannel = g * LANES;
+        int lanes        = std::min( LANES, amountOfChannels - firstChannel );
+
+        if ( lanes <= 0 ) {
+            break;
+        }
+
+        // interleave the channels into frames (unused lanes are silent)
+
+        if ( lanes < LANES ) {
+            std::fill( frames, frames + bufferSize * LANES, 0.f );
+        }
+        for ( int l = 0; l < lanes; ++l ) {
+            const float* channelBuffer = channels[ firstChannel + l ];
+            for ( int i = 0; i < bufferSize; ++i ) {
+                frames[ i * LANES + l ] = channelBuffer[ i ];
+            }
+        }
+
+        if ( interpolate ) {
+            filter<true>( getSection( g, 0 ), bufferSize );
+        } else {
+            filter<false>( getSection( g, 0 ), bufferSize );
+        }
+
+        for ( int l = 0; l < lanes; ++l ) {
+            float* channelBuffer = channels[ firstChannel + l ];
+            for ( int i = 0; i < bufferSize; ++i ) {
+                channelBuffer[ i ] = frames[ i * LANES + l ];
+            }
+        }
+    }
+
+    // interpolation completes within a single block, snap to the exact target values
+
+    if ( interpolate ) {
+        for ( auto& section : _sections ) {
+            section.current = section.target;
+        }
+        _interpolate = false;
+    }
+}
+
+/* private methods */
+
+BiquadBank::Section* BiquadBank::getSection( int group, int section )
+{
+    return &_sections[ group * _maxSections + section ];
+}
+
+void BiquadBank::calculate( Type type, float frequency, float q, float gain, float* coefficients )
+{
+    // coefficients as described in the Audio EQ Cookbook (R. Bristow-Johnson)
+
+    float b0 = 1.f, b1 = 0.f, b2 = 0.f, a0 = 1.f, a1 = 0.f, a2 = 0.f;
+
+    if ( type != BYPASS )
+    {
+        frequency = std::min( frequency, VST::SAMPLE_RATE * .49f );
+
+        float omega = VST::TWO_PI * std::max( 1.f, frequency ) / VST::SAMPLE_RATE;
+        float sine  = sinf( omega );
+        float cosine = cosf( omega );
+        float alpha = sine / ( 2.f * std::max( .01f, q ));
+        float A     = powf( 10.f, gain / 40.f );
+
+        switch ( type )
+        {
+            default:
+            case LOW_PASS:
+                b0 = b2 = ( 1.f - cosine ) * .5f;
+                b1 = 1.f - cosine;
+                a0 = 1.f + alpha;
+                a1 = -2.f * cosine;
+                a2 = 1.f - alpha;
+                break;
+
+            case HIGH_PASS:
+                b0 = b2 = ( 1.f + cosine ) * .5f;
+                b1 = -( 1.f + cosine );
+                a0 = 1.f + alpha;
+                a1 = -2.f * cosine;
+                a2 = 1.f - alpha;
+                break;
+
+            case BAND_PASS:
+                b0 = alpha;
+                b1 = 0.f;
+                b2 = -alpha;
+                a0 = 1.f + alpha;
+                a1 = -2.f * cosine;
+                a2 = 1.f - alpha;
+                break;
+
+            case PEAK:
+                b0 = 1.f + alpha * A;
+                b1 = -2.f * cosine;
+                b2 = 1.f - alpha * A;
+                a0 = 1.f + alpha / A;
+                a1 = -2.f * cosine;
+                a2 = 1.f - alpha / A;
+                break;
+
+            case ALL_PASS:
+                b0 = 1.f - alpha;
+                b1 = -2.f * cosine;
+                b2 = 1.f + alpha;
+                a0 = 1.f + alpha;
+                a1 = -2.f * cosine;
+                a2 = 1.f - alpha;
+                break;
+
+            case LOW_SHELF:
+            case HIGH_SHELF:
+            {
+                float root  = 2.f * sqrtf( A ) * alpha;
+                float sign  = ( type == LOW_SHELF ) ? 1.f : -1.f;
+                float plus  = A + 1.f;
+                float minus = A - 1.f;
+
+                b0 = A * ( plus - sign * minus * cosine + root );
+                b1 = sign * 2.f * A * ( minus - sign * plus * cosine );
+                b2 = A * ( plus - sign * minus * cosine - root );
+                a0 = plus + sign * minus * cosine + root;
+                a1 = -sign * 2.f * ( minus + sign * plus * cosine );
+                a2 = plus + sign * minus * cosine - root;
+                break;
+            }
+        }
+    }
+
+    float normalize = 1.f / a0;
+
+    coefficients[ 0 ] = b0 * normalize;
+    coefficients[ 1 ] = b1 * normalize;
+    coefficients[ 2 ] = b2 * normalize;
+    coefficients[ 3 ] = a1 * normalize;
+    coefficients[ 4 ] = a2 * normalize;
+}
+
+void BiquadBank::store( int section, int channel, const float* coefficients )
+{
+    Coefficients& target = getSection( channel / LANES, section )->target;
+    int lane = channel % LANES;
+
+    target.b0[ lane ] = coefficients[ 0 ];
+    target.b1[ lane ] = coefficients[ 1 ];
+    target.b2[ lane ] = coefficients[ 2 ];
+    target.a1[ lane ] = coefficients[ 3 ];
+    target.a2[ lane ] = coefficients[ 4 ];
+
+    _interpolate = true;
+}
+
+void BiquadBank::prepareInterpolation( int bufferSize )
+{
+    float scale = 1.f / ( float ) std::max( 1, bufferSize );
+
+    for ( auto& section : _sections )
+    {
+        Coefficients& current   = section.current;
+        Coefficients& target    = section.target;
+        Coefficients& increment = section.increment;
+
+        for ( int l = 0; l < LANES; ++l ) {
+            increment.b0[ l ] = ( target.b0[ l ] - current.b0[ l ]) * scale;
+            increment.b1[ l ] = ( target.b1[ l ] - current.b1[ l ]) * scale;
+            increment.b2[ l ] = ( target.b2[ l ] - current.b2[ l ]) * scale;
+            increment.a1[ l ] = ( target.a1[ l ] - current.a1[ l ]) * scale;
+            increment.a2[ l ] = ( target.a2[ l ] - current.a2[ l ]) * scale;
+        }
+    }
+}
+
+template <bool Interpolate>
+void BiquadBank::filter( Section* sections, int bufferSize )
+{
+    float* frames = _frames.data();
+
+    for ( int s = 0; s < _amountOfSections; ++s )
+    {
+        Section& section = sections[ s ];
+
+        // coefficients and state are copied into local arrays so the compiler can keep
+        // them in registers (rather than reload them as the frames could alias them)
+
+        Coefficients c = section.current;
+        Coefficients increment = section.increment;
+
+        alignas( 32 ) float z1[ LANES ];
+        alignas( 32 ) float z2[ LANES ];
+        std::copy( section.z1, section.z1 + LANES, z1 );
+        std::copy( section.z2, section.z2 + LANES, z2 );
+
+        for ( int i = 0; i < bufferSize; ++i )
+        {
+            float* frame = frames + i * LANES;
+
+            // GCC fully unrolls this loop at -O3 after which it fails to vectorize the unrolled statements
+#if defined( __GNUC__ ) && !defined( __clang__ )
+            #pragma GCC unroll 0
+#endif
+            for ( int l = 0; l < LANES; ++l )
+            {
+                if ( Interpolate ) {
+                    c.b0[ l ] += increment.b0[ l ];
+                    c.b1[ l ] += increment.b1[ l ];
+                    c.b2[ l ] += increment.b2[ l ];
+                    c.a1[ l ] += increment.a1[ l ];
+                    c.a2[ l ] += increment.a2[ l ];
+                }
+                float x = frame[ l ];
+                float y = c.b0[ l ] * x + z1[ l ];
+
+                z1[ l ]    = c.b1[ l ] * x - c.a1[ l ] * y + z2[ l ];
+                z2[ l ]    = c.b2[ l ] * x - c.a2[ l ] * y;
+                frame[ l ] = y;
+            }
+        }
+        std::copy( z1, z1 + LANES, section.z1 );
+        std::copy( z2, z2 + LANES, section.z2 );
+    }
+}
+}
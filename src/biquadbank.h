@@ -0,0 +1,129 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __BIQUADBANK_H_INCLUDED__
+#define __BIQUADBANK_H_INCLUDED__
+
+#include "audiobuffer.h"
+#include <vector>
+
+namespace Igorski {
+/**
+ * A bank of biquad filters processing multiple channels in parallel.
+ *
+ * Coefficients and filter state are stored in a structure-of-arrays layout: each
+ * coefficient is an array of LANES values (one per channel) so the inner loop of
+ * the filter kernel operates on all lanes at once, which the compiler vectorizes
+ * (a single AVX or two SSE operations per coefficient). Channels are interleaved into
+ * frames of LANES samples prior to filtering. Channel counts above LANES are processed
+ * in multiple groups.
+ *
+ * Each channel runs the same cascade of up to MAX_SECTIONS sections (transposed direct form II).
+ * Coefficient changes are interpolated linearly across the next processed block.
+ */
+class BiquadBank
+{
+    public:
+        enum Type {
+            LOW_PASS = 0,
+            HIGH_PASS,
+            BAND_PASS,
+            PEAK,
+            LOW_SHELF,
+            HIGH_SHELF,
+            ALL_PASS,
+            BYPASS
+        };
+
+        static constexpr int LANES        = 8;
+        static constexpr int MAX_SECTIONS = 6;
+
+        BiquadBank( int amountOfChannels, int amountOfSections, int maxBufferSize );
+        ~BiquadBank();
+
+        // configure given section of the cascade (for all channels)
+        // frequency in Hz, gain in dB (only applies to the PEAK and shelving types)
+
+        void setFilter( int section, Type type, float frequency, float q, float gain = 0.f );
+
+        // configure given section of the cascade for a single channel
+
+        void setFilter( int section, int channel, Type type, float frequency, float q, float gain = 0.f );
+
+        // the amount of sections to process (up to the amount provided in the constructor)
+
+        int getAmountOfSections();
+        void setAmountOfSections( int value );
+
+        // clear the filter state (e.g. on playback start), pending coefficient changes apply without interpolation
+
+        void reset();
+
+        // apply the filter cascade onto given buffer, in place
+
+        void process( AudioBuffer* buffer, int bufferSize );
+
+        // apply the filter cascade onto given channel buffers, in place
+
+        void process( float** channels, int amountOfChannels, int bufferSize );
+
+    private:
+        struct alignas( 32 ) Coefficients {
+            float b0[ LANES ];
+            float b1[ LANES ];
+            float b2[ LANES ];
+            float a1[ LANES ];
+            float a2[ LANES ];
+        };
+
+        struct alignas( 32 ) Section {
+            Coefficients current;
+            Coefficients target;
+            Coefficients increment; // per sample, while interpolating
+            float z1[ LANES ];
+            float z2[ LANES ];
+        };
+
+        int _amountOfChannels;
+        int _amountOfSections;
+        int _maxSections;
+        int _amountOfGroups; // of LANES channels
+
+        std::vector<Section> _sections; // per group, per section
+        std::vector<float> _frames;     // interleaved channel samples, LANES per frame
+        std::vector<float*> _channels;
+
+        bool _interpolate; // whether the coefficients of any section differ from their target
+
+        Section* getSection( int group, int section );
+
+        static void calculate( Type type, float frequency, float q, float gain, float* coefficients );
+        void store( int section, int channel, const float* coefficients );
+
+        void prepareInterpolation( int bufferSize );
+
+        template <bool Interpolate>
+        void filter( Section* sections, int bufferSize );
+};
+}
+
+#endif
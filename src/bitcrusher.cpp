@@ -23,28 +23,54 @@
 #include "bitcrusher.h"
 #include "global.h"
 #include "calc.h"
-#include <limits.h>
+#include <algorithm>
 #include <math.h>
 
 namespace Igorski {
 
 /* constructor */
 
-BitCrusher::BitCrusher( float amount, float inputMix, float outputMix )
+BitCrusher::BitCrusher( float amount, float inputMix, float outputMix, int amountOfChannels )
 {
+    lfo = new LFO();
+    lfo->setControlRate( LFO_CONTROL_RATE );
+    hasLFO    = false;
+    _lfoDepth = 0.f;
+    _rateRatio = 1.f;
+
     setAmount   ( amount );
     setInputMix ( inputMix );
     setOutputMix( outputMix );
 
     _tempAmount = _amount;
 
-    lfo = new LFO();
-    hasLFO = false;
+    int maxBufferSize = VST::BUFFER_SIZE * VST::MAX_OVERSAMPLING;
+
+    _lfoBuffer.resize( maxBufferSize, 0.f );
+    _stepBuffer.resize( maxBufferSize, 0.f );
+    _stepReciprocalBuffer.resize( maxBufferSize, 0.f );
+
+    // start at the target resolution
+    _step           = _targetStep;
+    _stepReciprocal = _targetStepReciprocal;
+
+    _dither = new Dither( amountOfChannels );
+
+    _antiAliasing = false;
+    setModulation( nullptr, nullptr, 0 );
+    _previousInputs.resize( amountOfChannels, 0.f );
+
+    _heldSamples.resize  ( amountOfChannels, 0.f );
+    _holdRemaining.resize( amountOfChannels, 0.f );
+
+    setDecimation( 0.f );
+    setDecimationLFO( 0.f );
 }
 
 BitCrusher::~BitCrusher()
 {
     delete lfo;
+    delete _dither;
 }
 
 /* public methods */
@@ -59,11 +85,11 @@ void BitCrusher::setLFO( float LFORatePercentage, float LFODepth )
     bool hadChange = ( wasEnabled != enabled ) || _lfoDepth != LFODepth;
 
     if ( enabled )
-        lfo->setRate(
+        lfo->setRate((
             VST::MIN_LFO_RATE() + (
                 LFORatePercentage * ( VST::MAX_LFO_RATE() - VST::MIN_LFO_RATE() )
             )
-        );
+        ) / _rateRatio );
 
     // turning LFO off
     if ( !hasLFO && wasEnabled ) {
@@ -77,29 +103,62 @@ void BitCrusher::setLFO( float LFORatePercentage, float LFODepth )
     }
 }
 
-void BitCrusher::process( float* inBuffer, int bufferSize )
+void BitCrusher::process( AudioBuffer* buffer, int bufferSize )
 {
+    bool isModulated = hasLFO || _amountModulation != nullptr;
+
+    if ( !isModulated && _tempAmount != _amount ) {
+        // modulation has ceased, restore the resolution
+        _tempAmount = _amount;
+        calcBits();
+    }
+
+    bool hasCrush      = _bits < 16.f || isModulated || _step != _targetStep;
+    bool hasDecimation = _holdPeriod > 1.f || _decimationModulation != nullptr;
+
     // sound should not be crushed ? do nothing
-    if ( _bits == 16 && !hasLFO )
+    if ( !hasCrush && !hasDecimation )
         return;
 
-    int bitsPlusOne = _bits + 1;
+    if (( int ) _lfoBuffer.size() < bufferSize ) {
+        // should not happen as host honours maxSamplesPerBlock
+        _lfoBuffer.resize( bufferSize );
+        _stepBuffer.resize( bufferSize );
+        _stepReciprocalBuffer.resize( bufferSize );
+    }
+
+    if ( hasLFO ) {
+        lfo->renderBlock( _lfoBuffer.data(), bufferSize );
 
-    for ( int i = 0; i < bufferSize; ++i )
-    {
-        short input = ( short ) (( inBuffer[ i ] * _inputMix ) * SHRT_MAX );
-        short prevent_offset = ( short )( -1 >> bitsPlusOne );
-        input &= ( -1 << ( 16 - _bits ));
-        inBuffer[ i ] = (( input + prevent_offset ) * _outputMix ) / SHRT_MAX;
+        // multiply by .5 and add .5 to make the LFO's bipolar waveform unipolar
+        for ( int i = 0; i < bufferSize; ++i ) {
+            _lfoBuffer[ i ] = _lfoBuffer[ i ] * .5f + .5f;
+        }
+    }
 
-        if ( hasLFO ) {
-            // multiply by .5 and add .5 to make the LFO's bipolar waveform unipolar
-            float lfoValue = lfo->peek() * .5f  + .5f;
-            _tempAmount = std::min( _lfoMax, _lfoMin + _lfoRange * lfoValue );
+    // when the resolution is moving, calculate the quantization steps for this cycle once (shared by all channels)
 
-            // recalculate the current resolution
-            calcBits();
-            bitsPlusOne = _bits + 1;
+    bool isStatic = !isModulated && _step == _targetStep;
+
+    if ( hasCrush && !isStatic ) {
+        renderSteps( bufferSize );
+    }
+
+    int amountOfChannels = std::min( buffer->amountOfChannels, ( int ) _heldSamples.size() );
+
+    for ( int c = 0; c < amountOfChannels; ++c )
+    {
+        float* channelBuffer = buffer->getBufferForChannel( c );
+
+        if ( hasCrush ) {
+            if ( _antiAliasing ) {
+                crushAntiAliased( channelBuffer, bufferSize, c, isStatic );
+            } else {
+                crush( channelBuffer, bufferSize, c, isStatic );
+            }
+        }
+        if ( hasDecimation ) {
+            decimate( channelBuffer, bufferSize, c );
         }
     }
 }
@@ -130,8 +189,249 @@ void BitCrusher::setOutputMix( float value )
     _outputMix = Calc::cap( value );
 }
 
+void BitCrusher::setDecimation( float value )
+{
+    _decimation = Calc::cap( value );
+
+    // scale exponentially to the 1 - MAX_HOLD_PERIOD range, periods that
+    // are near-integer are snapped so they can be processed by the fast path
+
+    float period  = getHoldPeriod( _decimation );
+    float rounded = round( period );
+
+    _holdPeriod = ( fabs( period - rounded ) < 0.01f ) ? rounded : period;
+}
+
+void BitCrusher::setDecimationLFO( float LFODepth )
+{
+    _decimationLfoDepth = Calc::cap( LFODepth );
+}
+
+void BitCrusher::setDither( Dither::Mode mode )
+{
+    _dither->setMode( mode );
+}
+
+void BitCrusher::setAntiAliasing( bool enabled )
+{
+    if ( enabled && !_antiAliasing ) {
+        std::fill( _previousInputs.begin(), _previousInputs.end(), 0.f );
+    }
+    _antiAliasing = enabled;
+}
+
+void BitCrusher::setModulation( const float* amountModulation, const float* decimationModulation, int modulationSize )
+{
+    _amountModulation     = amountModulation;
+    _decimationModulation = decimationModulation;
+    _modulationSize       = modulationSize;
+}
+
+void BitCrusher::setProcessingRate( float ratio )
+{
+    if ( ratio == _rateRatio ) {
+        return;
+    }
+
+    // the LFO rate and hold period are expressed in samples, scale them to the new rate
+
+    lfo->setRate( lfo->getRate() * _rateRatio / ratio );
+    _rateRatio = ratio;
+
+    setDecimation( _decimation );
+}
+
 /* private methods */
 
+void BitCrusher::renderSteps( int bufferSize )
+{
+    // the resolution is evaluated at control rate and the quantization step interpolated linearly in between,
+    // moving smoothly without requiring per-sample exp2 calculations. The reciprocal is derived from the
+    // interpolated step (rather than interpolated separately) so their product remains unity while ramping
+
+    for ( int offset = 0; offset < bufferSize; offset += CONTROL_BLOCK_SIZE )
+    {
+        int blockSize = std::min( CONTROL_BLOCK_SIZE, bufferSize - offset );
+
+        if ( hasLFO || _amountModulation != nullptr )
+        {
+            int index = offset + blockSize - 1;
+            float amount = hasLFO ? std::min( _lfoMax, _lfoMin + _lfoRange * _lfoBuffer[ index ] ) : _amount;
+
+            if ( _amountModulation != nullptr ) {
+                amount = Calc::cap( amount + _amountModulation[ getModulationIndex( index )]);
+            }
+            _tempAmount = amount;
+            calcBits();
+        }
+
+        float step     = _step;
+        float stepIncr = ( _targetStep - step ) / ( float ) blockSize;
+
+        float* steps = &_stepBuffer[ offset ];
+        float* invs  = &_stepReciprocalBuffer[ offset ];
+
+        for ( int i = 0; i < blockSize; ++i ) {
+            steps[ i ] = step + stepIncr * ( i + 1 );
+            invs [ i ] = 1.f / steps[ i ];
+        }
+        _step           = _targetStep;
+        _stepReciprocal = _targetStepReciprocal;
+    }
+}
+
+void BitCrusher::crush( float* channelBuffer, int bufferSize, int channel, bool isStatic )
+{
+    float inputMix  = _inputMix;
+    float outputMix = _outputMix;
+
+    // a float domain mid-tread quantizer, the input is bound to the -1 to +1 range
+    // so hot signals clip rather than wrap around
+
+    if ( _dither->getMode() != Dither::OFF )
+    {
+        // dithered quantization (noise is expressed in LSB units)
+        // this is a recursive loop when noise shaping as the error is fed back into the next sample
+
+        float* noise = _dither->generate( bufferSize );
+
+        for ( int i = 0; i < bufferSize; ++i )
+        {
+            float step  = isStatic ? _step : _stepBuffer[ i ];
+            float inv   = isStatic ? _stepReciprocal : _stepReciprocalBuffer[ i ];
+            float value = Calc::capSample( channelBuffer[ i ] * inputMix ) - _dither->getFeedback( channel ) * step;
+            float level = floorf( value * inv + noise[ i ] + .5f );
+
+            _dither->storeError( channel, level - value * inv );
+
+            channelBuffer[ i ] = level * step * outputMix;
+        }
+    }
+    else if ( isStatic )
+    {
+        float step = _step * outputMix;
+        float inv  = _stepReciprocal;
+
+        for ( int i = 0; i < bufferSize; ++i ) {
+            channelBuffer[ i ] = floorf( Calc::capSample( channelBuffer[ i ] * inputMix ) * inv + .5f ) * step;
+        }
+    }
+    else
+    {
+        float* steps = _stepBuffer.data();
+        float* invs  = _stepReciprocalBuffer.data();
+
+        for ( int i = 0; i < bufferSize; ++i ) {
+            channelBuffer[ i ] = floorf( Calc::capSample( channelBuffer[ i ] * inputMix ) * invs[ i ] + .5f ) * steps[ i ] * outputMix;
+        }
+    }
+}
+
+void BitCrusher::crushAntiAliased( float* channelBuffer, int bufferSize, int channel, bool isStatic )
+{
+    // the output is the average of the staircase over the interval between successive input samples
+    // e.g. ( F( x[n] ) - F( x[n-1] )) / ( x[n] - x[n-1] ) where F is the antiderivative of the quantizer
+    // the antiderivative is evaluated in double precision as its magnitude grows quadratically with the
+    // resolution, where the difference is ill-conditioned the quantizer is evaluated at the midpoint instead
+
+    float inputMix  = _inputMix;
+    float outputMix = _outputMix;
+    float previous  = _previousInputs[ channel ];
+
+    for ( int i = 0; i < bufferSize; ++i )
+    {
+        double step = isStatic ? _step : _stepBuffer[ i ];
+        double inv  = isStatic ? _stepReciprocal : _stepReciprocalBuffer[ i ];
+
+        float input = Calc::capSample( channelBuffer[ i ] * inputMix );
+
+        double u0 = previous * inv;
+        double u1 = input * inv;
+        double du = u1 - u0;
+
+        double level;
+
+        if ( fabs( du ) < ADAA_EPSILON ) {
+            level = floor(( u0 + u1 ) * .5 + .5 );
+        } else {
+            level = ( antiderivative( u1 ) - antiderivative( u0 )) / du;
+        }
+        previous = input;
+
+        channelBuffer[ i ] = ( float ) ( level * step ) * outputMix;
+    }
+    _previousInputs[ channel ] = previous;
+}
+
+void BitCrusher::decimate( float* channelBuffer, int bufferSize, int channel )
+{
+    float heldSample = _heldSamples[ channel ];
+    float remaining  = _holdRemaining[ channel ]; // samples left before the next sample is captured
+
+    bool hasLFOModulation = hasLFO && _decimationLfoDepth > 0.f;
+
+    if ( hasLFOModulation || _decimationModulation != nullptr )
+    {
+        // modulated hold rate, the period is only calculated when a new sample is captured
+        // the LFO shortens the hold period towards the unreduced rate
+
+        for ( int i = 0; i < bufferSize; ++i )
+        {
+            if ( remaining <= 0.f )
+            {
+                heldSample = channelBuffer[ i ];
+
+                float period = ( _decimationModulation != nullptr ) ?
+                    getHoldPeriod( Calc::cap( _decimation + _decimationModulation[ getModulationIndex( i )])) : _holdPeriod;
+
+                if ( hasLFOModulation ) {
+                    period -= ( period - 1.f ) * _decimationLfoDepth * _lfoBuffer[ i ];
+                }
+                remaining += period;
+            }
+            remaining -= 1.f;
+            channelBuffer[ i ] = heldSample;
+        }
+    }
+    else if ( _holdPeriod == floor( _holdPeriod ))
+    {
+        // fast path for integer hold periods: write each held sample as a contiguous run
+
+        int holdPeriod = ( int ) _holdPeriod;
+        int counter    = ( int ) ceil( remaining );
+
+        for ( int i = 0; i < bufferSize; )
+        {
+            if ( counter <= 0 ) {
+                heldSample = channelBuffer[ i ];
+                counter    = holdPeriod;
+            }
+            int run = std::min( counter, bufferSize - i );
+            std::fill( channelBuffer + i, channelBuffer + i + run, heldSample );
+
+            i       += run;
+            counter -= run;
+        }
+        remaining = ( float ) counter;
+    }
+    else
+    {
+        // fractional hold period, the remainder carries over into the next hold
+
+        for ( int i = 0; i < bufferSize; ++i )
+        {
+            if ( remaining <= 0.f ) {
+                heldSample = channelBuffer[ i ];
+                remaining += _holdPeriod;
+            }
+            remaining -= 1.f;
+            channelBuffer[ i ] = heldSample;
+        }
+    }
+    _heldSamples[ channel ]   = heldSample;
+    _holdRemaining[ channel ] = remaining;
+}
+
 void BitCrusher::cacheLFO()
 {
     _lfoRange = ( float ) _amount * _lfoDepth;
@@ -141,8 +441,12 @@ void BitCrusher::cacheLFO()
 
 void BitCrusher::calcBits()
 {
-    // scale float to 1 - 16 bit range
-    _bits = ( int ) floor( Calc::scale( _tempAmount, 1, 15 )) + 1;
+    // scale float to the continuous 1 - 16 bit range
+    _bits = Calc::scale( _tempAmount, 1, 15 ) + 1.f;
+
+    // the quantization step for the -1 to +1 range (e.g. 2 / 2^bits)
+    _targetStep           = exp2f( 1.f - _bits );
+    _targetStepReciprocal = 1.f / _targetStep;
 }
 
 }
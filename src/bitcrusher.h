@@ -23,30 +23,68 @@
 #ifndef __BITCRUSHER_H_INCLUDED__
 #define __BITCRUSHER_H_INCLUDED__
 
+#include "audiobuffer.h"
+#include "dither.h"
 #include "lfo.h"
+#include <algorithm>
+#include <math.h>
+#include <vector>
 
 namespace Igorski {
 class BitCrusher {
 
     public:
-        BitCrusher( float amount, float inputMix, float outputMix );
+        BitCrusher( float amount, float inputMix, float outputMix, int amountOfChannels );
         ~BitCrusher();
 
         void setLFO( float LFORatePercentage, float LFODepth );
-        void process( float* inBuffer, int bufferSize );
+        void process( AudioBuffer* buffer, int bufferSize );
 
         void setAmount( float value ); // range between -1 to +1
         void setInputMix( float value );
         void setOutputMix( float value );
 
+        // sample rate reduction (sample-and-hold), value in 0 - 1 range where
+        // 0 disables the reduction and 1 holds each sample for MAX_HOLD_PERIOD samples
+        // the LFO depth determines how much the LFO (see setLFO()) modulates the hold rate
+
+        void setDecimation( float value );
+        void setDecimationLFO( float LFODepth );
+
+        // dither the signal prior to reducing its resolution (see Dither)
+
+        void setDither( Dither::Mode mode );
+
+        // apply first order antiderivative anti-aliasing to the quantizer, this suppresses
+        // most of the aliasing of the staircase (at the expense of a half sample delay and
+        // a gentle high frequency roll-off). Note the quantizer is not dithered in this mode
+
+        void setAntiAliasing( bool enabled );
+
+        // provide per-sample modulation of the amount and decimation for the next process cycle
+        // (offsets in the normalized 0 - 1 range of the parameter, see ModulationMatrix)
+        // either can be nullptr when unmodulated. modulationSize describes the length of the
+        // vectors (the host buffer size of the process cycle)
+
+        void setModulation( const float* amountModulation, const float* decimationModulation, int modulationSize );
+
+        // ratio of the processing rate to the host rate, e.g. 2 when oversampled (see Oversampler) or .25 when
+        // running at a reduced rate (see Undersampler). The LFO rate and hold periods are scaled accordingly,
+        // modulation remains provided at the host rate
+
+        void setProcessingRate( float ratio );
+
         LFO* lfo;
         bool hasLFO;
 
+        static constexpr float MAX_HOLD_PERIOD = 32.f;
+
     private:
-        int _bits; // we scale the amount to integers in the 1-16 range
+        float _bits; // we scale the amount to the (continuous) 1-16 range
         float _amount;
         float _inputMix;
         float _outputMix;
+        float _rateRatio;
 
         void cacheLFO();
         void calcBits();
@@ -55,6 +93,86 @@ class BitCrusher {
         float _lfoRange;
         float _lfoMax;
         float _lfoMin;
+
+        // the LFO is rendered once per process cycle so all channels share the same modulation
+        // it is evaluated at control rate (see LFO::setControlRate())
+
+        static constexpr int LFO_CONTROL_RATE = 16;
+
+        std::vector<float> _lfoBuffer;
+
+        const float* _amountModulation;
+        const float* _decimationModulation;
+        int _modulationSize;
+
+        // the index within the modulation vectors (provided at the host rate) for given index at the processing
+        // rate. At a reduced rate, a block can hold samples queued in the previous process cycle, so the index
+        // is clamped to the current host block
+
+        inline int getModulationIndex( int index )
+        {
+            return std::min(( int ) ( index / _rateRatio ), _modulationSize - 1 );
+        }
+
+        // quantization step size for the current resolution, when the resolution changes
+        // (e.g. through automation or LFO) the step moves towards the target at control rate
+
+        static constexpr int CONTROL_BLOCK_SIZE = 32;
+
+        float _step;
+        float _stepReciprocal;
+        float _targetStep;
+        float _targetStepReciprocal;
+
+        std::vector<float> _stepBuffer;
+        std::vector<float> _stepReciprocalBuffer;
+
+        void renderSteps( int bufferSize );
+
+        Dither* _dither;
+
+        void crush( float* channelBuffer, int bufferSize, int channel, bool isStatic );
+
+        // antiderivative anti-aliasing (ADAA)
+
+        static constexpr double ADAA_EPSILON = 1.0e-5; // in LSB units
+
+        bool _antiAliasing;
+        std::vector<float> _previousInputs; // per channel, last input sample of the previous process cycle
+
+        void crushAntiAliased( float* channelBuffer, int bufferSize, int channel, bool isStatic );
+
+        // closed form antiderivative of the rounding staircase ( e.g. the integral of round( t ) dt from 0 to u )
+        // where u is expressed in LSB units (see crushAntiAliased())
+
+        static inline double antiderivative( double u )
+        {
+            double n = floor( u + .5 );
+            return n * ( u - .5 * n );
+        }
+
+        // decimation
+
+        float _decimation;
+        float _holdPeriod;     // in samples (fractional), 1.f equals no reduction
+        float _decimationLfoDepth;
+
+        // per channel sample-and-hold state, the remaining hold time is
+        // tracked fractionally so rate changes carry over across process cycles
+
+        std::vector<float> _heldSamples;
+        std::vector<float> _holdRemaining;
+
+        void decimate( float* channelBuffer, int bufferSize, int channel );
+
+        // the hold period for given decimation value, in samples at the (oversampled) processing rate
+        // when oversampling, a decimation of 0 still equals no reduction, a period below a single sample
+        // (at a reduced processing rate) equals no reduction as well
+
+        inline float getHoldPeriod( float decimation )
+        {
+            return ( decimation > 0.f ) ? std::max( 1.f, powf( MAX_HOLD_PERIOD, decimation ) * _rateRatio ) : 1.f;
+        }
 };
 }
 
@@ -0,0 +1,129 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "compensationdelay.h"
+#include <algorithm>
+
+namespace Igorski {
+
+/* constructor / destructor */
+
+CompensationDelay::CompensationDelay( int amountOfChannels, int maxDelay, int maxBufferSize )
+{
+    _amountOfChannels = amountOfChannels;
+    _maxDelay         = maxDelay;
+
+    // the whole process cycle is written prior to reading, as such the
+    // ring must hold the maximum delay in addition to a full process cycle
+
+    _size = 1;
+    while ( _size < maxDelay + maxBufferSize ) {
+        _size <<= 1;
+    }
+    _mask = _size - 1;
+
+    _buffer.resize(( size_t ) _size * amountOfChannels, 0.f );
+    _writeIndex = 0;
+    _delay      = 0;
+}
+
+CompensationDelay::~CompensationDelay()
+{
+
+}
+
+/* public methods */
+
+void CompensationDelay::setDelay( int samples )
+{
+    samples = std::min( _maxDelay, std::max( 0, samples ));
+
+    if ( samples == _delay ) {
+        return;
+    }
+    _delay = samples;
+}
+
+int CompensationDelay::getDelay()
+{
+    return _delay;
+}
+
+void CompensationDelay::process( AudioBuffer* input, AudioBuffer* output, int bufferSize )
+{
+    int amountOfChannels = std::min( _amountOfChannels, std::min( input->amountOfChannels, output->amountOfChannels ));
+
+    // process cycles larger than the ring (should not happen as host honours maxSamplesPerBlock) are split
+
+    int maxChunkSize = _size - _delay;
+
+    for ( int offset = 0; offset < bufferSize; )
+    {
+        int chunkSize  = std::min( maxChunkSize, bufferSize - offset );
+        int readIndex  = ( _writeIndex - _delay ) & _mask;
+
+        for ( int c = 0; c < amountOfChannels; ++c )
+        {
+            float* ring          = &_buffer[( size_t ) c * _size ];
+            float* inputBuffer   = input->getBufferForChannel( c ) + offset;
+            float* outputBuffer  = output->getBufferForChannel( c ) + offset;
+
+            for ( int i = 0; i < chunkSize; ++i ) {
+                ring[ ( _writeIndex + i ) & _mask ] = inputBuffer[ i ];
+            }
+            for ( int i = 0; i < chunkSize; ++i ) {
+                outputBuffer[ i ] = ring[ ( readIndex + i ) & _mask ];
+            }
+        }
+        _writeIndex = ( _writeIndex + chunkSize ) & _mask;
+        offset     += chunkSize;
+    }
+}
+
+void CompensationDelay::write( AudioBuffer* input, int bufferSize )
+{
+    int amountOfChannels = std::min( _amountOfChannels, input->amountOfChannels );
+
+    // only the most recent _size samples are retained
+
+    int offset = std::max( 0, bufferSize - _size );
+    int length = bufferSize - offset;
+
+    for ( int c = 0; c < amountOfChannels; ++c )
+    {
+        float* ring        = &_buffer[( size_t ) c * _size ];
+        float* inputBuffer = input->getBufferForChannel( c ) + offset;
+
+        for ( int i = 0; i < length; ++i ) {
+            ring[ ( _writeIndex + i ) & _mask ] = inputBuffer[ i ];
+        }
+    }
+    _writeIndex = ( _writeIndex + length ) & _mask;
+}
+
+void CompensationDelay::reset()
+{
+    std::fill( _buffer.begin(), _buffer.end(), 0.f );
+    _writeIndex = 0;
+}
+
+}
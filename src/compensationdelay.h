@@ -0,0 +1,74 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __COMPENSATIONDELAY_H_INCLUDED__
+#define __COMPENSATIONDELAY_H_INCLUDED__
+
+#include "audiobuffer.h"
+#include <vector>
+
+namespace Igorski {
+/**
+ * Delays a signal by a whole amount of samples, used to align a signal with
+ * another that went through processing that introduces latency (e.g. to keep
+ * the dry signal in phase with the wet signal when mixing).
+ *
+ * Each channel has a ring buffer (allocated upon construction, which happens in
+ * setupProcessing) large enough to hold the maximum delay plus a full process cycle.
+ */
+class CompensationDelay
+{
+    public:
+        CompensationDelay( int amountOfChannels, int maxDelay, int maxBufferSize );
+        ~CompensationDelay();
+
+        // the delay in samples (clamped to the maximum delay), changing the delay only moves
+        // the read position, the history is retained so the delayed signal continues without dropout
+
+        void setDelay( int samples );
+        int getDelay();
+
+        // write bufferSize samples of input into the ring and read the delayed signal into output
+        // (the buffers can be the same)
+
+        void process( AudioBuffer* input, AudioBuffer* output, int bufferSize );
+
+        // write bufferSize samples of input into the ring without reading, used while no delay is
+        // applied so the history is available once a delay is set
+
+        void write( AudioBuffer* input, int bufferSize );
+
+        void reset();
+
+    private:
+        int _amountOfChannels;
+        int _maxDelay;
+        int _size; // per channel, power of two
+        int _mask;
+        int _writeIndex;
+        int _delay;
+
+        std::vector<float> _buffer; // all channels, each occupying _size samples
+};
+}
+
+#endif
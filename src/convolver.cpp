@@ -0,0 +1,553 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "convolver.h"
+#include "global.h"
+#include "wavefile.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+
+namespace Igorski {
+
+// states of a tail job, a slot is tagged with both the job and its state (see toTag())
+// so neither thread can act upon a slot that has since been rescheduled for a later job
+
+enum TailState {
+    FREE = 0, // not scheduled (or cancelled)
+    PENDING,  // scheduled, awaiting computation by the background thread
+    CLAIMED,  // being computed by the background thread
+    DONE      // computed, awaiting consumption by the audio thread
+};
+
+static inline int64_t toTag( int64_t job, TailState state )
+{
+    return job * 4 + state;
+}
+
+static inline TailState getState( int64_t tag )
+{
+    return ( TailState ) ( tag & 3 );
+}
+
+struct Convolver::Kernel
+{
+    int amountOfChannels;   // of the processor
+    int amountOfIRChannels;
+    int amountOfPartitions; // including the direct (time domain) partition
+    int amountOfBins;
+    int spectrumSize;       // real values followed by imaginary values, e.g. 2 * amountOfBins
+    int amountOfSlots;      // tail jobs in flight, equals the amount of early partitions
+
+    std::vector<float> head;    // per IR channel, the first partition (time domain)
+    std::vector<float> spectra; // per IR channel, per partition (the first is unused)
+
+    // per channel convolution state
+
+    std::vector<float> history;   // the previous and current input block
+    std::vector<float> delayLine; // frequency domain delay line, the spectra of the last amountOfPartitions input blocks
+    std::vector<float> output;    // the frequency domain convolution result for the current block
+    int position;                 // within the current block
+    int64_t block;                // index of the current block
+    std::atomic<int> amountOfActiveChannels;
+
+    // tail jobs, job n is scheduled in slot ( n % amountOfSlots )
+
+    std::vector<float> tails; // per slot, per channel spectrum
+    std::unique_ptr<std::atomic<int64_t>[]> tags; // per slot, the job and its state
+    std::atomic<int64_t> submitted; // amount of scheduled jobs
+    int64_t processed;              // next job to consider by the background thread
+
+    Kernel( AudioBuffer* impulseResponse, int length, int channels, int slots )
+    {
+        int size = PARTITION_SIZE;
+
+        amountOfChannels   = channels;
+        amountOfIRChannels = impulseResponse != nullptr ? impulseResponse->amountOfChannels : 0;
+        amountOfPartitions = ( length + size - 1 ) / size;
+        amountOfBins       = size + 1;
+        spectrumSize       = amountOfBins * 2;
+        amountOfSlots      = slots;
+
+        head.resize( amountOfIRChannels * size, 0.f );
+        spectra.resize(( size_t ) amountOfIRChannels * amountOfPartitions * spectrumSize, 0.f );
+
+        // each partition is zero padded to twice its size
+
+        FFT fft( size * 2 );
+        std::vector<float> partition( size * 2, 0.f );
+
+        for ( int c = 0; c < amountOfIRChannels; ++c )
+        {
+            const float* channelBuffer = impulseResponse->getBufferForChannel( c );
+
+            std::memcpy( &head[ c * size ], channelBuffer, std::min( size, length ) * sizeof( float ));
+
+            for ( int p = 1; p < amountOfPartitions; ++p )
+            {
+                int offset = p * size;
+                std::fill( partition.begin(), partition.end(), 0.f );
+                std::memcpy( partition.data(), channelBuffer + offset, std::min( size, length - offset ) * sizeof( float ));
+
+                float* spectrum = getSpectrum( c, p );
+                fft.forward( partition.data(), spectrum, spectrum + amountOfBins );
+            }
+        }
+
+        history.resize( channels * size * 2, 0.f );
+        delayLine.resize(( size_t ) channels * amountOfPartitions * spectrumSize, 0.f );
+        output.resize( channels * size, 0.f );
+        position = 0;
+        block    = 0;
+        amountOfActiveChannels.store( channels );
+
+        tails.resize( slots * channels * spectrumSize, 0.f );
+        tags.reset( new std::atomic<int64_t>[ slots ]);
+        for ( int i = 0; i < slots; ++i ) {
+            tags[ i ].store( toTag( 0, FREE ));
+        }
+        submitted.store( 0 );
+        processed = 0;
+    }
+
+    bool isEmpty()
+    {
+        return amountOfPartitions == 0 || amountOfIRChannels == 0;
+    }
+
+    bool hasTail()
+    {
+        return amountOfPartitions > amountOfSlots;
+    }
+
+    float* getSpectrum( int irChannel, int partition )
+    {
+        return &spectra[(( size_t ) irChannel * amountOfPartitions + partition ) * spectrumSize ];
+    }
+
+    // the input spectrum for given block (of which the last amountOfPartitions are kept)
+
+    float* getInput( int channel, int64_t blockIndex )
+    {
+        int index = ( int ) ((( blockIndex % amountOfPartitions ) + amountOfPartitions ) % amountOfPartitions );
+        return &delayLine[(( size_t ) channel * amountOfPartitions + index ) * spectrumSize ];
+    }
+
+    float* getTail( int slot, int channel )
+    {
+        return &tails[( slot * amountOfChannels + channel ) * spectrumSize ];
+    }
+
+    int getIRChannel( int channel )
+    {
+        return std::min( channel, amountOfIRChannels - 1 );
+    }
+};
+
+// complex multiplication of two split format spectra, added to the accumulator
+
+static inline void multiplyAccumulate( const float* input, const float* kernel, float* accumulator, int amountOfBins )
+{
+    const float* inputReal  = input;
+    const float* inputImag  = input + amountOfBins;
+    const float* kernelReal = kernel;
+    const float* kernelImag = kernel + amountOfBins;
+    float* accumulatorReal  = accumulator;
+    float* accumulatorImag  = accumulator + amountOfBins;
+
+    for ( int i = 0; i < amountOfBins; ++i ) {
+        accumulatorReal[ i ] += inputReal[ i ] * kernelReal[ i ] - inputImag[ i ] * kernelImag[ i ];
+        accumulatorImag[ i ] += inputReal[ i ] * kernelImag[ i ] + inputImag[ i ] * kernelReal[ i ];
+    }
+}
+
+/* constructor / destructor */
+
+Convolver::Convolver( int amountOfChannels, int maxBufferSize )
+{
+    _amountOfChannels = amountOfChannels;
+    _mix              = 1.f;
+
+    // the background thread has ( early partitions - 1 ) blocks of time to compute the tail, this should
+    // span at least two process cycles as the audio thread can complete multiple blocks in a single cycle
+
+    _amountOfEarlyPartitions = std::max( 4, 2 * (( maxBufferSize + PARTITION_SIZE - 1 ) / PARTITION_SIZE ) + 2 );
+
+    _kernel = nullptr;
+    _pendingKernel.store( nullptr );
+    _retiredKernel.store( nullptr );
+    _activeKernel.store( nullptr );
+    _hasWork.store( false );
+
+    _fft = new FFT( PARTITION_SIZE * 2 );
+    _accumulator.resize(( PARTITION_SIZE + 1 ) * 2, 0.f );
+    _block.resize( PARTITION_SIZE * 2, 0.f );
+    _wet.resize( PARTITION_SIZE, 0.f );
+
+    _running.store( true );
+    _thread = std::thread( &Convolver::run, this );
+}
+
+Convolver::~Convolver()
+{
+    {
+        std::lock_guard<std::mutex> lock( _mutex );
+        _running.store( false );
+    }
+    _condition.notify_one();
+    _thread.join();
+
+    delete _kernel;
+    delete _pendingKernel.exchange( nullptr );
+    delete _retiredKernel.exchange( nullptr );
+    delete _fft;
+}
+
+/* public methods */
+
+bool Convolver::loadImpulseResponse( const char* path )
+{
+    int maxLength = ( int ) ( MAX_IR_DURATION * VST::SAMPLE_RATE );
+    AudioBuffer* impulseResponse = WaveFile::load( path, VST::SAMPLE_RATE, maxLength );
+
+    if ( impulseResponse == nullptr ) {
+        return false;
+    }
+    setImpulseResponse( impulseResponse, impulseResponse->bufferSize );
+    delete impulseResponse;
+
+    return true;
+}
+
+void Convolver::setImpulseResponse( AudioBuffer* impulseResponse, int length )
+{
+    Kernel* kernel = new Kernel( impulseResponse, length, _amountOfChannels, _amountOfEarlyPartitions );
+
+    // a previously loaded kernel that wasn't picked up yet by the audio thread can be disposed of right away
+
+    delete _pendingKernel.exchange( kernel );
+}
+
+void Convolver::clearImpulseResponse()
+{
+    setImpulseResponse( nullptr, 0 );
+}
+
+void Convolver::setMix( float value )
+{
+    _mix = value;
+}
+
+void Convolver::process( AudioBuffer* input, AudioBuffer* output, int bufferSize )
+{
+    acquireKernel();
+
+    int amountOfChannels = std::min( _amountOfChannels, std::min( input->amountOfChannels, output->amountOfChannels ));
+
+    if ( _kernel == nullptr || _kernel->isEmpty() )
+    {
+        for ( int c = 0; c < amountOfChannels; ++c ) {
+            float* inputBuffer  = input->getBufferForChannel( c );
+            float* outputBuffer = output->getBufferForChannel( c );
+            if ( inputBuffer != outputBuffer ) {
+                std::memcpy( outputBuffer, inputBuffer, bufferSize * sizeof( float ));
+            }
+        }
+        return;
+    }
+
+    Kernel* kernel = _kernel;
+    kernel->amountOfActiveChannels.store( amountOfChannels, std::memory_order_relaxed );
+
+    float dry = 1.f - _mix;
+    float wet = _mix;
+
+    // process in chunks that don't cross block boundaries
+
+    for ( int offset = 0; offset < bufferSize; )
+    {
+        int chunkSize = std::min( bufferSize - offset, PARTITION_SIZE - kernel->position );
+
+        for ( int c = 0; c < amountOfChannels; ++c )
+        {
+            float* current    = &kernel->history[ c * PARTITION_SIZE * 2 + PARTITION_SIZE + kernel->position ];
+            const float* head = &kernel->head[ kernel->getIRChannel( c ) * PARTITION_SIZE ];
+            float* result     = _wet.data();
+
+            std::memcpy( current, input->getBufferForChannel( c ) + offset, chunkSize * sizeof( float ));
+            std::memcpy( result, &kernel->output[ c * PARTITION_SIZE + kernel->position ], chunkSize * sizeof( float ));
+
+            // the first partition is convolved directly, a single tap across the chunk at a time
+
+            for ( int t = 0; t < PARTITION_SIZE; ++t )
+            {
+                float coefficient = head[ t ];
+
+                if ( coefficient == 0.f )
+                    continue;
+
+                const float* delayed = current - t;
+                for ( int i = 0; i < chunkSize; ++i ) {
+                    result[ i ] += coefficient * delayed[ i ];
+                }
+            }
+
+            float* outputBuffer = output->getBufferForChannel( c ) + offset;
+            for ( int i = 0; i < chunkSize; ++i ) {
+                outputBuffer[ i ] = current[ i ] * dry + result[ i ] * wet;
+            }
+        }
+
+        kernel->position += chunkSize;
+        offset += chunkSize;
+
+        if ( kernel->position == PARTITION_SIZE ) {
+            completeBlock( kernel );
+            kernel->position = 0;
+        }
+    }
+}
+
+/* private methods */
+
+void Convolver::acquireKernel()
+{
+    // swap in the most recently loaded kernel, this is postponed while the background thread hasn't
+    // disposed of the previously released kernel (which is signalled each cycle, see run())
+
+    if ( _retiredKernel.load( std::memory_order_acquire ) != nullptr ) {
+        wakeBackgroundThread();
+        return;
+    }
+
+    if ( _pendingKernel.load( std::memory_order_acquire ) == nullptr ) {
+        return;
+    }
+
+    Kernel* kernel = _pendingKernel.exchange( nullptr, std::memory_order_acq_rel );
+
+    if ( _kernel != nullptr ) {
+        cancelTail( _kernel );
+        _retiredKernel.store( _kernel, std::memory_order_release );
+    }
+    _kernel = kernel;
+    _activeKernel.store( kernel, std::memory_order_release );
+    wakeBackgroundThread();
+}
+
+void Convolver::completeBlock( Kernel* kernel )
+{
+    int amountOfChannels = kernel->amountOfActiveChannels.load( std::memory_order_relaxed );
+    int amountOfBins     = kernel->amountOfBins;
+    int64_t block        = kernel->block;
+    int earlyPartitions  = std::min( _amountOfEarlyPartitions, kernel->amountOfPartitions );
+
+    // the tail for the next block was scheduled ( early partitions - 1 ) blocks ago, when the background
+    // thread hasn't delivered it (yet), the audio thread computes it rather than awaiting the result
+
+    int64_t tailJob   = block + 1 - kernel->amountOfSlots;
+    int tailSlot      = ( int ) (( block + 1 ) % kernel->amountOfSlots );
+    bool hasTail      = kernel->hasTail() && tailJob >= 0;
+    bool isTailReady  = hasTail && acquireTail( kernel, tailJob );
+
+    for ( int c = 0; c < amountOfChannels; ++c )
+    {
+        // transform the previous and current input block (overlap-save) into the delay line
+
+        float* history  = &kernel->history[ c * PARTITION_SIZE * 2 ];
+        float* spectrum = kernel->getInput( c, block );
+
+        _fft->forward( history, spectrum, spectrum + amountOfBins );
+        std::memcpy( history, history + PARTITION_SIZE, PARTITION_SIZE * sizeof( float ));
+
+        // the next block receives the contribution of the early partitions
+        // (partition p applies to the input of p blocks ago) and the precomputed tail
+
+        float* accumulator = _accumulator.data();
+        int irChannel      = kernel->getIRChannel( c );
+
+        if ( isTailReady ) {
+            std::memcpy( accumulator, kernel->getTail( tailSlot, c ), kernel->spectrumSize * sizeof( float ));
+        } else {
+            std::fill( _accumulator.begin(), _accumulator.end(), 0.f );
+            if ( hasTail ) {
+                accumulateTail( kernel, c, block + 1, accumulator );
+            }
+        }
+
+        for ( int p = 1; p < earlyPartitions; ++p ) {
+            multiplyAccumulate( kernel->getInput( c, block + 1 - p ), kernel->getSpectrum( irChannel, p ), accumulator, amountOfBins );
+        }
+
+        // only the second half of the inverse transform is free of circular aliasing
+
+        _fft->inverse( accumulator, accumulator + amountOfBins, _block.data() );
+        std::memcpy( &kernel->output[ c * PARTITION_SIZE ], &_block[ PARTITION_SIZE ], PARTITION_SIZE * sizeof( float ));
+    }
+
+    // schedule the tail for the block the background thread needs to deliver next
+
+    if ( kernel->hasTail() ) {
+        scheduleTail( kernel, block );
+    }
+    ++kernel->block;
+}
+
+void Convolver::scheduleTail( Kernel* kernel, int64_t job )
+{
+    std::atomic<int64_t>& tag = kernel->tags[ job % kernel->amountOfSlots ];
+    int64_t current = tag.load( std::memory_order_acquire );
+
+    // a slot is not rescheduled while the background thread is still computing a (late) previous
+    // job into it, the audio thread computes the tail of the skipped job itself (see completeBlock())
+
+    if ( getState( current ) != CLAIMED ) {
+        tag.compare_exchange_strong( current, toTag( job, PENDING ), std::memory_order_acq_rel );
+    }
+    kernel->submitted.store( job + 1, std::memory_order_release );
+
+    wakeBackgroundThread();
+}
+
+bool Convolver::acquireTail( Kernel* kernel, int64_t job )
+{
+    std::atomic<int64_t>& tag = kernel->tags[ job % kernel->amountOfSlots ];
+
+    if ( tag.load( std::memory_order_acquire ) == toTag( job, DONE )) {
+        return true;
+    }
+
+    // cancel the job when the background thread hasn't started it, when it has, its
+    // (late) result is discarded as the slot is rescheduled for a later job only once it is done
+
+    int64_t expected = toTag( job, PENDING );
+    tag.compare_exchange_strong( expected, toTag( job, FREE ), std::memory_order_acq_rel );
+
+    return false;
+}
+
+void Convolver::accumulateTail( Kernel* kernel, int channel, int64_t target, float* spectrum )
+{
+    // partition p applies to the input spectrum of p blocks before the target block
+
+    int irChannel = kernel->getIRChannel( channel );
+
+    for ( int p = kernel->amountOfSlots; p < kernel->amountOfPartitions; ++p ) {
+        multiplyAccumulate( kernel->getInput( channel, target - p ), kernel->getSpectrum( irChannel, p ), spectrum, kernel->amountOfBins );
+    }
+}
+
+void Convolver::computeTail( Kernel* kernel, int64_t job )
+{
+    // job n computes the contribution of the tail partitions to block ( n + early partitions )
+
+    int slot             = ( int ) ( job % kernel->amountOfSlots );
+    int amountOfChannels = kernel->amountOfActiveChannels.load( std::memory_order_relaxed );
+
+    for ( int c = 0; c < amountOfChannels; ++c )
+    {
+        float* tail = kernel->getTail( slot, c );
+
+        std::fill( tail, tail + kernel->spectrumSize, 0.f );
+        accumulateTail( kernel, c, job + kernel->amountOfSlots, tail );
+    }
+}
+
+void Convolver::cancelTail( Kernel* kernel )
+{
+    // invoked before releasing a kernel, jobs the background thread hasn't started are cancelled
+    // (jobs in progress are left to complete, the background thread disposes of the kernel afterwards)
+
+    for ( int slot = 0; slot < kernel->amountOfSlots; ++slot )
+    {
+        int64_t current = kernel->tags[ slot ].load( std::memory_order_acquire );
+        if ( getState( current ) == PENDING ) {
+            kernel->tags[ slot ].compare_exchange_strong( current, current - PENDING + FREE, std::memory_order_acq_rel );
+        }
+    }
+}
+
+void Convolver::wakeBackgroundThread()
+{
+    // invoked on the audio thread, which must not block, as such the lock is not acquired
+
+    _hasWork.store( true, std::memory_order_release );
+    _condition.notify_one();
+}
+
+void Convolver::run()
+{
+    while ( true )
+    {
+        {
+            // sleep until the audio thread has work. As it signals without acquiring the lock, a notification
+            // arriving between the check and the wait is missed, the audio thread signals again on its
+            // next block (scheduling the next tail) or cycle (awaiting kernel disposal, see acquireKernel())
+
+            std::unique_lock<std::mutex> lock( _mutex );
+            _condition.wait( lock, [ this ]() {
+                return _hasWork.load( std::memory_order_acquire ) || !_running.load( std::memory_order_acquire );
+            });
+            _hasWork.store( false, std::memory_order_relaxed );
+        }
+
+        if ( !_running.load( std::memory_order_acquire )) {
+            break;
+        }
+
+        Kernel* retired = _retiredKernel.load( std::memory_order_acquire );
+        if ( retired != nullptr ) {
+            delete retired;
+            _retiredKernel.store( nullptr, std::memory_order_release );
+        }
+
+        // a kernel is only released (and subsequently deleted above) by the audio thread after it
+        // has been replaced as the active kernel, as such the active kernel remains valid for this iteration
+
+        Kernel* kernel = _activeKernel.load( std::memory_order_acquire );
+        if ( kernel == nullptr || !kernel->hasTail() ) {
+            continue;
+        }
+
+        int64_t submitted = kernel->submitted.load( std::memory_order_acquire );
+
+        // jobs older than the amount of slots have been overwritten (and computed by the audio thread)
+        kernel->processed = std::max( kernel->processed, submitted - kernel->amountOfSlots );
+
+        while ( kernel->processed < submitted && _running.load( std::memory_order_relaxed ) &&
+                _activeKernel.load( std::memory_order_relaxed ) == kernel )
+        {
+            int64_t job = kernel->processed++;
+
+            std::atomic<int64_t>& tag = kernel->tags[ job % kernel->amountOfSlots ];
+            int64_t expected = toTag( job, PENDING );
+
+            if ( tag.compare_exchange_strong( expected, toTag( job, CLAIMED ), std::memory_order_acq_rel )) {
+                computeTail( kernel, job );
+                tag.store( toTag( job, DONE ), std::memory_order_release );
+            }
+        }
+    }
+}
+
+}
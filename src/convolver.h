@@ -0,0 +1,118 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __CONVOLVER_H_INCLUDED__
+#define __CONVOLVER_H_INCLUDED__
+
+#include "audiobuffer.h"
+#include "fft.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Igorski {
+/**
+ * Zero latency convolution (e.g. for cabinet and room impulse responses) using a
+ * uniformly partitioned, frequency domain (overlap-save) algorithm.
+ *
+ * The impulse response is split into partitions of PARTITION_SIZE samples.
+ * The first partition is convolved directly in the time domain so the output is not delayed.
+ * The next partitions are convolved in the frequency domain on the audio thread, while the
+ * remaining (tail) partitions are computed on a background thread. The tail of the output
+ * is required a number of partitions after it has been scheduled, which leaves the
+ * background thread several process cycles of time. Should it not have
+ * finished in time, the audio thread computes the result itself (it never awaits the background thread).
+ *
+ * Impulse responses are loaded (and transformed) on the calling thread, which must not
+ * be the audio thread. The audio thread picks up the new impulse response on its next process cycle.
+ */
+class Convolver
+{
+    public:
+        static constexpr int PARTITION_SIZE    = 256;
+        static constexpr float MAX_IR_DURATION = 10.f; // in seconds
+
+        Convolver( int amountOfChannels, int maxBufferSize );
+        ~Convolver();
+
+        // load the impulse response from given WAV file, returns false when the file could not be read
+        // mono impulse responses are applied to all channels, multichannel impulse responses per channel
+
+        bool loadImpulseResponse( const char* path );
+
+        // use the first length samples of given buffer as the impulse response (contents are copied)
+
+        void setImpulseResponse( AudioBuffer* impulseResponse, int length );
+        void clearImpulseResponse();
+
+        // the balance between the input (0) and convolved signal (1)
+
+        void setMix( float value );
+
+        // convolve bufferSize samples of input into output (the buffers can be the same)
+
+        void process( AudioBuffer* input, AudioBuffer* output, int bufferSize );
+
+    private:
+        // the partitioned impulse response along with the convolution
+        // state that depends on its size (see convolver.cpp)
+
+        struct Kernel;
+
+        int _amountOfChannels;
+        int _amountOfEarlyPartitions; // partitions computed on the audio thread (including the direct partition)
+        float _mix;
+
+        Kernel* _kernel;                       // in use by the audio thread
+        std::atomic<Kernel*> _pendingKernel;   // created by the loading thread, awaiting pick up by the audio thread
+        std::atomic<Kernel*> _retiredKernel;   // released by the audio thread, awaiting disposal by the background thread
+        std::atomic<Kernel*> _activeKernel;    // the kernel the background thread computes tails for
+
+        FFT* _fft;
+        std::vector<float> _accumulator; // spectrum of the next output block
+        std::vector<float> _block;       // time domain result of the inverse transform
+        std::vector<float> _wet;         // convolved signal of the current chunk
+
+        // background thread
+
+        std::thread _thread;
+        std::mutex _mutex;
+        std::condition_variable _condition;
+        std::atomic<bool> _running;
+        std::atomic<bool> _hasWork; // set by the audio thread, the background thread sleeps until then
+
+        void run();
+        void wakeBackgroundThread();
+        void acquireKernel();
+        void completeBlock( Kernel* kernel );
+        void scheduleTail( Kernel* kernel, int64_t job );
+        bool acquireTail( Kernel* kernel, int64_t job ); // whether the background thread delivered the job
+        void accumulateTail( Kernel* kernel, int channel, int64_t target, float* spectrum );
+        void computeTail( Kernel* kernel, int64_t job );
+        void cancelTail( Kernel* kernel );
+};
+}
+
+#endif
@@ -0,0 +1,211 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "crossover.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Igorski {
+
+// Butterworth quality factor, two cascaded Butterworth sections make up a Linkwitz-Riley filter
+
+static constexpr float BUTTERWORTH_Q = .70710678f;
+
+/* constructor / destructor */
+
+Crossover::Crossover( int amountOfChannels, int maxBufferSize )
+{
+    _amountOfChannels = amountOfChannels;
+    _amountOfBands    = 2;
+    _rateRatio        = 1.f;
+
+    _frequencies[ 0 ] = 200.f;
+    _frequencies[ 1 ] = 1000.f;
+    _frequencies[ 2 ] = 5000.f;
+
+    _filters = new BiquadBank( amountOfChannels * MAX_BANDS, ( MAX_BANDS - 1 ) * 2, maxBufferSize );
+
+    for ( int b = 0; b < MAX_BANDS; ++b ) {
+        _bands.push_back( new AudioBuffer( amountOfChannels, maxBufferSize ));
+    }
+    _lanes.resize( amountOfChannels * MAX_BANDS, nullptr );
+
+    cacheFilters();
+    _filters->reset();
+}
+
+Crossover::~Crossover()
+{
+    delete _filters;
+
+    for ( auto band : _bands ) {
+        delete band;
+    }
+}
+
+/* public methods */
+
+int Crossover::getAmountOfBands()
+{
+    return _amountOfBands;
+}
+
+void Crossover::setAmountOfBands( int value )
+{
+    value = std::min( MAX_BANDS, std::max( 2, value ));
+
+    if ( value == _amountOfBands ) {
+        return;
+    }
+    _amountOfBands = value;
+
+    // the lane assignment changes, interpolating across the previous assignment is meaningless
+
+    cacheFilters();
+    _filters->reset();
+}
+
+float Crossover::getFrequency( int index )
+{
+    return _frequencies[ index ];
+}
+
+void Crossover::setFrequency( int index, float frequency )
+{
+    if ( index < 0 || index >= MAX_BANDS - 1 || _frequencies[ index ] == frequency ) {
+        return;
+    }
+    _frequencies[ index ] = frequency;
+
+    cacheFilters();
+}
+
+void Crossover::setProcessingRate( float ratio )
+{
+    if ( ratio == _rateRatio ) {
+        return;
+    }
+    _rateRatio = ratio;
+
+    cacheFilters();
+}
+
+AudioBuffer* Crossover::getBand( int band )
+{
+    return _bands[ band ];
+}
+
+void Crossover::split( AudioBuffer* input, int bufferSize )
+{
+    int amountOfChannels = std::min( _amountOfChannels, input->amountOfChannels );
+    int amountOfLanes    = 0;
+
+    bufferSize = std::min( bufferSize, _bands[ 0 ]->bufferSize );
+
+    // each band starts out as a copy of the input
+
+    for ( int c = 0; c < amountOfChannels; ++c )
+    {
+        const float* channelBuffer = input->getBufferForChannel( c );
+
+        for ( int b = 0; b < _amountOfBands; ++b ) {
+            float* bandBuffer = _bands[ b ]->getBufferForChannel( c );
+            std::memcpy( bandBuffer, channelBuffer, bufferSize * sizeof( float ));
+            _lanes[ amountOfLanes++ ] = bandBuffer;
+        }
+    }
+    _filters->process( _lanes.data(), amountOfLanes, bufferSize );
+}
+
+void Crossover::merge( AudioBuffer* output, int bufferSize )
+{
+    int amountOfChannels = std::min( _amountOfChannels, output->amountOfChannels );
+
+    bufferSize = std::min( bufferSize, _bands[ 0 ]->bufferSize );
+
+    for ( int c = 0; c < amountOfChannels; ++c )
+    {
+        float* channelBuffer = output->getBufferForChannel( c );
+
+        std::memcpy( channelBuffer, _bands[ 0 ]->getBufferForChannel( c ), bufferSize * sizeof( float ));
+
+        for ( int b = 1; b < _amountOfBands; ++b ) {
+            const float* bandBuffer = _bands[ b ]->getBufferForChannel( c );
+            for ( int i = 0; i < bufferSize; ++i ) {
+                channelBuffer[ i ] += bandBuffer[ i ];
+            }
+        }
+    }
+}
+
+/* private methods */
+
+void Crossover::cacheFilters()
+{
+    // crossover k occupies sections 2k and 2k + 1, for band b it is a
+    // high pass when below the band (k < b), a low pass when directly above (k == b)
+    // and an allpass (single section) when further above (k > b)
+
+    int amountOfCrossovers = _amountOfBands - 1;
+
+    // the bands only sum flat when the crossover frequencies are ascending
+
+    float frequencies[ MAX_BANDS - 1 ];
+    for ( int k = 0; k < amountOfCrossovers; ++k ) {
+        frequencies[ k ] = ( k == 0 ) ? _frequencies[ k ] : std::max( _frequencies[ k ], frequencies[ k - 1 ]);
+    }
+
+    // the filters are designed at the host rate (see BiquadBank), scale the frequencies to the processing rate
+
+    for ( int k = 0; k < amountOfCrossovers; ++k ) {
+        frequencies[ k ] /= _rateRatio;
+    }
+
+    _filters->setAmountOfSections( amountOfCrossovers * 2 );
+
+    for ( int c = 0; c < _amountOfChannels; ++c )
+    {
+        for ( int b = 0; b < _amountOfBands; ++b )
+        {
+            int lane = c * _amountOfBands + b;
+
+            for ( int k = 0; k < amountOfCrossovers; ++k )
+            {
+                float frequency = frequencies[ k ];
+                int section     = k * 2;
+
+                if ( k < b ) {
+                    _filters->setFilter( section,     lane, BiquadBank::HIGH_PASS, frequency, BUTTERWORTH_Q );
+                    _filters->setFilter( section + 1, lane, BiquadBank::HIGH_PASS, frequency, BUTTERWORTH_Q );
+                } else if ( k == b ) {
+                    _filters->setFilter( section,     lane, BiquadBank::LOW_PASS, frequency, BUTTERWORTH_Q );
+                    _filters->setFilter( section + 1, lane, BiquadBank::LOW_PASS, frequency, BUTTERWORTH_Q );
+                } else {
+                    _filters->setFilter( section,     lane, BiquadBank::ALL_PASS, frequency, BUTTERWORTH_Q );
+                    _filters->setFilter( section + 1, lane, BiquadBank::BYPASS, frequency, BUTTERWORTH_Q );
+                }
+            }
+        }
+    }
+}
+
+}
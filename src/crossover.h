@@ -0,0 +1,88 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __CROSSOVER_H_INCLUDED__
+#define __CROSSOVER_H_INCLUDED__
+
+#include "audiobuffer.h"
+#include "biquadbank.h"
+#include <vector>
+
+namespace Igorski {
+/**
+ * Splits a signal into 2 to 4 frequency bands using 4th order Linkwitz-Riley
+ * crossovers, the sum of the bands has a flat magnitude response.
+ *
+ * The bands are derived in parallel rather than as a tree: each band is the product of
+ * a filter for each crossover frequency (a high pass for crossovers below the band, a low pass
+ * for the crossover directly above it and an allpass for the crossovers further above it,
+ * compensating the phase of the bands above). As such each band runs the same cascade of
+ * ( bands - 1 ) * 2 biquad sections, and all bands of a channel are processed in parallel
+ * lanes of a single BiquadBank (e.g. 4 bands of a stereo signal fill all 8 lanes).
+ */
+class Crossover
+{
+    public:
+        static constexpr int MAX_BANDS = 4;
+
+        Crossover( int amountOfChannels, int maxBufferSize );
+        ~Crossover();
+
+        int getAmountOfBands();
+        void setAmountOfBands( int value );
+
+        // frequency (in Hz at the host rate) of the crossover between band index and index + 1
+
+        float getFrequency( int index );
+        void setFrequency( int index, float frequency );
+
+        // ratio of the processing rate to the host rate (see BitCrusher::setProcessingRate())
+
+        void setProcessingRate( float ratio );
+
+        // the band signals of the last split() (band 0 being the lowest)
+
+        AudioBuffer* getBand( int band );
+
+        // split bufferSize samples of given input into the bands
+
+        void split( AudioBuffer* input, int bufferSize );
+
+        // sum the bands into given output, replacing its contents
+
+        void merge( AudioBuffer* output, int bufferSize );
+
+    private:
+        int _amountOfChannels;
+        int _amountOfBands;
+        float _frequencies[ MAX_BANDS - 1 ];
+        float _rateRatio;
+
+        BiquadBank* _filters;
+        std::vector<AudioBuffer*> _bands;
+        std::vector<float*> _lanes; // band buffers in lane order, e.g. per channel all bands
+
+        void cacheFilters();
+};
+}
+
+#endif
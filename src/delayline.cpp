@@ -0,0 +1,222 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "delayline.h"
+#include "calc.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Igorski {
+
+/* constructor / destructor */
+
+DelayLine::DelayLine( int amountOfChannels, int maxBufferSize )
+{
+    _amountOfChannels = amountOfChannels;
+
+    _maxDelay = ( float ) Calc::secondsToBuffer( MAX_DELAY_TIME );
+
+    int required = ( int ) _maxDelay + Calc::secondsToBuffer( MAX_MODULATION_TIME ) + INTERPOLATION_MARGIN;
+    _size = 1;
+    while ( _size < required ) {
+        _size <<= 1;
+    }
+    _mask = _size - 1;
+
+    _buffer.resize(( size_t ) _size * amountOfChannels, 0.f );
+    _allpassState.resize( amountOfChannels, 0.f );
+    _delayTimes.resize( maxBufferSize, 0.f );
+    _writeIndex = 0;
+
+    _lfo = new LFO();
+    _lfo->setControlRate( 32 );
+
+    _glideCoefficient = expf( -1.f / ( GLIDE_TIME * VST::SAMPLE_RATE ));
+
+    _delay           = -1.f; // the first processed block starts at the target (no glide from an unset time)
+    _targetDelay     = ( float ) INTERPOLATION_MARGIN;
+    _feedback        = 0.f;
+    _mix             = 0.f;
+    _modulationDepth = 0.f;
+    _interpolation   = LINEAR;
+}
+
+DelayLine::~DelayLine()
+{
+    delete _lfo;
+}
+
+/* public methods */
+
+float DelayLine::getDelaySamples()
+{
+    return _targetDelay;
+}
+
+void DelayLine::setDelaySamples( float samples )
+{
+    _targetDelay = std::min( _maxDelay, std::max(( float ) INTERPOLATION_MARGIN, samples ));
+}
+
+void DelayLine::setFeedback( float value )
+{
+    _feedback = std::min( MAX_FEEDBACK, std::max( 0.f, value ));
+}
+
+void DelayLine::setMix( float value )
+{
+    _mix = Calc::cap( value );
+}
+
+void DelayLine::setModulation( float rate, float depth )
+{
+    _lfo->setRate( rate );
+    _modulationDepth = std::min( depth, MAX_MODULATION_TIME ) * VST::SAMPLE_RATE;
+}
+
+DelayLine::Interpolation DelayLine::getInterpolation()
+{
+    return _interpolation;
+}
+
+void DelayLine::setInterpolation( Interpolation value )
+{
+    _interpolation = value;
+}
+
+void DelayLine::reset()
+{
+    std::fill( _buffer.begin(), _buffer.end(), 0.f );
+    std::fill( _allpassState.begin(), _allpassState.end(), 0.f );
+    _delay = _targetDelay;
+}
+
+void DelayLine::process( AudioBuffer* buffer, int bufferSize )
+{
+    int amountOfChannels = std::min( _amountOfChannels, buffer->amountOfChannels );
+    bufferSize = std::min( bufferSize, ( int ) _delayTimes.size() );
+
+    // the delay times are evaluated once per block and shared by all channels
+    // the glide towards the target is approximated by a linear ramp towards the
+    // position the (exponential) glide reaches at the end of the block
+
+    if ( _delay < 0.f ) {
+        _delay = _targetDelay;
+    }
+
+    float* delayTimes = _delayTimes.data();
+    float start       = _delay;
+    float end         = _targetDelay + ( _delay - _targetDelay ) * powf( _glideCoefficient, ( float ) bufferSize );
+    float increment   = ( end - start ) / ( float ) bufferSize;
+
+    if ( _modulationDepth > 0.f ) {
+        // LFO output is bipolar, the modulation only lengthens the delay so short times remain valid
+        _lfo->renderBlock( delayTimes, bufferSize );
+        float depth = _modulationDepth * .5f;
+        for ( int i = 0; i < bufferSize; ++i ) {
+            delayTimes[ i ] = start + increment * ( float ) ( i + 1 ) + depth * ( 1.f + delayTimes[ i ]);
+        }
+    } else {
+        for ( int i = 0; i < bufferSize; ++i ) {
+            delayTimes[ i ] = start + increment * ( float ) ( i + 1 );
+        }
+    }
+    _delay = end;
+
+    float minDelay = ( float ) INTERPOLATION_MARGIN;
+    float maxDelay = ( float ) ( _size - INTERPOLATION_MARGIN );
+    for ( int i = 0; i < bufferSize; ++i ) {
+        delayTimes[ i ] = std::min( maxDelay, std::max( minDelay, delayTimes[ i ]));
+    }
+
+    float dry = 1.f - _mix;
+    float wet = _mix;
+
+    for ( int c = 0; c < amountOfChannels; ++c )
+    {
+        float* channelBuffer = buffer->getBufferForChannel( c );
+        float* delayBuffer   = &_buffer[( size_t ) c * _size ];
+        float allpassState   = _allpassState[ c ];
+        int writeIndex       = _writeIndex;
+
+        for ( int i = 0; i < bufferSize; ++i, ++writeIndex )
+        {
+            float delay    = delayTimes[ i ];
+            int samples    = ( int ) delay;
+            float fraction = delay - ( float ) samples;
+
+            // read the samples at the integer delay and one sample further back
+            // (the most recently written sample has a delay of 1 as we read before writing)
+
+            float x0 = delayBuffer[( writeIndex - samples ) & _mask ];
+            float x1 = delayBuffer[( writeIndex - samples - 1 ) & _mask ];
+            float delayed;
+
+            switch ( _interpolation )
+            {
+                default:
+                case LINEAR:
+                    delayed = x0 + ( x1 - x0 ) * fraction;
+                    break;
+
+                case CUBIC:
+                {
+                    float xm1 = delayBuffer[( writeIndex - samples + 1 ) & _mask ];
+                    float x2  = delayBuffer[( writeIndex - samples - 2 ) & _mask ];
+
+                    float c1 = .5f * ( x1 - xm1 );
+                    float c2 = xm1 - 2.5f * x0 + 2.f * x1 - .5f * x2;
+                    float c3 = .5f * ( x2 - xm1 ) + 1.5f * ( x0 - x1 );
+
+                    delayed = (( c3 * fraction + c2 ) * fraction + c1 ) * fraction + x0;
+                    break;
+                }
+
+                case ALLPASS:
+                {
+                    // fractions close to zero place the allpass pole near the unit circle
+                    // these are instead realized as a delay of one sample less plus ( 1 + fraction )
+
+                    if ( fraction < .1f ) {
+                        x1 = x0;
+                        x0 = delayBuffer[( writeIndex - samples + 1 ) & _mask ];
+                        fraction += 1.f;
+                    }
+                    float coefficient = ( 1.f - fraction ) / ( 1.f + fraction );
+
+                    delayed      = coefficient * ( x0 - allpassState ) + x1;
+                    allpassState = delayed;
+                    break;
+                }
+            }
+
+            float input = channelBuffer[ i ];
+
+            delayBuffer[ writeIndex & _mask ] = input + delayed * _feedback;
+            channelBuffer[ i ] = input * dry + delayed * wet;
+        }
+        _allpassState[ c ] = allpassState;
+    }
+    _writeIndex = ( _writeIndex + bufferSize ) & _mask;
+}
+
+}
@@ -0,0 +1,110 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __DELAYLINE_H_INCLUDED__
+#define __DELAYLINE_H_INCLUDED__
+
+#include "global.h"
+#include "audiobuffer.h"
+#include "lfo.h"
+#include <vector>
+
+namespace Igorski {
+/**
+ * Modulated delay line usable as an echo (long delay times with feedback) or a
+ * chorus (short delay times modulated by an LFO).
+ *
+ * The circular buffer is a power of two in size so the read and write positions wrap by masking.
+ * It is allocated upon construction (which happens in setupProcessing) to hold MAX_DELAY_TIME
+ * at the current sample rate, changing the delay time (e.g. on a tempo change) never reallocates.
+ * Changes in delay time glide to their new value to prevent discontinuities in the output.
+ */
+class DelayLine
+{
+    public:
+        enum Interpolation {
+            LINEAR = 0, // cheapest, slight high frequency loss for fractional delays
+            CUBIC,      // 4-point Hermite, flat response at the cost of more reads per sample
+            ALLPASS     // first order allpass, flat magnitude response, best suited to slow modulation
+        };
+
+        static constexpr float MAX_DELAY_TIME      = 4.f;   // in seconds, a full 4/4 measure at 60 BPM
+        static constexpr float MAX_MODULATION_TIME = .02f;  // in seconds
+        static constexpr float GLIDE_TIME          = .05f;  // in seconds, time constant of delay time changes
+        static constexpr float MAX_FEEDBACK        = .95f;
+
+        DelayLine( int amountOfChannels, int maxBufferSize );
+        ~DelayLine();
+
+        // delay time in samples at the host rate (clamped to MAX_DELAY_TIME)
+
+        float getDelaySamples();
+        void setDelaySamples( float samples );
+
+        void setFeedback( float value );
+
+        // the balance between the input (0) and delayed signal (1)
+
+        void setMix( float value );
+
+        // modulation of the delay time by the LFO, rate in Hz and depth in seconds
+
+        void setModulation( float rate, float depth );
+
+        Interpolation getInterpolation();
+        void setInterpolation( Interpolation value );
+
+        void reset();
+
+        // apply the delay onto given buffer, in place
+
+        void process( AudioBuffer* buffer, int bufferSize );
+
+    private:
+        int _amountOfChannels;
+        int _size;    // per channel, a power of two
+        int _mask;
+        int _writeIndex;
+
+        std::vector<float> _buffer; // channels are stored consecutively
+        std::vector<float> _allpassState;
+
+        float _delay;        // current delay time in samples (gliding towards the target), negative when unset
+        float _targetDelay;
+        float _maxDelay;
+        float _feedback;
+        float _mix;
+        float _modulationDepth; // in samples
+
+        Interpolation _interpolation;
+
+        LFO* _lfo;
+        std::vector<float> _delayTimes; // per sample delay time for the current block
+        float _glideCoefficient;        // per sample
+
+        // the amount of samples the interpolation reads behind the read position
+
+        static constexpr int INTERPOLATION_MARGIN = 3;
+};
+}
+
+#endif
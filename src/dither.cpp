@@ -0,0 +1,73 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "dither.h"
+#include "global.h"
+
+namespace Igorski {
+
+/* constructor */
+
+Dither::Dither( int amountOfChannels )
+{
+    _mode   = OFF;
+    _random = new Random( 0x2545F491 );
+
+    _noise.resize ( VST::BUFFER_SIZE, 0.f );
+    _errors.resize( amountOfChannels * 2, 0.f );
+}
+
+Dither::~Dither()
+{
+    delete _random;
+}
+
+/* public methods */
+
+Dither::Mode Dither::getMode()
+{
+    return _mode;
+}
+
+void Dither::setMode( Mode value )
+{
+    if ( value == _mode )
+        return;
+
+    _mode = value;
+
+    // flush the error history so no stale error is shaped into the new mode
+
+    std::fill( _errors.begin(), _errors.end(), 0.f );
+}
+
+float* Dither::generate( int bufferSize )
+{
+    if (( int ) _noise.size() < bufferSize ) {
+        _noise.resize( bufferSize ); // should not happen as host honours maxSamplesPerBlock
+    }
+    _random->triangular( _noise.data(), bufferSize );
+
+    return _noise.data();
+}
+
+}
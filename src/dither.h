@@ -0,0 +1,106 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __DITHER_H_INCLUDED__
+#define __DITHER_H_INCLUDED__
+
+#include "random.h"
+#include <algorithm>
+#include <vector>
+
+namespace Igorski {
+
+/**
+ * Dither decorrelates quantization error from the signal by adding triangular (TPDF)
+ * noise prior to quantization. When noise shaping is enabled, the quantization error is
+ * fed back through a second order filter which moves the noise floor away from the
+ * low and mid frequencies towards the top of the spectrum
+ *
+ * Dither can reduce the word length of a signal by itself (see process()) or be used
+ * by a different quantizer (see BitCrusher) through the generate(), getFeedback()
+ * and storeError() methods. In both cases values are expressed in LSB units
+ */
+class Dither {
+
+    public:
+        enum Mode {
+            OFF = 0,
+            TPDF,
+            NOISE_SHAPED
+        };
+
+        Dither( int amountOfChannels );
+        ~Dither();
+
+        Mode getMode();
+        void setMode( Mode value );
+
+        // generate the dither noise for a single channel and process cycle
+        // the returned block is owned by Dither and valid until the next invocation
+
+        float* generate( int bufferSize );
+
+        // the filtered quantization error of the previous samples, to be subtracted
+        // from the next sample prior to its quantization (is zero when not noise shaping)
+
+        inline float getFeedback( int channel )
+        {
+            if ( _mode != NOISE_SHAPED )
+                return 0.f;
+
+            float* error = &_errors[ channel * 2 ];
+
+            // error transfer function is ( 1 - z^-1 )^2, e.g. zeroes at DC
+
+            return 2.f * error[ 0 ] - error[ 1 ];
+        }
+
+        // store the quantization error of the last processed sample (e.g. quantized - unquantized value)
+        // the error is bound so a clipping quantizer cannot destabilize the feedback loop
+
+        inline void storeError( int channel, float error )
+        {
+            float* history = &_errors[ channel * 2 ];
+
+            history[ 1 ] = history[ 0 ];
+            history[ 0 ] = std::min( MAX_ERROR, std::max( -MAX_ERROR, error ));
+        }
+
+        // reduce the word length of given channel buffer to given amount of bits, this
+        // applies a rounding quantizer, dithered and noise shaped according to the current mode
+
+        template <typename SampleType>
+        void process( SampleType* channelBuffer, int bufferSize, int channel, int bits );
+
+    private:
+        static constexpr float MAX_ERROR = 2.f;
+
+        Mode _mode;
+        Random* _random;
+        std::vector<float> _noise;
+        std::vector<float> _errors; // two samples of history per channel
+};
+}
+
+#include "dither.tcc"
+
+#endif
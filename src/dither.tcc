@@ -0,0 +1,49 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include <algorithm>
+#include <math.h>
+
+namespace Igorski {
+
+template <typename SampleType>
+void Dither::process( SampleType* channelBuffer, int bufferSize, int channel, int bits )
+{
+    float scale    = ( float ) ( 1 << ( bits - 1 ));
+    float invScale = 1.f / scale;
+    float maxValue = scale - 1.f;
+
+    float* noise = ( _mode != OFF ) ? generate( bufferSize ) : nullptr;
+
+    for ( int i = 0; i < bufferSize; ++i )
+    {
+        float value     = ( float ) channelBuffer[ i ] * scale - getFeedback( channel );
+        float dithered  = ( noise != nullptr ) ? value + noise[ i ] : value;
+        float quantized = std::min( maxValue, std::max( -scale, floorf( dithered + .5f )));
+
+        storeError( channel, quantized - value );
+
+        channelBuffer[ i ] = ( SampleType ) ( quantized * invScale );
+    }
+}
+
+}
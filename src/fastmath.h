@@ -0,0 +1,206 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __FASTMATH_HEADER__
+#define __FASTMATH_HEADER__
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+/**
+ * fast approximations of transcendental functions for per-sample use
+ * (e.g. gain calculation in the dB domain). All functions are branchless and
+ * free of library calls, so the block variants auto-vectorize.
+ * The maximum errors listed are measured over the documented input range
+ * against the double precision libm implementation (see bench/fastmath.cpp).
+ */
+namespace Igorski {
+namespace Calc {
+
+    static constexpr float LOG2_10        = 3.32192809f;  // log2( 10 )
+    static constexpr float LOG2_E         = 1.44269504f;  // log2( e )
+    static constexpr float DB_TO_LOG2     = LOG2_10 / 20.f;
+    static constexpr float LOG2_TO_DB     = 20.f / LOG2_10;
+    static constexpr float MIN_LINEAR     = 1.0e-10f;     // -200 dB, floor for linearToDb
+    static constexpr float MAX_EXP2_INPUT = 126.f;
+    static constexpr int32_t SIGN_MASK    = INT32_MIN;
+
+    inline float asFloat( int32_t bits )
+    {
+        float value;
+        std::memcpy( &value, &bits, sizeof( float ));
+        return value;
+    }
+
+    inline int32_t asInt( float value )
+    {
+        int32_t bits;
+        std::memcpy( &bits, &value, sizeof( float ));
+        return bits;
+    }
+
+    /**
+     * 2 ^ value, the integer part is written into the exponent, the fractional
+     * part is approximated by a fifth order polynomial
+     * max relative error: 1.7e-7, input is clamped to the -126 to +126 range
+     */
+    inline float fastExp2( float value )
+    {
+        // clamp the magnitude on the float representation, a float select would leave
+        // a branch (with a constant result) in the loop, preventing auto-vectorization
+
+        int32_t bits = asInt( value );
+        value = asFloat(( bits & SIGN_MASK ) | std::min( bits & ~SIGN_MASK, asInt( MAX_EXP2_INPUT )));
+
+        int32_t integer = ( int32_t ) value;
+        integer -= (( float ) integer > value ) ? 1 : 0; // floor
+        float fraction  = value - ( float ) integer;
+
+        float p = 0.00187623295f;
+        p = p * fraction + 0.00899258403f;
+        p = p * fraction + 0.0558236045f;
+        p = p * fraction + 0.24015453f;
+        p = p * fraction + 0.693152968f;
+        p = p * fraction + 0.999999927f;
+
+        return p * asFloat(( integer + 127 ) << 23 );
+    }
+
+    /**
+     * log2( value ), the exponent is extracted from the float representation and
+     * log2 of the mantissa (1 - 2 range) is approximated by a sixth order polynomial
+     * max absolute error: 5.3e-6, value must be positive and normal
+     */
+    inline float fastLog2( float value )
+    {
+        int32_t bits     = asInt( value );
+        float exponent   = ( float ) ((( bits >> 23 ) & 255 ) - 127 );
+        float mantissa   = asFloat(( bits & 0x007FFFFF ) | 0x3F800000 ) - 1.f;
+
+        float p = 0.0204903461f;
+        p = p * mantissa - 0.0960662494f;
+        p = p * mantissa + 0.215588533f;
+        p = p * mantissa - 0.339247773f;
+        p = p * mantissa + 0.477705931f;
+        p = p * mantissa - 0.721162734f;
+        p = p * mantissa + 1.44269326f;
+
+        return exponent + p * mantissa;
+    }
+
+    /**
+     * decibels to linear gain
+     * max relative error: 2.4e-6 within the -200 to +200 dB range (dominated by
+     * the rounding of the scaled exponent, grows with the magnitude of dB)
+     */
+    inline float dbToLinear( float dB )
+    {
+        return fastExp2( dB * DB_TO_LOG2 );
+    }
+
+    /**
+     * linear gain to decibels, values below MIN_LINEAR (including silence
+     * and negative values) are floored to -200 dB
+     * max absolute error: 3e-5 dB within the -200 to +200 dB range, growing to 7e-5 dB
+     * towards the largest floats (dominated by the rounding of the result)
+     */
+    inline float linearToDb( float value )
+    {
+        // floored on the float representation (see fastExp2()), the representation of positive
+        // floats orders like their value while negative floats are negative integers
+
+        return fastLog2( asFloat( std::max( asInt( value ), asInt( MIN_LINEAR )))) * LOG2_TO_DB;
+    }
+
+    /**
+     * hyperbolic tangent as 1 - 2 / ( e^2x + 1 ), saturates to -1 and +1 beyond |x| = 43
+     * max absolute error: 2.4e-7
+     */
+    inline float fastTanh( float value )
+    {
+        return 1.f - 2.f / ( fastExp2( value * ( 2.f * LOG2_E )) + 1.f );
+    }
+
+    /**
+     * 1 / value through an initial estimate from the float representation followed by
+     * three Newton-Raphson iterations, |value| must be within the 1e-37 to 1e37 range
+     * max relative error: 2e-7
+     */
+    inline float fastReciprocal( float value )
+    {
+        float estimate = asFloat( 0x7EF311C7 - asInt( value ));
+
+        estimate = estimate * ( 2.f - value * estimate );
+        estimate = estimate * ( 2.f - value * estimate );
+        estimate = estimate * ( 2.f - value * estimate );
+
+        return estimate;
+    }
+
+    // block variants, these operate on contiguous buffers and can be used in-place
+
+    inline void fastExp2( const float* input, float* output, int size )
+    {
+        for ( int i = 0; i < size; ++i ) {
+            output[ i ] = fastExp2( input[ i ]);
+        }
+    }
+
+    inline void fastLog2( const float* input, float* output, int size )
+    {
+        for ( int i = 0; i < size; ++i ) {
+            output[ i ] = fastLog2( input[ i ]);
+        }
+    }
+
+    inline void dbToLinear( const float* input, float* output, int size )
+    {
+        for ( int i = 0; i < size; ++i ) {
+            output[ i ] = dbToLinear( input[ i ]);
+        }
+    }
+
+    inline void linearToDb( const float* input, float* output, int size )
+    {
+        for ( int i = 0; i < size; ++i ) {
+            output[ i ] = linearToDb( input[ i ]);
+        }
+    }
+
+    inline void fastTanh( const float* input, float* output, int size )
+    {
+        for ( int i = 0; i < size; ++i ) {
+            output[ i ] = fastTanh( input[ i ]);
+        }
+    }
+
+    inline void fastReciprocal( const float* input, float* output, int size )
+    {
+        for ( int i = 0; i < size; ++i ) {
+            output[ i ] = fastReciprocal( input[ i ]);
+        }
+    }
+}
+}
+
+#endif
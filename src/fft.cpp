@@ -0,0 +1,206 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "fft.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Igorski {
+
+/* constructor / destructor */
+
+FFT::FFT( int size )
+{
+    _size     = size;
+    _halfSize = size / 2;
+
+    int bits = 0;
+    while (( 1 << bits ) < _halfSize ) {
+        ++bits;
+    }
+
+    _bitReversal.resize( _halfSize );
+    for ( int i = 0; i < _halfSize; ++i ) {
+        int reversed = 0;
+        for ( int b = 0; b < bits; ++b ) {
+            reversed |= (( i >> b ) & 1 ) << ( bits - 1 - b );
+        }
+        _bitReversal[ i ] = reversed;
+    }
+
+    // twiddles for each stage of the complex transform, the stage with butterfly span
+    // "half" stores its twiddles at offset ( half - 1 ) (e.g. 1 + 2 + 4 + ... + halfSize / 2 values in total)
+
+    _twiddleReal.resize( std::max( 1, _halfSize - 1 ));
+    _twiddleImag.resize( std::max( 1, _halfSize - 1 ));
+
+    for ( int half = 1; half < _halfSize; half *= 2 ) {
+        for ( int j = 0; j < half; ++j ) {
+            double angle = -M_PI * j / half;
+            _twiddleReal[ half - 1 + j ] = ( float ) cos( angle );
+            _twiddleImag[ half - 1 + j ] = ( float ) sin( angle );
+        }
+    }
+
+    // twiddles to separate the spectra of the even and odd samples
+
+    _splitReal.resize( _halfSize + 1 );
+    _splitImag.resize( _halfSize + 1 );
+
+    for ( int k = 0; k <= _halfSize; ++k ) {
+        double angle = -2.0 * M_PI * k / _size;
+        _splitReal[ k ] = ( float ) cos( angle );
+        _splitImag[ k ] = ( float ) sin( angle );
+    }
+
+    _workReal.resize( _halfSize + 1 );
+    _workImag.resize( _halfSize + 1 );
+}
+
+FFT::~FFT()
+{
+    // nowt...
+}
+
+/* public methods */
+
+int FFT::getSize()
+{
+    return _size;
+}
+
+int FFT::getAmountOfBins()
+{
+    return _halfSize + 1;
+}
+
+void FFT::forward( const float* input, float* real, float* imag )
+{
+    float* zr = _workReal.data();
+    float* zi = _workImag.data();
+
+    // pack the even samples into the real, the odd samples into the imaginary part (in bit reversed order)
+
+    for ( int i = 0; i < _halfSize; ++i ) {
+        int index = _bitReversal[ i ];
+        zr[ index ] = input[ i * 2 ];
+        zi[ index ] = input[ i * 2 + 1 ];
+    }
+    transform( zr, zi, false );
+
+    // separate the spectra of the even (E) and odd (O) samples and combine them
+    // X[ k ] = E[ k ] + W^k * O[ k ], where E[ k ] = ( Z[ k ] + Z*[ N - k ] ) / 2 and O[ k ] = ( Z[ k ] - Z*[ N - k ] ) / 2i
+
+    zr[ _halfSize ] = zr[ 0 ];
+    zi[ _halfSize ] = zi[ 0 ];
+
+    for ( int k = 0; k <= _halfSize; ++k )
+    {
+        float ar = zr[ k ], ai = zi[ k ];
+        float br = zr[ _halfSize - k ], bi = -zi[ _halfSize - k ];
+
+        float evenReal = .5f * ( ar + br );
+        float evenImag = .5f * ( ai + bi );
+        float oddReal  = .5f * ( ai - bi );
+        float oddImag  = -.5f * ( ar - br );
+
+        real[ k ] = evenReal + _splitReal[ k ] * oddReal - _splitImag[ k ] * oddImag;
+        imag[ k ] = evenImag + _splitReal[ k ] * oddImag + _splitImag[ k ] * oddReal;
+    }
+}
+
+void FFT::inverse( const float* real, const float* imag, float* output )
+{
+    float* zr = _workReal.data();
+    float* zi = _workImag.data();
+
+    // the reverse of the separation in forward(): E[ k ] = ( X[ k ] + X*[ N/2 - k ] ) / 2
+    // and O[ k ] = ( X[ k ] - X*[ N/2 - k ] ) / 2 * W^-k, after which Z[ k ] = E[ k ] + i * O[ k ]
+
+    for ( int k = 0; k < _halfSize; ++k )
+    {
+        float ar = real[ k ], ai = imag[ k ];
+        float br = real[ _halfSize - k ], bi = -imag[ _halfSize - k ];
+
+        float evenReal = .5f * ( ar + br );
+        float evenImag = .5f * ( ai + bi );
+        float diffReal = .5f * ( ar - br );
+        float diffImag = .5f * ( ai - bi );
+
+        // multiply by the conjugate twiddle
+
+        float oddReal = diffReal * _splitReal[ k ] + diffImag * _splitImag[ k ];
+        float oddImag = diffImag * _splitReal[ k ] - diffReal * _splitImag[ k ];
+
+        int index = _bitReversal[ k ];
+        zr[ index ] = evenReal - oddImag;
+        zi[ index ] = evenImag + oddReal;
+    }
+    transform( zr, zi, true );
+
+    float scale = 1.f / _halfSize;
+
+    for ( int i = 0; i < _halfSize; ++i ) {
+        output[ i * 2 ]     = zr[ i ] * scale;
+        output[ i * 2 + 1 ] = zi[ i ] * scale;
+    }
+}
+
+/* private methods */
+
+void FFT::transform( float* real, float* imag, bool inverse )
+{
+    // iterative radix-2 decimation in time, the input is expected in bit reversed order
+    // the inverse transform uses the conjugate twiddles (and is left unscaled)
+
+    float sign = inverse ? -1.f : 1.f;
+
+    for ( int half = 1; half < _halfSize; half *= 2 )
+    {
+        const float* twiddleReal = &_twiddleReal[ half - 1 ];
+        const float* twiddleImag = &_twiddleImag[ half - 1 ];
+
+        for ( int start = 0; start < _halfSize; start += half * 2 )
+        {
+            float* ar = real + start;
+            float* ai = imag + start;
+            float* br = real + start + half;
+            float* bi = imag + start + half;
+
+            for ( int j = 0; j < half; ++j )
+            {
+                float wr = twiddleReal[ j ];
+                float wi = twiddleImag[ j ] * sign;
+
+                float tr = br[ j ] * wr - bi[ j ] * wi;
+                float ti = br[ j ] * wi + bi[ j ] * wr;
+
+                br[ j ] = ar[ j ] - tr;
+                bi[ j ] = ai[ j ] - ti;
+                ar[ j ] += tr;
+                ai[ j ] += ti;
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,85 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __FFT_H_INCLUDED__
+#define __FFT_H_INCLUDED__
+
+#include <vector>
+
+namespace Igorski {
+/**
+ * Real valued Fast Fourier Transform for power of two sizes.
+ *
+ * Spectra are stored in split (structure-of-arrays) format: separate arrays
+ * of ( size / 2 + 1 ) real and imaginary values, from DC up to and including Nyquist.
+ * This keeps the per-bin arithmetic of consumers (e.g. complex multiplication
+ * in the Convolver) contiguous so it can be vectorized.
+ *
+ * The real transform is computed through a complex transform of half the size
+ * (the even samples as the real, the odd samples as the imaginary part), all
+ * twiddle factors are calculated upon construction.
+ */
+class FFT
+{
+    public:
+        FFT( int size );
+        ~FFT();
+
+        int getSize();
+        int getAmountOfBins(); // size / 2 + 1
+
+        /**
+         * transform size samples of given input into the
+         * spectrum described by real and imag (each holding getAmountOfBins() values)
+         */
+        void forward( const float* input, float* real, float* imag );
+
+        /**
+         * transform given spectrum back into size samples of output
+         * the result is scaled by 1 / size, so forward() followed by inverse() is lossless
+         */
+        void inverse( const float* real, const float* imag, float* output );
+
+    private:
+        int _size;
+        int _halfSize;
+
+        std::vector<int> _bitReversal;
+
+        // twiddles for the complex transform of half the size, stored per stage (contiguous
+        // for each butterfly span) and the twiddles used to split/merge the real spectrum
+
+        std::vector<float> _twiddleReal;
+        std::vector<float> _twiddleImag;
+        std::vector<float> _splitReal;
+        std::vector<float> _splitImag;
+
+        // work buffers for the complex transform
+
+        std::vector<float> _workReal;
+        std::vector<float> _workImag;
+
+        void transform( float* real, float* imag, bool inverse );
+};
+}
+
+#endif
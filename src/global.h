@@ -20,6 +20,7 @@ namespace VST {
     static const FUID PluginControllerUID( 0x92700948, 0x0C47f4E8, 0xC6E40BB6, 0x717148FB );
 
     extern float SAMPLE_RATE; // set upon initialization, see vst.cpp
+    extern int BUFFER_SIZE;   // maximum amount of samples per process cycle, set upon initialization, see vst.cpp
 
     static const float PI     = 3.141592653589793f;
     static const float TWO_PI = PI * 2.f;
@@ -30,8 +31,19 @@ namespace VST {
     static const float MAX_LFO_RATE() { return 10.f; }
     static const float MIN_LFO_RATE() { return .1f; }
 
-    // sine waveform used for the oscillator
-    static const float TABLE[ 128 ] = { 0, 0.0490677, 0.0980171, 0.14673, 0.19509, 0.24298, 0.290285, 0.33689, 0.382683, 0.427555, 0.471397, 0.514103, 0.55557, 0.595699, 0.634393, 0.671559, 0.707107, 0.740951, 0.77301, 0.803208, 0.83147, 0.857729, 0.881921, 0.903989, 0.92388, 0.941544, 0.95694, 0.970031, 0.980785, 0.989177, 0.995185, 0.998795, 1, 0.998795, 0.995185, 0.989177, 0.980785, 0.970031, 0.95694, 0.941544, 0.92388, 0.903989, 0.881921, 0.857729, 0.83147, 0.803208, 0.77301, 0.740951, 0.707107, 0.671559, 0.634393, 0.595699, 0.55557, 0.514103, 0.471397, 0.427555, 0.382683, 0.33689, 0.290285, 0.24298, 0.19509, 0.14673, 0.0980171, 0.0490677, 1.22465e-16, -0.0490677, -0.0980171, -0.14673, -0.19509, -0.24298, -0.290285, -0.33689, -0.382683, -0.427555, -0.471397, -0.514103, -0.55557, -0.595699, -0.634393, -0.671559, -0.707107, -0.740951, -0.77301, -0.803208, -0.83147, -0.857729, -0.881921, -0.903989, -0.92388, -0.941544, -0.95694, -0.970031, -0.980785, -0.989177, -0.995185, -0.998795, -1, -0.998795, -0.995185, -0.989177, -0.980785, -0.970031, -0.95694, -0.941544, -0.92388, -0.903989, -0.881921, -0.857729, -0.83147, -0.803208, -0.77301, -0.740951, -0.707107, -0.671559, -0.634393, -0.595699, -0.55557, -0.514103, -0.471397, -0.427555, -0.382683, -0.33689, -0.290285, -0.24298, -0.19509, -0.14673, -0.0980171, -0.0490677 };
+    // size of the wave tables used by the oscillators (must be a power of two), see wavetable.h
+
+    static const int LFO_TABLE_SIZE = 1024;
+
+    // highest oversampling factor, processors that can run oversampled (see Oversampler)
+    // allocate their buffers for BUFFER_SIZE * MAX_OVERSAMPLING samples
+
+    static const int MAX_OVERSAMPLING = 8;
+
+    // highest amount of channels of the main bus (e.g. 7.1.4), processors are
+    // sized for the amount of channels of the negotiated bus arrangement
+
+    static const int MAX_CHANNELS = 12;
 }
 }
 
@@ -0,0 +1,296 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "halfbandfilter.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Igorski {
+
+/**
+ * Kaiser windowed (beta 8.96) half-band filters, 115 taps for the steep and 23 taps
+ * for the relaxed response. The minimum phase versions have been derived from
+ * the linear phase filters through the real cepstrum and share their magnitude response.
+ */
+static const float STEEP_LINEAR[] = {
+    5.30266198e-06f, 0.f, -1.6171849e-05f, 0.f, 3.55214179e-05f, 0.f,
+    -6.7066554e-05f, 0.f, 0.000115457493f, 0.f, -0.000186378587f, 0.f,
+    0.00028663993f, 0.f, -0.000424262835f, 0.f, 0.000608563772f, 0.f,
+    -0.000850245531f, 0.f, 0.00116151012f, 0.f, -0.00155621849f, 0.f,
+    0.00205013086f, 0.f, -0.00266128569f, 0.f, 0.00341059733f, 0.f,
+    -0.0043228101f, 0.f, 0.00542801246f, 0.f, -0.00676407432f, 0.f,
+    0.00838061608f, 0.f, -0.0103456415f, 0.f, 0.0127570089f, 0.f,
+    -0.0157632325f, 0.f, 0.0196036212f, 0.f, -0.0246923044f, 0.f,
+    0.0318143182f, 0.f, -0.0426578037f, 0.f, 0.0616231821f, 0.f,
+    -0.104868472f, 0.f, 0.317895472f, 0.5f, 0.317895472f, 0.f,
+    -0.104868472f, 0.f, 0.0616231821f, 0.f, -0.0426578037f, 0.f,
+    0.0318143182f, 0.f, -0.0246923044f, 0.f, 0.0196036212f, 0.f,
+    -0.0157632325f, 0.f, 0.0127570089f, 0.f, -0.0103456415f, 0.f,
+    0.00838061608f, 0.f, -0.00676407432f, 0.f, 0.00542801246f, 0.f,
+    -0.0043228101f, 0.f, 0.00341059733f, 0.f, -0.00266128569f, 0.f,
+    0.00205013086f, 0.f, -0.00155621849f, 0.f, 0.00116151012f, 0.f,
+    -0.000850245531f, 0.f, 0.000608563772f, 0.f, -0.000424262835f, 0.f,
+    0.00028663993f, 0.f, -0.000186378587f, 0.f, 0.000115457493f, 0.f,
+    -6.7066554e-05f, 0.f, 3.55214179e-05f, 0.f, -1.6171849e-05f, 0.f,
+    5.30266198e-06f
+};
+
+static const float STEEP_MINIMUM[] = {
+    0.00221178471f, 0.0188706312f, 0.077307649f, 0.196825057f, 0.334924042f, 0.372278512f,
+    0.215301946f, -0.0551524721f, -0.205372021f, -0.101470016f, 0.101097584f, 0.136097744f,
+    -0.0192902181f, -0.121925928f, -0.0293269623f, 0.0943868235f, 0.0539622083f, -0.0671263263f,
+    -0.0639381558f, 0.0443853177f, 0.0656417236f, -0.0267854948f, -0.062977761f, 0.0137311937f,
+    0.0582153946f, -0.00434252666f, -0.052631028f, -0.00221346272f, 0.0469197035f, 0.0066285287f,
+    -0.041442465f, -0.00944642816f, 0.0363712944f, 0.0110840145f, -0.0317729488f, -0.0118575031f,
+    0.0276571661f, 0.0120060816f, -0.0240041148f, -0.0117109064f, 0.0207799412f, 0.0111095952f,
+    -0.0179453883f, -0.0103070224f, 0.0154604763f, 0.00938324071f, -0.0132868998f, -0.00839927234f,
+    0.0113891521f, 0.0074013886f, -0.00973492768f, -0.00642436603f, 0.00829528552f, 0.00549415918f,
+    -0.00704602152f, -0.00462621311f, 0.00596163701f, 0.00383457798f, -0.00502360659f, -0.00312502473f,
+    0.00421366747f, 0.00250041531f, -0.00351605169f, -0.0019599006f, 0.00291782501f, 0.00150230818f,
+    -0.00240386743f, -0.00111920969f, 0.00196640543f, 0.000805728661f, -0.00159622706f, -0.000555737584f,
+    0.00128425669f, 0.000361727958f, -0.00102247915f, -0.000215594526f, 0.000804071256f, 0.000109305452f,
+    -0.000623234722f, -3.53244213e-05f, 0.000474965258f, -1.31516399e-05f, -0.000354859745f, 4.20820325e-05f,
+    0.000258979504f, -5.65565606e-05f, -0.000183755896f, 6.08109985e-05f, 0.000125941573f, -5.82789726e-05f,
+    -8.25843235e-05f, 5.16588225e-05f, 5.10220925e-05f, -4.29978427e-05f, -2.88808606e-05f, 3.37790152e-05f,
+    1.40751454e-05f, -2.50072171e-05f, -4.8111765e-06f, 1.72990476e-05f, -4.17843609e-07f, -1.09678012e-05f,
+    2.84289899e-06f, 6.10205825e-06f, -3.43675129e-06f, -2.63555012e-06f, 2.93215635e-06f, 4.20426318e-07f,
+    -1.85439603e-06f, 6.94556547e-07f, 5.91478965e-07f, -7.82916288e-07f, 4.03520175e-07f, -1.08451751e-07f,
+    1.26932438e-08f
+};
+
+static const float RELAXED_LINEAR[] = {
+    -2.74769518e-05f, 0.f, 0.0010477826f, 0.f, -0.00670826994f, 0.f,
+    0.0253879968f, 0.f, -0.0770674944f, 0.f, 0.307367474f, 0.5f,
+    0.307367474f, 0.f, -0.0770674944f, 0.f, 0.0253879968f, 0.f,
+    -0.00670826994f, 0.f, 0.0010477826f, 0.f, -2.74769518e-05f
+};
+
+static const float RELAXED_MINIMUM[] = {
+    0.0237449165f, 0.143268421f, 0.360960156f, 0.453293771f, 0.215988472f, -0.119280107f,
+    -0.158213362f, 0.0272065122f, 0.0844137743f, -0.006021454f, -0.0368623994f, 0.00279926532f,
+    0.0126026887f, -0.002045664f, -0.0030313069f, 0.00101187208f, 0.000384697836f, -0.000245300471f,
+    1.40778402e-05f, 1.28727925e-05f, -1.75075763e-06f, -1.91844251e-07f, 3.17964819e-08f
+};
+
+static const int STEEP_LENGTH   = sizeof( STEEP_LINEAR )   / sizeof( float );
+static const int RELAXED_LENGTH = sizeof( RELAXED_LINEAR ) / sizeof( float );
+
+/* constructor / destructor */
+
+HalfBandFilter::HalfBandFilter( Response response, Phase phase, int maxInputSize )
+{
+    _response = response;
+    _length   = ( response == STEEP ) ? STEEP_LENGTH : RELAXED_LENGTH;
+
+    // both branches operate on sequences prefixed by the history of the previous block
+
+    int evenLength = ( _length + 1 ) / 2;
+    _historySize   = evenLength - 1;
+
+    _evenCoefficients.resize( evenLength );
+    _oddCoefficients.resize ( _length / 2 );
+
+    _evenSequence.resize( _historySize + maxInputSize, 0.f );
+    _oddSequence.resize ( _historySize + maxInputSize, 0.f );
+    _evenOutput.resize( maxInputSize, 0.f );
+    _oddOutput.resize ( maxInputSize, 0.f );
+
+    setPhase( phase );
+}
+
+HalfBandFilter::~HalfBandFilter()
+{
+    // nowt...
+}
+
+/* public methods */
+
+HalfBandFilter::Phase HalfBandFilter::getPhase()
+{
+    return _phase;
+}
+
+void HalfBandFilter::setPhase( Phase phase )
+{
+    _phase = phase;
+
+    if ( _response == STEEP ) {
+        _coefficients = ( phase == LINEAR_PHASE ) ? STEEP_LINEAR : STEEP_MINIMUM;
+    } else {
+        _coefficients = ( phase == LINEAR_PHASE ) ? RELAXED_LINEAR : RELAXED_MINIMUM;
+    }
+    cacheCoefficients();
+    reset();
+}
+
+void HalfBandFilter::reset()
+{
+    std::fill( _evenSequence.begin(), _evenSequence.end(), 0.f );
+    std::fill( _oddSequence.begin(),  _oddSequence.end(),  0.f );
+    _lastInput = 0.f;
+}
+
+void HalfBandFilter::upsample( const float* input, float* output, int inputSize )
+{
+    // zero stuffing the input and filtering equals filtering the input with each
+    // branch separately, the even branch yields the even, the odd branch the odd output samples
+
+    float* sequence = &_evenSequence[ _historySize ];
+    std::memmove( sequence, input, inputSize * sizeof( float ));
+
+    convolve( sequence, _evenCoefficients, _evenOutput.data(), inputSize );
+
+    if ( _isHalfBand ) {
+        // the odd branch of a (linear phase) half-band filter is the center tap applied to the delayed input
+        const float* delayed = sequence - _center;
+        for ( int i = 0; i < inputSize; ++i ) {
+            _oddOutput[ i ] = delayed[ i ] * .5f;
+        }
+    } else {
+        convolve( sequence, _oddCoefficients, _oddOutput.data(), inputSize );
+    }
+
+    // the gain is doubled to compensate for the energy lost to the zero stuffed samples
+
+    for ( int i = 0; i < inputSize; ++i ) {
+        output[ i * 2 ]     = _evenOutput[ i ] * 2.f;
+        output[ i * 2 + 1 ] = _oddOutput [ i ] * 2.f;
+    }
+    storeHistory( _evenSequence, inputSize );
+}
+
+void HalfBandFilter::downsample( const float* input, float* output, int outputSize )
+{
+    // split the input into its even samples and the odd samples that precede them
+    // the odd branch has an additional sample of delay as it operates on ( 2n - 1 )
+
+    float* evenSequence = &_evenSequence[ _historySize ];
+    float* oddSequence  = &_oddSequence [ _historySize ];
+
+    oddSequence[ 0 ] = _lastInput;
+
+    for ( int i = 0; i < outputSize; ++i ) {
+        evenSequence[ i ] = input[ i * 2 ];
+    }
+    for ( int i = 1; i < outputSize; ++i ) {
+        oddSequence[ i ] = input[ i * 2 - 1 ];
+    }
+    _lastInput = input[ outputSize * 2 - 1 ];
+
+    convolve( evenSequence, _evenCoefficients, _evenOutput.data(), outputSize );
+
+    if ( _isHalfBand ) {
+        const float* delayed = oddSequence - _center;
+        for ( int i = 0; i < outputSize; ++i ) {
+            output[ i ] = _evenOutput[ i ] + delayed[ i ] * .5f;
+        }
+    } else {
+        convolve( oddSequence, _oddCoefficients, _oddOutput.data(), outputSize );
+        for ( int i = 0; i < outputSize; ++i ) {
+            output[ i ] = _evenOutput[ i ] + _oddOutput[ i ];
+        }
+    }
+    storeHistory( _evenSequence, outputSize );
+    storeHistory( _oddSequence,  outputSize );
+}
+
+float HalfBandFilter::getLatency()
+{
+    // the group delay at DC equals the "center of mass" of the impulse response
+
+    float weighted = 0.f;
+    float sum      = 0.f;
+
+    for ( int i = 0; i < _length; ++i ) {
+        weighted += i * _coefficients[ i ];
+        sum      += _coefficients[ i ];
+    }
+    return weighted / sum;
+}
+
+/* private methods */
+
+void HalfBandFilter::cacheCoefficients()
+{
+    // the coefficients are split into the even and odd polyphase branches
+
+    for ( size_t i = 0; i < _evenCoefficients.size(); ++i ) {
+        _evenCoefficients[ i ] = _coefficients[ i * 2 ];
+    }
+    for ( size_t i = 0; i < _oddCoefficients.size(); ++i ) {
+        _oddCoefficients[ i ] = _coefficients[ i * 2 + 1 ];
+    }
+
+    // a linear phase half-band filter has zero valued odd taps, except for the center tap (.5)
+
+    _isHalfBand = _phase == LINEAR_PHASE;
+    _center     = ( int ) _oddCoefficients.size() / 2;
+}
+
+void HalfBandFilter::convolve( const float* sequence, const std::vector<float>& coefficients, float* output, int size )
+{
+    // blocked FIR: TAPS_PER_PASS coefficients are accumulated in registers per output sample,
+    // so the output block is updated once per group of coefficients rather than once per coefficient
+
+    constexpr int TAPS_PER_PASS = 8;
+
+    const float* taps        = coefficients.data();
+    int amountOfCoefficients = ( int ) coefficients.size();
+    int k = 0;
+
+    std::fill( output, output + size, 0.f );
+
+    for ( ; k <= amountOfCoefficients - TAPS_PER_PASS; k += TAPS_PER_PASS )
+    {
+        const float* c       = taps + k;
+        const float* delayed = sequence - k;
+
+        for ( int i = 0; i < size; ++i ) {
+            float sum = 0.f;
+            for ( int t = 0; t < TAPS_PER_PASS; ++t ) {
+                sum += c[ t ] * delayed[ i - t ];
+            }
+            output[ i ] += sum;
+        }
+    }
+
+    // remaining coefficients
+
+    for ( ; k < amountOfCoefficients; ++k )
+    {
+        float coefficient    = taps[ k ];
+        const float* delayed = sequence - k;
+
+        for ( int i = 0; i < size; ++i ) {
+            output[ i ] += coefficient * delayed[ i ];
+        }
+    }
+}
+
+void HalfBandFilter::storeHistory( std::vector<float>& sequence, int size )
+{
+    // move the most recent samples to the start of the sequence for the next block
+
+    std::memmove( sequence.data(), sequence.data() + size, _historySize * sizeof( float ));
+}
+
+}
@@ -0,0 +1,113 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __HALFBANDFILTER_H_INCLUDED__
+#define __HALFBANDFILTER_H_INCLUDED__
+
+#include <vector>
+
+namespace Igorski {
+/**
+ * FIR half-band filter in polyphase form, used to double (upsample)
+ * or halve (downsample) the sampling rate of a mono signal. A single instance
+ * keeps the history for a single direction, channels require their own instance.
+ *
+ * The filters are evaluated branch by branch over the whole block (multiply-add
+ * of a group of coefficients across contiguous samples) which allows the compiler to vectorize
+ * the inner loops. Both up- and downsampling can be performed in-place.
+ */
+class HalfBandFilter
+{
+    public:
+
+        enum Phase {
+            LINEAR_PHASE = 0, // symmetrical impulse response (no phase distortion, higher latency)
+            MINIMUM_PHASE     // low latency, at the expense of phase distortion near Nyquist
+        };
+
+        // the transition band of the filter, STEEP is used when operating at the host rate (-88 dB beyond
+        // .55 of the input rate, ripple < .001 dB up to .45) while RELAXED suffices for subsequent
+        // stages of a cascade where the source material occupies a smaller fraction of the spectrum
+
+        enum Response {
+            STEEP = 0,
+            RELAXED
+        };
+
+        // maxInputSize describes the maximum amount of samples provided to a single
+        // upsample() call (or the maximum outputSize for a downsample() call)
+
+        HalfBandFilter( Response response, Phase phase, int maxInputSize );
+        ~HalfBandFilter();
+
+        Phase getPhase();
+        void setPhase( Phase phase ); // note this also clears the filter history
+
+        void reset();
+
+        /**
+         * write given inputSize samples at twice the rate into given output
+         * (output must be able to hold inputSize * 2 samples and can equal input)
+         */
+        void upsample( const float* input, float* output, int inputSize );
+
+        /**
+         * write given outputSize * 2 samples of input at half the rate into given output
+         * (output can equal input)
+         */
+        void downsample( const float* input, float* output, int outputSize );
+
+        // the delay (at DC) introduced by the filter, in samples at the higher rate
+
+        float getLatency();
+
+    private:
+        Response _response;
+        Phase _phase;
+
+        const float* _coefficients;
+        int _length;
+        int _center;       // for linear phase filters: the offset of the center tap within the odd branch
+        bool _isHalfBand;  // whether the odd branch consists solely of the center tap (linear phase)
+
+        std::vector<float> _evenCoefficients;
+        std::vector<float> _oddCoefficients;
+
+        // the sequences (prefixed by their history) the branches operate on
+
+        int _historySize;
+        std::vector<float> _evenSequence;
+        std::vector<float> _oddSequence;
+        float _lastInput; // the last odd sample of the previous downsample() call
+
+        // per-branch accumulators
+
+        std::vector<float> _evenOutput;
+        std::vector<float> _oddOutput;
+
+        void cacheCoefficients();
+        void convolve( const float* sequence, const std::vector<float>& coefficients, float* output, int size );
+        void storeHistory( std::vector<float>& sequence, int size );
+};
+}
+
+#endif
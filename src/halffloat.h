@@ -0,0 +1,140 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __HALFFLOAT_HEADER__
+#define __HALFFLOAT_HEADER__
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__F16C__)
+#include <immintrin.h>
+#endif
+
+/**
+ * conversion between 32-bit floats and IEEE 754 half precision (16-bit) floats, used as
+ * storage format for long-lived audio memory (see AudioBuffer::HALF) while all processing
+ * remains in float. Conversion rounds to nearest even and preserves subnormals, infinity and NaN
+ * (the precision of an 11-bit significand equals a noise floor of roughly -66 dB relative to the signal)
+ *
+ * When compiled with F16C support (e.g. -mf16c or -march=native) the block variants convert
+ * eight values per instruction, otherwise a portable bit manipulating implementation is used
+ */
+namespace Igorski {
+namespace Calc {
+
+    inline uint16_t floatToHalf( float value )
+    {
+        uint32_t bits;
+        std::memcpy( &bits, &value, sizeof( float ));
+
+        uint32_t sign = bits & 0x80000000u;
+        bits ^= sign;
+
+        uint16_t half;
+
+        if ( bits >= ( 127 + 16 ) << 23 ) {
+            // out of range becomes infinity, NaN remains (quiet) NaN
+            half = ( bits > 0x7F800000u ) ? 0x7E00 : 0x7C00;
+        }
+        else if ( bits < ( 113 << 23 )) {
+            // subnormal or zero, let the float addition do the rounding
+            const uint32_t magicBits = (( 127 - 15 ) + ( 23 - 10 ) + 1 ) << 23;
+            float magic, shifted;
+            std::memcpy( &magic, &magicBits, sizeof( float ));
+            std::memcpy( &shifted, &bits, sizeof( float ));
+            shifted += magic;
+            std::memcpy( &bits, &shifted, sizeof( float ));
+            half = ( uint16_t ) ( bits - magicBits );
+        }
+        else {
+            // normal value, rebias the exponent and round the mantissa to nearest even
+            uint32_t isOdd = ( bits >> 13 ) & 1;
+            bits += (( uint32_t ) ( 15 - 127 ) << 23 ) + 0xFFF + isOdd;
+            half = ( uint16_t ) ( bits >> 13 );
+        }
+        return half | ( uint16_t ) ( sign >> 16 );
+    }
+
+    inline float halfToFloat( uint16_t half )
+    {
+        const uint32_t shiftedExponent = 0x7C00u << 13;
+
+        uint32_t bits     = ( uint32_t ) ( half & 0x7FFF ) << 13;
+        uint32_t exponent = bits & shiftedExponent;
+        bits += ( 127 - 15 ) << 23;
+
+        if ( exponent == shiftedExponent ) {
+            bits += ( 128 - 16 ) << 23; // infinity or NaN
+        }
+        else if ( exponent == 0 ) {
+            // zero or subnormal, renormalize through float subtraction
+            const uint32_t magicBits = 113 << 23;
+            float magic, value;
+            bits += 1 << 23;
+            std::memcpy( &magic, &magicBits, sizeof( float ));
+            std::memcpy( &value, &bits, sizeof( float ));
+            value -= magic;
+            std::memcpy( &bits, &value, sizeof( float ));
+        }
+        bits |= ( uint32_t ) ( half & 0x8000 ) << 16;
+
+        float value;
+        std::memcpy( &value, &bits, sizeof( float ));
+        return value;
+    }
+
+    // convert length floats from input into halves in output
+
+    inline void floatsToHalves( const float* input, uint16_t* output, int length )
+    {
+        int i = 0;
+#if defined(__F16C__)
+        for ( ; i <= length - 8; i += 8 ) {
+            __m128i halves = _mm256_cvtps_ph( _mm256_loadu_ps( input + i ), _MM_FROUND_TO_NEAREST_INT );
+            _mm_storeu_si128(( __m128i* ) ( output + i ), halves );
+        }
+#endif
+        for ( ; i < length; ++i ) {
+            output[ i ] = floatToHalf( input[ i ]);
+        }
+    }
+
+    // convert length halves from input into floats in output
+
+    inline void halvesToFloats( const uint16_t* input, float* output, int length )
+    {
+        int i = 0;
+#if defined(__F16C__)
+        for ( ; i <= length - 8; i += 8 ) {
+            __m256 floats = _mm256_cvtph_ps( _mm_loadu_si128(( const __m128i* ) ( input + i )));
+            _mm256_storeu_ps( output + i, floats );
+        }
+#endif
+        for ( ; i < length; ++i ) {
+            output[ i ] = halfToFloat( input[ i ]);
+        }
+    }
+}
+}
+
+#endif
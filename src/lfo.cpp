@@ -21,12 +21,22 @@
  * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "lfo.h"
+#include <algorithm>
+#include <math.h>
 
 namespace Igorski {
 
 LFO::LFO() {
-    _rate        = VST::MIN_LFO_RATE();
-    _accumulator = 0.f;
+    _phase          = 0;
+    _phaseIncrement = 0;
+    _interpolation  = LINEAR;
+    _controlRate    = 1;
+    _controlCounter = 0;
+    _controlValue   = 0.f;
+    _controlIncrement = 0.f;
+
+    setWaveform( WaveTable::SINE );
+    setRate( VST::MIN_LFO_RATE() );
 }
 
 LFO::~LFO() {
@@ -43,18 +53,103 @@ float LFO::getRate()
 void LFO::setRate( float value )
 {
     _rate = value;
+
+    // only the increment changes, the phase carries over so rate changes are continuous
+    _phaseIncrement = ( uint32_t ) (( double ) _rate / VST::SAMPLE_RATE * PHASE_RANGE );
+}
+
+WaveTable::Waveform LFO::getWaveform()
+{
+    return _waveform;
+}
+
+void LFO::setWaveform( WaveTable::Waveform value )
+{
+    _waveform = value;
+    _table    = TABLES.get( value );
+}
+
+LFO::Interpolation LFO::getInterpolation()
+{
+    return _interpolation;
+}
+
+void LFO::setInterpolation( Interpolation value )
+{
+    _interpolation = value;
 }
 
 void LFO::setAccumulator( float value )
 {
-    _accumulator = value;
+    _phase = ( uint32_t ) (( double ) ( value - floor( value )) * PHASE_RANGE );
+
+    // restart control rate interpolation from the new position
+    _controlCounter = 0;
+    _controlValue   = read( _phase );
 }
 
-float LFO::getAccumulator()
+int LFO::getControlRate()
 {
-    return _accumulator;
+    return _controlRate;
 }
 
+void LFO::setControlRate( int samples )
+{
+    if ( samples == _controlRate )
+        return;
+
+    _controlRate    = std::max( 1, samples );
+    _controlCounter = 0;
+    _controlValue   = read( _phase );
+}
+
+void LFO::renderBlock( float* output, int bufferSize )
+{
+    if ( _controlRate == 1 )
+    {
+        // audio rate, the phase of each sample is derived from the block start
+        // (rather than accumulated) so there is no dependency between iterations
+
+        uint32_t phase     = _phase;
+        uint32_t increment = _phaseIncrement;
+
+        for ( int i = 0; i < bufferSize; ++i ) {
+            output[ i ] = read( phase + ( uint32_t ) i * increment );
+        }
+        _phase += ( uint32_t ) bufferSize * increment;
+
+        return;
+    }
+
+    // control rate, the accumulator is kept at the phase of the next control point
+    // and the output ramps linearly from the current value towards it
+
+    for ( int i = 0; i < bufferSize; )
+    {
+        if ( _controlCounter == 0 )
+        {
+            _phase += ( uint32_t ) _controlRate * _phaseIncrement;
+
+            _controlIncrement = ( read( _phase ) - _controlValue ) / ( float ) _controlRate;
+            _controlCounter   = _controlRate;
+        }
+
+        int run     = std::min( _controlCounter, bufferSize - i );
+        float value = _controlValue;
+        float incr  = _controlIncrement;
+
+        for ( int j = 0; j < run; ++j ) {
+            output[ i + j ] = value + incr * ( j + 1 );
+        }
+        _controlValue   += incr * run;
+        _controlCounter -= run;
+        i += run;
+    }
 }
 
+float LFO::getAccumulator()
+{
+    return ( float ) ( _phase / PHASE_RANGE );
+}
 
+}
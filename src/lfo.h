@@ -24,6 +24,8 @@
 #define __LFO_H_INCLUDED__
 
 #include "global.h"
+#include "wavetable.h"
+#include <stdint.h>
 
 namespace Igorski {
 class LFO {
@@ -32,46 +34,114 @@ class LFO {
         LFO();
         ~LFO();
 
+        enum Interpolation {
+            LINEAR = 0,
+            CUBIC
+        };
+
         float getRate();
         void setRate( float value );
 
+        WaveTable::Waveform getWaveform();
+        void setWaveform( WaveTable::Waveform value );
+
+        Interpolation getInterpolation();
+        void setInterpolation( Interpolation value );
+
         // accumulators are used to retrieve a sample from the wave table
         // in other words: track the progress of the oscillator against its range
+        // the accumulator is expressed as a normalized phase in the 0 - 1 range
 
         float getAccumulator();
         void setAccumulator( float offset );
 
+        // the control rate determines at which interval (in samples) renderBlock() evaluates
+        // the wave table, values in between are linearly interpolated. For modulation
+        // sources a rate of 16 or 32 samples is indistinguishable from audio rate evaluation
+        // a value of 1 renders each sample at audio rate
+
+        int getControlRate();
+        void setControlRate( int samples );
+
+        /**
+         * render the next bufferSize values of the oscillator into given output
+         * this advances the accumulator by bufferSize samples
+         */
+        void renderBlock( float* output, int bufferSize );
+
         /**
          * retrieve a value from the wave table for the current
          * accumulator position, this method also increments
-         * the accumulator and keeps it within bounds
+         * the accumulator (which wraps around by itself)
+         * note this is always evaluated at audio rate, when rendering
+         * multiple samples, prefer renderBlock()
          */
         inline float peek()
         {
-            // the wave table offset to read from
-            float SR_OVER_LENGTH = VST::SAMPLE_RATE / ( float ) TABLE_SIZE;
-            int readOffset = ( _accumulator == 0.f ) ? 0 : ( int ) ( _accumulator / SR_OVER_LENGTH );
-
-            // increment the accumulators read offset
-            _accumulator += _rate;
+            float value = read( _phase );
 
-            // keep the accumulator within the bounds of the sample frequency
-            if ( _accumulator > VST::SAMPLE_RATE )
-                _accumulator -= VST::SAMPLE_RATE;
+            // increment the accumulators read offset, overflow equals wrapping at the end of the cycle
+            _phase += _phaseIncrement;
 
-            // return the sample present at the calculated offset within the table
-            return VST::TABLE[ readOffset ];
+            return value;
         }
 
     private:
 
-        // see Igorski::VST::LFO_TABLE;
-        static const int TABLE_SIZE = 128;
+        // see Igorski::VST::LFO_TABLE_SIZE
+        typedef WaveTable::Bank<VST::LFO_TABLE_SIZE> Tables;
+
+        static constexpr Tables TABLES {};
+
+        static constexpr int FRACTION_BITS      = 32 - Tables::TABLE_SIZE_LOG;
+        static constexpr uint32_t FRACTION_MASK = ( 1u << FRACTION_BITS ) - 1;
+        static constexpr float FRACTION_SCALE   = 1.f / ( float ) ( 1u << FRACTION_BITS );
+        static constexpr double PHASE_RANGE     = 4294967296.0; // 2^32
 
         // used internally
 
         float _rate;
-        float _accumulator;   // is read offset in wave table buffer
+        uint32_t _phase;          // 32-bit fixed point phase, full range equals a single cycle
+        uint32_t _phaseIncrement; // phase advance per sample for the current rate
+
+        WaveTable::Waveform _waveform;
+        Interpolation _interpolation;
+        const float* _table;
+
+        // control rate evaluation
+
+        int _controlRate;
+        int _controlCounter; // samples remaining until the next control point
+        float _controlValue; // current (interpolated) output value
+        float _controlIncrement;
+
+        // retrieve the interpolated wave table value for given phase
+
+        inline float read( uint32_t phase )
+        {
+            // the upper bits of the phase accumulator are the wave table offset
+            // the lower bits the fractional position in between table entries
+
+            const float* table = _table + ( phase >> FRACTION_BITS );
+            float fraction     = ( float ) ( phase & FRACTION_MASK ) * FRACTION_SCALE;
+
+            if ( _interpolation == LINEAR ) {
+                return table[ 0 ] + ( table[ 1 ] - table[ 0 ] ) * fraction;
+            }
+
+            // 4-point, 3rd order Hermite (Catmull-Rom)
+
+            float ym1 = table[ -1 ];
+            float y0  = table[ 0 ];
+            float y1  = table[ 1 ];
+            float y2  = table[ 2 ];
+
+            float c1 = .5f * ( y1 - ym1 );
+            float c2 = ym1 - 2.5f * y0 + 2.f * y1 - .5f * y2;
+            float c3 = .5f * ( y2 - ym1 ) + 1.5f * ( y0 - y1 );
+
+            return (( c3 * fraction + c2 ) * fraction + c1 ) * fraction + y0;
+        }
 };
 }
 
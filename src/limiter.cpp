@@ -25,8 +25,11 @@
  */
 #include "limiter.h"
 #include "global.h"
+#include "fastmath.h"
 #include <math.h>
 
+using namespace Igorski;
+
 // constructors / destructor
 
 Limiter::Limiter()
@@ -64,6 +67,12 @@ void Limiter::setThreshold( float thresholdDb )
     recalculate();
 }
 
+void Limiter::setTrim( float value )
+{
+    pTrim = ( float ) value;
+    recalculate();
+}
+
 float Limiter::getLinearGR()
 {
     return gain > 1.f ? 1.f / gain : 1.f;
@@ -86,15 +95,17 @@ void Limiter::init( float attackMs, float releaseMs, float thresholdDb )
 
 void Limiter::recalculate()
 {
+    // all coefficients are powers of ten, calculated as 2 ^ ( x * log2( 10 ))
+
     if ( pKnee > 0.5 ) {
         // soft knee
-        thresh = ( float ) pow( 10.0, 1.f - ( 2.0 * pTresh ));
+        thresh = Calc::fastExp2(( 1.f - ( 2.f * pTresh )) * Calc::LOG2_10 );
     }
     else {
         // hard knee
-        thresh = ( float ) pow( 10.0, ( 2.0 * pTresh ) - 2.0 );
+        thresh = Calc::fastExp2((( 2.f * pTresh ) - 2.f ) * Calc::LOG2_10 );
     }
-    trim = ( float )( pow( 10.0, ( 2.0 * pTrim) - 1.f ));
-    att  = ( float )  pow( 10.0, -2.0 * pAttack );
-    rel  = ( float )  pow( 10.0, -2.0 - ( 3.0 * pRelease ));
-}
\ No newline at end of file
+    trim = Calc::fastExp2((( 2.f * pTrim ) - 1.f ) * Calc::LOG2_10 );
+    att  = Calc::fastExp2(( -2.f * pAttack ) * Calc::LOG2_10 );
+    rel  = Calc::fastExp2(( -2.f - ( 3.f * pRelease )) * Calc::LOG2_10 );
+}
@@ -27,6 +27,7 @@
 #define __LIMITER_H_INCLUDED__
 
 #include "audiobuffer.h"
+#include <algorithm>
 
 class Limiter
 {
@@ -35,12 +36,16 @@ class Limiter
         Limiter( float attackMs, float releaseMs, float thresholdDb );
         ~Limiter();
 
+        // when keyLevels is provided (the rectified level of a sidechain signal for each sample), the
+        // detector follows the key rather than the processed signal, e.g. the key ducks the signal
+
         template <typename SampleType>
-        void process( SampleType** outputBuffer, int bufferSize, int numOutChannels );
+        void process( SampleType** outputBuffer, int bufferSize, int numOutChannels, const float* keyLevels = nullptr );
 
         void setAttack( float attackMs );
         void setRelease( float releaseMs );
         void setThreshold( float thresholdDb );
+        void setTrim( float value );
 
         float getLinearGR();
 
@@ -24,7 +24,7 @@
  * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 template <typename SampleType>
-void Limiter::process( SampleType** outputBuffer, int bufferSize, int numOutChannels )
+void Limiter::process( SampleType** outputBuffer, int bufferSize, int numOutChannels, const float* keyLevels )
 {
 //    if ( gain > 0.9999f && outputBuffer->isSilent )
 //    {
@@ -45,6 +45,10 @@ void Limiter::process( SampleType** outputBuffer, int bufferSize, int numOutChan
     SampleType* leftBuffer  = outputBuffer[ 0 ];
     SampleType* rightBuffer = hasRight ? outputBuffer[ 1 ] : 0;
 
+    // the key level is scaled to match the detector of the (summed) channels
+
+    SampleType keyScale = hasRight ? 2 : 1;
+
     if ( pKnee > 0.5 )
     {
         // soft knee
@@ -54,7 +58,7 @@ void Limiter::process( SampleType** outputBuffer, int bufferSize, int numOutChan
             ol  = leftBuffer[ i ];
             or_ = hasRight ? rightBuffer[ i ] : 0;
 
-            lev = ( SampleType ) ( 1.f / ( 1.f + th * fabs( ol + or_ )));
+            lev = ( SampleType ) ( 1.f / ( 1.f + th * ( keyLevels ? keyLevels[ i ] * keyScale : fabs( ol + or_ ))));
 
             if ( g > lev ) {
                 g = g - at * ( g - lev );
@@ -67,6 +71,10 @@ void Limiter::process( SampleType** outputBuffer, int bufferSize, int numOutChan
 
             if ( hasRight )
                 rightBuffer[ i ] = ( or_ * tr * g );
+
+            // multichannel layouts apply the gain of the (first two channels or key) detector to all channels
+            for ( int c = 2; c < numOutChannels; ++c )
+                outputBuffer[ c ][ i ] *= tr * g;
         }
     }
     else
@@ -76,10 +84,12 @@ void Limiter::process( SampleType** outputBuffer, int bufferSize, int numOutChan
             ol  = leftBuffer[ i ];
             or_ = hasRight ? rightBuffer[ i ] : 0;
 
-            lev = ( SampleType ) ( 0.5 * g * fabs( ol + or_ ));
+            lev = ( SampleType ) ( 0.5 * g * ( keyLevels ? keyLevels[ i ] * keyScale : fabs( ol + or_ )));
 
             if ( lev > th ) {
-                g = g - ( at * ( lev - th ));
+                // a hot detector (e.g. a sidechain exceeding 0 dBFS) would drive the gain negative (inverting
+                // the polarity) and beyond, the gain is floored at silence (the release never exceeds unity)
+                g = std::max(( SampleType ) 0, g - ( at * ( lev - th )));
             }
             else {
                 // below threshold
@@ -90,6 +100,10 @@ void Limiter::process( SampleType** outputBuffer, int bufferSize, int numOutChan
 
             if ( hasRight )
                 rightBuffer[ i ] = ( or_ * tr * g );
+
+            // multichannel layouts apply the gain of the (first two channels or key) detector to all channels
+            for ( int c = 2; c < numOutChannels; ++c )
+                outputBuffer[ c ][ i ] *= tr * g;
         }
     }
     gain = g;
@@ -0,0 +1,227 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "modulationmatrix.h"
+#include "global.h"
+#include "calc.h"
+#include <algorithm>
+#include <math.h>
+
+namespace Igorski {
+
+/* constructor */
+
+ModulationMatrix::ModulationMatrix()
+{
+    for ( int i = 0; i < AMOUNT_OF_LFOS; ++i ) {
+        _lfos[ i ] = new LFO();
+        _lfos[ i ]->setControlRate( 16 );
+    }
+    _sequencer = new StepSequencer();
+    _amountOfRetriggers = 0;
+
+    for ( int i = 0; i < AMOUNT_OF_FOLLOWERS; ++i ) {
+        _envelope[ i ] = 0.f;
+        setEnvelope( i, 10.f, 250.f );
+    }
+
+    for ( int i = 0; i < MAX_ROUTES; ++i ) {
+        _routes[ i ] = { 0, -1, 0.f };
+    }
+    cacheDestinations();
+
+    _stride = 0;
+    allocate( VST::BUFFER_SIZE );
+}
+
+ModulationMatrix::~ModulationMatrix()
+{
+    for ( int i = 0; i < AMOUNT_OF_LFOS; ++i ) {
+        delete _lfos[ i ];
+    }
+    delete _sequencer;
+}
+
+/* public methods */
+
+LFO* ModulationMatrix::getLFO( int index )
+{
+    return _lfos[ index ];
+}
+
+StepSequencer* ModulationMatrix::getSequencer()
+{
+    return _sequencer;
+}
+
+void ModulationMatrix::setEnvelope( int index, float attackMs, float releaseMs )
+{
+    // one-pole coefficients for the given time constants
+
+    _attack [ index ] = 1.f - expf( -1.f / std::max( 1.f, ( float ) Calc::millisecondsToBuffer( attackMs )));
+    _release[ index ] = 1.f - expf( -1.f / std::max( 1.f, ( float ) Calc::millisecondsToBuffer( releaseMs )));
+}
+
+void ModulationMatrix::setRoute( int slot, Source source, int destination, float depth )
+{
+    if ( depth == 0.f || destination < 0 || destination >= kAmountOfParams ) {
+        clearRoute( slot );
+        return;
+    }
+    _routes[ slot ] = { source, destination, depth };
+    cacheDestinations();
+}
+
+void ModulationMatrix::clearRoute( int slot )
+{
+    _routes[ slot ] = { 0, -1, 0.f };
+    cacheDestinations();
+}
+
+void ModulationMatrix::process( AudioBuffer* input, int bufferSize, const float* keyLevels )
+{
+    if ( bufferSize > _stride ) {
+        allocate( bufferSize ); // should not happen as host honours maxSamplesPerBlock
+    }
+
+    // 1. LFOs, rendered in segments when their phase is retriggered within this cycle
+
+    int offset = 0;
+    for ( int r = 0; r <= _amountOfRetriggers; ++r )
+    {
+        int segmentEnd = ( r < _amountOfRetriggers ) ? std::min( bufferSize, _retriggerOffsets[ r ]) : bufferSize;
+        if ( segmentEnd > offset ) {
+            for ( int l = 0; l < AMOUNT_OF_LFOS; ++l ) {
+                _lfos[ l ]->renderBlock( getSourceRow( LFO_1 + l ) + offset, segmentEnd - offset );
+            }
+            offset = segmentEnd;
+        }
+        if ( r < _amountOfRetriggers ) {
+            for ( int l = 0; l < AMOUNT_OF_LFOS; ++l ) {
+                _lfos[ l ]->setAccumulator( 0.f );
+            }
+        }
+    }
+    _amountOfRetriggers = 0;
+
+    // 2. step sequencer
+
+    _sequencer->renderBlock( getSourceRow( SEQUENCER ), bufferSize );
+
+    // 3. envelope followers, first rectify the input (peak across all channels)
+
+    float* peak = _peakLevels.data();
+    std::fill( peak, peak + bufferSize, 0.f );
+
+    for ( int c = 0; c < input->amountOfChannels; ++c )
+    {
+        float* channelBuffer = input->getBufferForChannel( c );
+        for ( int i = 0; i < bufferSize; ++i ) {
+            peak[ i ] = std::max( peak[ i ], fabsf( channelBuffer[ i ] ));
+        }
+    }
+
+    // the followers run side by side, one lane per follower
+
+    float* envelopes[ AMOUNT_OF_FOLLOWERS ];
+    const float* levels[ AMOUNT_OF_FOLLOWERS ];
+    for ( int f = 0; f < AMOUNT_OF_FOLLOWERS; ++f ) {
+        envelopes[ f ] = getSourceRow( ENVELOPE_1 + f );
+        levels[ f ]    = peak;
+    }
+    levels[ SIDECHAIN_FOLLOWER ] = keyLevels != nullptr ? keyLevels : _silence.data();
+
+    for ( int i = 0; i < bufferSize; ++i )
+    {
+        for ( int f = 0; f < AMOUNT_OF_FOLLOWERS; ++f )
+        {
+            float level       = std::min( 1.f, levels[ f ][ i ]);
+            float coefficient = ( level > _envelope[ f ]) ? _attack[ f ] : _release[ f ];
+            _envelope[ f ] += coefficient * ( level - _envelope[ f ]);
+            envelopes[ f ][ i ] = _envelope[ f ];
+        }
+    }
+
+    // 4. sum the routed sources into the destination vectors
+
+    for ( int row = 0; row < _amountOfDestinationRows; ++row ) {
+        std::fill( &_destinations[ row * _stride ], &_destinations[ row * _stride ] + bufferSize, 0.f );
+    }
+
+    for ( int r = 0; r < MAX_ROUTES; ++r )
+    {
+        const Route& route = _routes[ r ];
+        if ( route.destination < 0 )
+            continue;
+
+        float* source      = getSourceRow( route.source );
+        float* destination = getDestinationRow( route.destination );
+        float depth        = route.depth;
+
+        for ( int i = 0; i < bufferSize; ++i ) {
+            destination[ i ] += source[ i ] * depth;
+        }
+    }
+}
+
+void ModulationMatrix::retrigger( int sampleOffset )
+{
+    if ( _amountOfRetriggers < MAX_RETRIGGERS ) {
+        _retriggerOffsets[ _amountOfRetriggers++ ] = std::max( 0, sampleOffset );
+    }
+    _sequencer->retrigger( sampleOffset );
+}
+
+const float* ModulationMatrix::getModulation( int destination )
+{
+    return _destinationRows[ destination ] >= 0 ? getDestinationRow( destination ) : nullptr;
+}
+
+/* private methods */
+
+void ModulationMatrix::allocate( int bufferSize )
+{
+    _stride = bufferSize;
+
+    _sources.resize     ( AMOUNT_OF_SOURCES * _stride, 0.f );
+    _destinations.resize( MAX_ROUTES * _stride, 0.f );
+    _peakLevels.resize  ( _stride, 0.f );
+    _silence.resize     ( _stride, 0.f );
+}
+
+void ModulationMatrix::cacheDestinations()
+{
+    // assign a row of the destination block to each routed destination (routes sharing
+    // a destination share its row), as there are MAX_ROUTES rows, a row is always available
+
+    std::fill( _destinationRows, _destinationRows + kAmountOfParams, -1 );
+    _amountOfDestinationRows = 0;
+
+    for ( int r = 0; r < MAX_ROUTES; ++r ) {
+        int destination = _routes[ r ].destination;
+        if ( destination >= 0 && _destinationRows[ destination ] < 0 ) {
+            _destinationRows[ destination ] = _amountOfDestinationRows++;
+        }
+    }
+}
+
+}
@@ -0,0 +1,142 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __MODULATIONMATRIX_H_INCLUDED__
+#define __MODULATIONMATRIX_H_INCLUDED__
+
+#include "audiobuffer.h"
+#include "lfo.h"
+#include "stepsequencer.h"
+#include "paramids.h"
+#include <vector>
+
+namespace Igorski {
+
+/**
+ * ModulationMatrix routes modulation sources (LFOs, envelope followers and a step sequencer) onto
+ * parameters (see paramids.h). All sources are evaluated together once per process
+ * cycle, after which each routed parameter has a control vector of bufferSize
+ * values holding its modulation offset (in normalized parameter units)
+ *
+ * Sources are stored as consecutive rows of a single block (structure of arrays),
+ * so routing is a multiply-add of whole rows rather than per-sample calls per route.
+ * As no more than MAX_ROUTES destinations can be routed at once, the destination block
+ * only holds MAX_ROUTES rows, which are assigned to the routed destinations on routing
+ */
+class ModulationMatrix
+{
+    public:
+        static constexpr int AMOUNT_OF_LFOS      = 2;
+        static constexpr int AMOUNT_OF_FOLLOWERS = 2;
+        static constexpr int MAX_ROUTES          = 8;
+        static constexpr int MAX_RETRIGGERS      = StepSequencer::MAX_RETRIGGERS; // per process cycle
+
+        // the envelope follower that tracks the sidechain (when provided, see process())
+
+        static constexpr int SIDECHAIN_FOLLOWER  = 1;
+
+        enum Source {
+            LFO_1 = 0,
+            LFO_2,
+            ENVELOPE_1,
+            ENVELOPE_2,
+            SEQUENCER,
+            AMOUNT_OF_SOURCES
+        };
+
+        ModulationMatrix();
+        ~ModulationMatrix();
+
+        // LFO sources are bipolar (-1 to +1 range)
+
+        LFO* getLFO( int index );
+
+        // envelope follower sources are unipolar (0 to +1 range)
+
+        void setEnvelope( int index, float attackMs, float releaseMs );
+
+        // the step sequencer source is bipolar (-1 to +1 range)
+
+        StepSequencer* getSequencer();
+
+        // route given source onto given destination (ParamID) with given depth
+        // (-1 to +1 range), a depth of 0 clears the route in given slot
+
+        void setRoute( int slot, Source source, int destination, float depth );
+        void clearRoute( int slot );
+
+        // evaluate all sources and routes for the next process cycle
+        // the envelope followers track the peak level across the channels of given input, except for
+        // the SIDECHAIN_FOLLOWER which tracks keyLevels (the peak level of the sidechain for each sample)
+        // and falls silent when no sidechain is provided
+
+        void process( AudioBuffer* input, int bufferSize, const float* keyLevels = nullptr );
+
+        // restart the LFO phases and the step sequencer pattern at given sample offset within
+        // the next process cycle, retriggers are to be scheduled in ascending order of offset
+
+        void retrigger( int sampleOffset );
+
+        // retrieve the control vector for given destination (ParamID) for the current process
+        // cycle, returns nullptr when no source is routed to the destination
+
+        const float* getModulation( int destination );
+
+    private:
+        struct Route {
+            int source;
+            int destination;
+            float depth;
+        };
+
+        Route _routes[ MAX_ROUTES ];
+        int _destinationRows[ kAmountOfParams ]; // row index within the destination block, -1 when not routed
+        int _amountOfDestinationRows;
+
+        int _stride; // length of a single row within the source and destination blocks
+
+        std::vector<float> _sources;      // AMOUNT_OF_SOURCES rows
+        std::vector<float> _destinations; // MAX_ROUTES rows
+        std::vector<float> _peakLevels;   // rectified input level
+        std::vector<float> _silence;      // key level when no sidechain is provided
+
+        LFO* _lfos[ AMOUNT_OF_LFOS ];
+        StepSequencer* _sequencer;
+
+        int _retriggerOffsets[ MAX_RETRIGGERS ];
+        int _amountOfRetriggers;
+
+        // envelope follower state, one lane per follower
+
+        float _attack  [ AMOUNT_OF_FOLLOWERS ];
+        float _release [ AMOUNT_OF_FOLLOWERS ];
+        float _envelope[ AMOUNT_OF_FOLLOWERS ];
+
+        void allocate( int bufferSize );
+        void cacheDestinations();
+
+        inline float* getSourceRow( int source ) { return &_sources[ source * _stride ]; }
+        inline float* getDestinationRow( int destination ) { return &_destinations[ _destinationRows[ destination ] * _stride ]; }
+};
+}
+
+#endif
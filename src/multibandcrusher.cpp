@@ -0,0 +1,579 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "multibandcrusher.h"
+#include "bitcrusher.h"
+#include "calc.h"
+#include "global.h"
+#include <algorithm>
+#include <math.h>
+
+namespace Igorski {
+
+/* constructor / destructor */
+
+MultibandCrusher::MultibandCrusher( float inputMix, float outputMix, int amountOfChannels, int maxBufferSize )
+{
+    _amountOfChannels = amountOfChannels;
+    _amountOfBands    = 0;
+    _amountOfGroups   = ( amountOfChannels * Crossover::MAX_BANDS + LANES - 1 ) / LANES;
+
+    lfo = new LFO();
+    lfo->setControlRate( LFO_CONTROL_RATE );
+    hasLFO    = false;
+    _lfoDepth = 0.f;
+    _rateRatio = 1.f;
+
+    _random = new Random( 0x2545F491 );
+
+    _ditherMode   = Dither::OFF;
+    _antiAliasing = false;
+
+    setInputMix ( inputMix );
+    setOutputMix( outputMix );
+    setDecimationLFO( 0.f );
+    setModulation( nullptr, nullptr, 0 );
+
+    for ( int b = 0; b < Crossover::MAX_BANDS; ++b ) {
+        setAmount( b, 1.f );
+        setDecimation( b, 0.f );
+        _steps[ b ] = _targetSteps[ b ];
+    }
+
+    int amountOfLanes = _amountOfGroups * LANES;
+
+    _heldSamples.resize   ( amountOfLanes, 0.f );
+    _holdRemaining.resize ( amountOfLanes, 0.f );
+    _previousInputs.resize( amountOfLanes, 0.f );
+    _errors.resize        ( amountOfLanes * 2, 0.f );
+
+    _lfoBuffer.resize    ( maxBufferSize, 0.f );
+    _frames.resize       ( CONTROL_BLOCK_SIZE * LANES, 0.f );
+    _noise.resize        ( CONTROL_BLOCK_SIZE * LANES, 0.f );
+    _stepFrames.resize   ( CONTROL_BLOCK_SIZE * LANES, 0.f );
+    _inverseFrames.resize( CONTROL_BLOCK_SIZE * LANES, 0.f );
+    _stepStride = LANES;
+    _silence.resize      ( CONTROL_BLOCK_SIZE, 0.f );
+    _lanes.resize        ( amountOfLanes, nullptr );
+}
+
+MultibandCrusher::~MultibandCrusher()
+{
+    delete lfo;
+    delete _random;
+}
+
+/* public methods */
+
+void MultibandCrusher::setAmount( int band, float value )
+{
+    if ( band < 0 || band >= Crossover::MAX_BANDS ) {
+        return;
+    }
+    _amounts[ band ] = Calc::cap( value );
+
+    // the quantization step for the -1 to +1 range (e.g. 2 / 2^bits, see BitCrusher::calcBits())
+    _targetSteps[ band ] = exp2f( -Calc::scale( _amounts[ band ], 1, 15 ));
+}
+
+void MultibandCrusher::setDecimation( int band, float value )
+{
+    if ( band < 0 || band >= Crossover::MAX_BANDS ) {
+        return;
+    }
+    _decimations[ band ] = Calc::cap( value );
+    _holdPeriods[ band ] = getHoldPeriod( _decimations[ band ]);
+}
+
+void MultibandCrusher::setInputMix( float value )
+{
+    _inputMix = Calc::cap( value );
+}
+
+void MultibandCrusher::setOutputMix( float value )
+{
+    _outputMix = Calc::cap( value );
+}
+
+void MultibandCrusher::setLFO( float LFORatePercentage, float LFODepth )
+{
+    hasLFO    = LFORatePercentage > 0.f;
+    _lfoDepth = LFODepth;
+
+    if ( hasLFO ) {
+        lfo->setRate((
+            VST::MIN_LFO_RATE() + (
+                LFORatePercentage * ( VST::MAX_LFO_RATE() - VST::MIN_LFO_RATE() )
+            )
+        ) / _rateRatio );
+    }
+}
+
+void MultibandCrusher::setDecimationLFO( float LFODepth )
+{
+    _decimationLfoDepth = Calc::cap( LFODepth );
+}
+
+void MultibandCrusher::setDither( Dither::Mode mode )
+{
+    if ( mode != _ditherMode ) {
+        // flush the error history so no stale error is shaped into the new mode
+        std::fill( _errors.begin(), _errors.end(), 0.f );
+    }
+    _ditherMode = mode;
+}
+
+void MultibandCrusher::setAntiAliasing( bool enabled )
+{
+    if ( enabled && !_antiAliasing ) {
+        std::fill( _previousInputs.begin(), _previousInputs.end(), 0.f );
+    }
+    _antiAliasing = enabled;
+}
+
+void MultibandCrusher::setModulation( const float* amountModulation, const float* decimationModulation, int modulationSize )
+{
+    _amountModulation     = amountModulation;
+    _decimationModulation = decimationModulation;
+    _modulationSize       = modulationSize;
+}
+
+void MultibandCrusher::setProcessingRate( float ratio )
+{
+    if ( ratio == _rateRatio ) {
+        return;
+    }
+
+    // the LFO rate and hold periods are expressed in samples, scale them to the new rate
+
+    lfo->setRate( lfo->getRate() * _rateRatio / ratio );
+    _rateRatio = ratio;
+
+    for ( int b = 0; b < Crossover::MAX_BANDS; ++b ) {
+        _holdPeriods[ b ] = getHoldPeriod( _decimations[ b ]);
+    }
+}
+
+void MultibandCrusher::process( Crossover* crossover, int bufferSize )
+{
+    int amountOfBands = crossover->getAmountOfBands();
+
+    if ( amountOfBands != _amountOfBands ) {
+        // the lane assignment changes, the state of the previous assignment is meaningless
+        _amountOfBands = amountOfBands;
+        resetState();
+    }
+
+    bool isModulated   = hasLFO || _amountModulation != nullptr;
+    bool hasCrush      = false;
+    bool hasDecimation = _decimationModulation != nullptr;
+
+    for ( int b = 0; b < _amountOfBands; ++b ) {
+        hasCrush      = hasCrush || isCrushing( b ) || _steps[ b ] != _targetSteps[ b ];
+        hasDecimation = hasDecimation || _holdPeriods[ b ] > 1.f;
+    }
+
+    // sound should not be crushed ? do nothing
+    if ( !hasCrush && !hasDecimation ) {
+        return;
+    }
+
+    bufferSize = std::min( bufferSize, ( int ) _lfoBuffer.size() ); // host honours maxSamplesPerBlock
+
+    if ( hasLFO ) {
+        lfo->renderBlock( _lfoBuffer.data(), bufferSize );
+
+        // multiply by .5 and add .5 to make the LFO's bipolar waveform unipolar
+        for ( int i = 0; i < bufferSize; ++i ) {
+            _lfoBuffer[ i ] = _lfoBuffer[ i ] * .5f + .5f;
+        }
+    }
+
+    // collect the band buffers in lane order (see Crossover)
+
+    int amountOfChannels = std::min( _amountOfChannels, crossover->getBand( 0 )->amountOfChannels );
+    int amountOfLanes    = 0;
+
+    for ( int c = 0; c < amountOfChannels; ++c ) {
+        for ( int b = 0; b < _amountOfBands; ++b ) {
+            _lanes[ amountOfLanes++ ] = crossover->getBand( b )->getBufferForChannel( c );
+        }
+    }
+
+    bool hasDecimationLFO = hasLFO && _decimationLfoDepth > 0.f;
+    float* frames = _frames.data();
+
+    for ( int offset = 0; offset < bufferSize; offset += CONTROL_BLOCK_SIZE )
+    {
+        int blockSize = std::min( CONTROL_BLOCK_SIZE, bufferSize - offset );
+
+        // evaluate the band parameters at the end of the control block, the quantization
+        // step moves linearly towards its target across the block
+
+        int index        = offset + blockSize - 1;
+        int hostIndex    = getModulationIndex( index ); // modulation is provided at the host rate
+        float lfoValue   = hasLFO ? _lfoBuffer[ index ] : 0.f;
+
+        float stepStarts[ Crossover::MAX_BANDS ];
+        float stepIncrements[ Crossover::MAX_BANDS ];
+        float crushing[ Crossover::MAX_BANDS ];
+        float periods[ Crossover::MAX_BANDS ];
+
+        for ( int b = 0; b < _amountOfBands; ++b )
+        {
+            float target = isModulated ? exp2f( -Calc::scale( getBandAmount( b, lfoValue, hostIndex ), 1, 15 )) : _targetSteps[ b ];
+
+            stepStarts[ b ]     = _steps[ b ];
+            stepIncrements[ b ] = ( target - _steps[ b ]) / ( float ) blockSize;
+            crushing[ b ]       = ( isCrushing( b ) || _steps[ b ] != target ) ? 1.f : 0.f;
+            _steps[ b ]         = target;
+
+            float period = ( _decimationModulation != nullptr ) ?
+                getHoldPeriod( Calc::cap( _decimations[ b ] + _decimationModulation[ hostIndex ])) : _holdPeriods[ b ];
+
+            // the LFO shortens the hold period towards the unreduced rate
+            if ( hasDecimationLFO ) {
+                period -= ( period - 1.f ) * _decimationLfoDepth * lfoValue;
+            }
+            periods[ b ] = period;
+        }
+
+        for ( int g = 0; g < _amountOfGroups; ++g )
+        {
+            int firstLane = g * LANES;
+            int lanes     = std::min( LANES, amountOfLanes - firstLane );
+
+            if ( lanes <= 0 ) {
+                break;
+            }
+
+            // the parameters and buffers of each lane, unused lanes pass the silence
+            // of a scratch buffer unchanged (e.g. the scratch buffer remains silent)
+
+            Lanes laneStarts, laneIncrements, laneCrushing, lanePeriods;
+            float* laneBuffers[ LANES ];
+
+            for ( int l = 0; l < LANES; ++l ) {
+                int band = ( firstLane + l ) % _amountOfBands;
+                bool isUsed = l < lanes;
+
+                laneStarts.values[ l ]     = isUsed ? stepStarts[ band ]     : 1.f;
+                laneIncrements.values[ l ] = isUsed ? stepIncrements[ band ] : 0.f;
+                laneCrushing.values[ l ]   = isUsed ? crushing[ band ]       : 0.f;
+                lanePeriods.values[ l ]    = isUsed ? periods[ band ]        : 1.f;
+                laneBuffers[ l ]           = isUsed ? _lanes[ firstLane + l ] + offset : _silence.data();
+            }
+
+            // interleave the lanes into frames
+
+            for ( int i = 0; i < blockSize; ++i ) {
+                float* frame = frames + i * LANES;
+                for ( int l = 0; l < LANES; ++l ) {
+                    frame[ l ] = laneBuffers[ l ][ i ];
+                }
+            }
+
+            if ( hasCrush ) {
+                prepareSteps( laneStarts, laneIncrements, blockSize );
+
+                if ( hasDecimation ) {
+                    crushGroup<true>( firstLane, laneCrushing, lanePeriods, blockSize );
+                } else {
+                    crushGroup<false>( firstLane, laneCrushing, lanePeriods, blockSize );
+                }
+            } else {
+                decimate( firstLane, lanePeriods, blockSize );
+            }
+
+            for ( int i = 0; i < blockSize; ++i ) {
+                const float* frame = frames + i * LANES;
+                for ( int l = 0; l < LANES; ++l ) {
+                    laneBuffers[ l ][ i ] = frame[ l ];
+                }
+            }
+        }
+    }
+}
+
+/* private methods */
+
+bool MultibandCrusher::isCrushing( int band )
+{
+    return _amounts[ band ] < 1.f || hasLFO || _amountModulation != nullptr;
+}
+
+float MultibandCrusher::getBandAmount( int band, float lfoValue, int index )
+{
+    float amount = _amounts[ band ];
+
+    if ( hasLFO ) {
+        // the LFO moves the resolution within a range relative to the bands resolution (see BitCrusher::cacheLFO())
+        float range = amount * _lfoDepth;
+        float max   = std::min( 1.f, amount + range / 2.f );
+        float min   = std::max( 0.f, amount - range / 2.f );
+
+        amount = std::min( max, min + range * lfoValue );
+    }
+
+    if ( _amountModulation != nullptr ) {
+        amount = Calc::cap( amount + _amountModulation[ index ]);
+    }
+    return amount;
+}
+
+float MultibandCrusher::getHoldPeriod( float decimation )
+{
+    // see BitCrusher::getHoldPeriod()
+    return ( decimation > 0.f ) ? std::max( 1.f, powf( BitCrusher::MAX_HOLD_PERIOD, decimation ) * _rateRatio ) : 1.f;
+}
+
+int MultibandCrusher::getModulationIndex( int index )
+{
+    // modulation is provided at the host rate, clamped to the current host block as at a
+    // reduced rate, a block can hold samples queued in the previous process cycle
+
+    return std::min(( int ) ( index / _rateRatio ), _modulationSize - 1 );
+}
+
+void MultibandCrusher::resetState()
+{
+    std::fill( _heldSamples.begin(),    _heldSamples.end(),    0.f );
+    std::fill( _holdRemaining.begin(),  _holdRemaining.end(),  0.f );
+    std::fill( _previousInputs.begin(), _previousInputs.end(), 0.f );
+    std::fill( _errors.begin(),         _errors.end(),         0.f );
+}
+
+void MultibandCrusher::prepareSteps( const Lanes& start, const Lanes& increment, int blockSize )
+{
+    // the reciprocal is derived from the interpolated step so their product remains unity while ramping
+
+    float* steps    = _stepFrames.data();
+    float* inverses = _inverseFrames.data();
+
+    bool isRamping = false;
+    for ( int l = 0; l < LANES; ++l ) {
+        isRamping = isRamping || increment.values[ l ] != 0.f;
+    }
+
+    // static steps are provided as a single frame (the kernels read it for each frame)
+
+    _stepStride = isRamping ? LANES : 0;
+    int frames  = isRamping ? blockSize : 1;
+
+    for ( int i = 0; i < frames; ++i )
+    {
+#if defined( __GNUC__ ) && !defined( __clang__ )
+        #pragma GCC unroll 0
+#endif
+        for ( int l = 0; l < LANES; ++l ) {
+            float step = start.values[ l ] + increment.values[ l ] * ( float ) ( i + 1 );
+            steps   [ i * LANES + l ] = step;
+            inverses[ i * LANES + l ] = 1.f / step;
+        }
+    }
+}
+
+template <bool Decimated>
+void MultibandCrusher::crushGroup( int firstLane, const Lanes& crushing, const Lanes& periods, int blockSize )
+{
+    if ( _antiAliasing ) {
+        if ( _stepStride > 0 ) {
+            crushAntiAliased<true, Decimated>( firstLane, crushing, periods, blockSize );
+        } else {
+            crushAntiAliased<false, Decimated>( firstLane, crushing, periods, blockSize );
+        }
+    } else if ( _ditherMode == Dither::NOISE_SHAPED ) {
+        crush<true, true, Decimated>( firstLane, crushing, periods, blockSize );
+    } else if ( _ditherMode == Dither::TPDF ) {
+        crush<true, false, Decimated>( firstLane, crushing, periods, blockSize );
+    } else {
+        crush<false, false, Decimated>( firstLane, crushing, periods, blockSize );
+    }
+}
+
+template <bool Dithered, bool NoiseShaped, bool Decimated>
+void MultibandCrusher::crush( int firstLane, const Lanes& crushing, const Lanes& periods, int blockSize )
+{
+    // a float domain mid-tread quantizer (see BitCrusher::crush()), the dither noise and error are expressed in LSB units
+    // the errors hold the last (LANES values) and second to last (LANES values) error of each lane
+
+    float* frames          = _frames.data();
+    const float* steps     = _stepFrames.data();
+    const float* inverses  = _inverseFrames.data();
+    const float* noise     = _noise.data();
+    const int stride       = _stepStride;
+    const float inputMix   = _inputMix;
+    const float outputMix  = _outputMix;
+
+    if ( Dithered ) {
+        _random->triangular( _noise.data(), blockSize * LANES );
+    }
+
+    float* errors = &_errors[ firstLane * 2 ];
+
+    alignas( 32 ) float error1[ LANES ];
+    alignas( 32 ) float error2[ LANES ];
+    std::copy( errors, errors + LANES, error1 );
+    std::copy( errors + LANES, errors + LANES * 2, error2 );
+
+    alignas( 32 ) float values[ LANES ];
+    HoldState hold( &_heldSamples[ firstLane ], &_holdRemaining[ firstLane ]);
+
+    for ( int i = 0; i < blockSize; ++i )
+    {
+        float* frame = frames + i * LANES;
+
+        // the input is bound to the -1 to +1 range in a separate pass, as GCC otherwise moves the
+        // subsequent operations into the branches of the bounds checks and fails to vectorize
+
+#if defined( __GNUC__ ) && !defined( __clang__ )
+        #pragma GCC unroll 0
+#endif
+        for ( int l = 0; l < LANES; ++l ) {
+            values[ l ] = std::min( 1.f, std::max( -1.f, frame[ l ] * inputMix ));
+        }
+
+#if defined( __GNUC__ ) && !defined( __clang__ )
+        #pragma GCC unroll 0
+#endif
+        for ( int l = 0; l < LANES; ++l )
+        {
+            float step  = steps   [ i * stride + l ];
+            float inv   = inverses[ i * stride + l ];
+            float input = frame[ l ];
+            float value = values[ l ];
+
+            if ( NoiseShaped ) {
+                // error transfer function is ( 1 - z^-1 )^2 (see Dither::getFeedback())
+                value -= ( 2.f * error1[ l ] - error2[ l ]) * step;
+            }
+            float scaled = value * inv;
+            float level  = roundLane( Dithered ? scaled + noise[ i * LANES + l ] : scaled );
+
+            if ( NoiseShaped ) {
+                error2[ l ] = error1[ l ];
+                error1[ l ] = std::min( MAX_ERROR, std::max( -MAX_ERROR, level - scaled ));
+            }
+            // lanes that are not crushing pass their input (written arithmetically as the compiler
+            // does not vectorize a conditional on floating point values, the mask is either 0 or 1)
+
+            float output = level * step * outputMix;
+            frame[ l ]   = output * crushing.values[ l ] + input * ( 1.f - crushing.values[ l ]);
+        }
+
+        if ( Decimated ) {
+            hold.apply( frame, periods );
+        }
+    }
+    std::copy( error1, error1 + LANES, errors );
+    std::copy( error2, error2 + LANES, errors + LANES );
+
+    hold.store();
+}
+
+template <bool Ramping, bool Decimated>
+void MultibandCrusher::crushAntiAliased( int firstLane, const Lanes& crushing, const Lanes& periods, int blockSize )
+{
+    // antiderivative anti-aliasing (see BitCrusher::crushAntiAliased()), with n the rounded positions the antiderivative
+    // difference ( F( u1 ) - F( u0 )) / du is expanded into n1 + ( n1 - n0 ) * ( u0 - ( n0 + n1 ) / 2 ) / du, which remains
+    // well-conditioned as du approaches zero and thus requires neither double precision nor a midpoint fallback
+    // (where both positions round to the same level, the division is skipped arithmetically)
+    // while the steps are static, the position and level of the previous input carry over from the previous frame
+
+    float* frames         = _frames.data();
+    const float* steps    = _stepFrames.data();
+    const float* inverses = _inverseFrames.data();
+    const int stride      = _stepStride;
+    const float inputMix  = _inputMix;
+    const float outputMix = _outputMix;
+
+    float* previousInputs = &_previousInputs[ firstLane ];
+
+    alignas( 32 ) float previous[ LANES ];
+    alignas( 32 ) float values[ LANES ];
+    alignas( 32 ) float previousPositions[ LANES ];
+    alignas( 32 ) float previousLevels[ LANES ];
+
+    std::copy( previousInputs, previousInputs + LANES, previous );
+
+    for ( int l = 0; l < LANES; ++l ) {
+        previousPositions[ l ] = previous[ l ] * inverses[ l ];
+        previousLevels[ l ]    = roundLane( previousPositions[ l ]);
+    }
+    HoldState hold( &_heldSamples[ firstLane ], &_holdRemaining[ firstLane ]);
+
+    for ( int i = 0; i < blockSize; ++i )
+    {
+        float* frame = frames + i * LANES;
+
+#if defined( __GNUC__ ) && !defined( __clang__ )
+        #pragma GCC unroll 0
+#endif
+        for ( int l = 0; l < LANES; ++l ) {
+            values[ l ] = std::min( 1.f, std::max( -1.f, frame[ l ] * inputMix ));
+        }
+
+#if defined( __GNUC__ ) && !defined( __clang__ )
+        #pragma GCC unroll 0
+#endif
+        for ( int l = 0; l < LANES; ++l )
+        {
+            float inv = inverses[ i * stride + l ];
+            float u0  = Ramping ? previous[ l ] * inv : previousPositions[ l ];
+            float u1  = values[ l ] * inv;
+            float n0  = Ramping ? roundLane( u0 ) : previousLevels[ l ];
+            float n1  = roundLane( u1 );
+
+            float jump     = n1 - n0;
+            float isLevel  = ( float ) ( jump == 0.f ); // 1 when both positions round to the same level
+            float divisor  = ( u1 - u0 ) * ( 1.f - isLevel ) + isLevel;
+            float level    = n1 + jump * ( u0 - ( n0 + n1 ) * .5f ) / divisor;
+
+            previousPositions[ l ] = u1;
+            previousLevels[ l ]    = n1;
+            previous[ l ]          = values[ l ];
+
+            float output = level * steps[ i * stride + l ] * outputMix;
+            frame[ l ]   = output * crushing.values[ l ] + frame[ l ] * ( 1.f - crushing.values[ l ]);
+        }
+
+        if ( Decimated ) {
+            hold.apply( frame, periods );
+        }
+    }
+    std::copy( previous, previous + LANES, previousInputs );
+
+    hold.store();
+}
+
+void MultibandCrusher::decimate( int firstLane, const Lanes& periods, int blockSize )
+{
+    float* frames = _frames.data();
+    HoldState hold( &_heldSamples[ firstLane ], &_holdRemaining[ firstLane ]);
+
+    for ( int i = 0; i < blockSize; ++i ) {
+        hold.apply( frames + i * LANES, periods );
+    }
+    hold.store();
+}
+
+}
@@ -0,0 +1,214 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __MULTIBANDCRUSHER_H_INCLUDED__
+#define __MULTIBANDCRUSHER_H_INCLUDED__
+
+#include "crossover.h"
+#include "dither.h"
+#include "lfo.h"
+#include "random.h"
+#include <algorithm>
+#include <vector>
+
+namespace Igorski {
+/**
+ * Bit crushes the bands of a Crossover, each band having its own resolution and sample rate
+ * reduction while sharing all other settings (LFO, dither, anti-aliasing and mix levels).
+ *
+ * The crusher provides the same quantizer and sample-and-hold stages as BitCrusher, but rather than
+ * processing each band separately, all bands of all channels are processed as lanes of a single
+ * stream. The band signals are interleaved into frames of LANES samples (in the lane order of the
+ * Crossover, e.g. per channel all bands) and each stage operates on all lanes of a frame at once using
+ * per lane state and parameters in a structure-of-arrays layout, which the compiler vectorizes (see
+ * BiquadBank). As such crushing four bands of a stereo signal costs about twice as much as crushing a single
+ * band with BitCrusher (rather than four times as much).
+ *
+ * The resolution and hold periods of the bands are evaluated at control rate.
+ */
+class MultibandCrusher
+{
+    public:
+        static constexpr int LANES = 8;
+
+        MultibandCrusher( float inputMix, float outputMix, int amountOfChannels, int maxBufferSize );
+        ~MultibandCrusher();
+
+        // resolution of given band, range between 0 to 1 (scaled to 1 - 16 bits, see BitCrusher::setAmount())
+
+        void setAmount( int band, float value );
+
+        // sample rate reduction of given band (see BitCrusher::setDecimation())
+
+        void setDecimation( int band, float value );
+
+        void setInputMix( float value );
+        void setOutputMix( float value );
+
+        // the LFO is shared by all bands and modulates each bands resolution (and optionally hold rate)
+        // in relation to the bands resolution (see BitCrusher::setLFO())
+
+        void setLFO( float LFORatePercentage, float LFODepth );
+        void setDecimationLFO( float LFODepth );
+
+        void setDither( Dither::Mode mode );
+        void setAntiAliasing( bool enabled );
+
+        // per-sample modulation of the amount and decimation (applied to all bands, see BitCrusher::setModulation())
+
+        void setModulation( const float* amountModulation, const float* decimationModulation, int modulationSize );
+
+        // ratio of the processing rate to the host rate (see BitCrusher::setProcessingRate())
+
+        void setProcessingRate( float ratio );
+
+        // crush the bands of the last split of given crossover, in place
+
+        void process( Crossover* crossover, int bufferSize );
+
+        LFO* lfo;
+        bool hasLFO;
+
+    private:
+        static constexpr int LFO_CONTROL_RATE   = 16;
+        static constexpr int CONTROL_BLOCK_SIZE = 32;
+        static constexpr float MAX_ERROR        = 2.f; // bounds the noise shaped error (see Dither::storeError())
+
+        int _amountOfChannels;
+        int _amountOfBands;
+        int _amountOfGroups; // of LANES lanes
+
+        float _inputMix;
+        float _outputMix;
+        float _rateRatio;
+        float _lfoDepth;
+        float _decimationLfoDepth;
+        bool _antiAliasing;
+        Dither::Mode _ditherMode;
+
+        const float* _amountModulation;
+        const float* _decimationModulation;
+        int _modulationSize;
+
+        // per band parameters
+
+        float _amounts[ Crossover::MAX_BANDS ];
+        float _decimations[ Crossover::MAX_BANDS ];
+        float _holdPeriods[ Crossover::MAX_BANDS ];
+        float _steps[ Crossover::MAX_BANDS ];       // current quantization step, moves towards the target at control rate
+        float _targetSteps[ Crossover::MAX_BANDS ];
+
+        // per lane state (for all groups)
+
+        std::vector<float> _heldSamples;
+        std::vector<float> _holdRemaining;
+        std::vector<float> _previousInputs; // for anti-aliasing
+        std::vector<float> _errors;         // for noise shaping, two samples of history per lane
+
+        // per control block buffers
+
+        struct alignas( 32 ) Lanes {
+            float values[ LANES ];
+        };
+
+        std::vector<float> _lfoBuffer;
+        std::vector<float> _frames;      // interleaved lane samples, LANES per frame
+        std::vector<float> _noise;       // dither noise, LANES per frame
+        std::vector<float> _stepFrames;  // quantization step (and its reciprocal) for each frame
+        std::vector<float> _inverseFrames;
+        int _stepStride;                 // distance between the step frames, 0 when the steps are static
+        std::vector<float*> _lanes;      // band buffers in lane order
+        std::vector<float> _silence;     // read and written by the unused lanes of the last group
+
+        Random* _random;
+
+        bool isCrushing( int band );
+        float getBandAmount( int band, float lfoValue, int index );
+        float getHoldPeriod( float decimation );
+        int getModulationIndex( int index ); // see BitCrusher::getModulationIndex()
+
+        void resetState();
+
+        // stages operating on the frames of a single control block
+
+        void prepareSteps( const Lanes& start, const Lanes& increment, int blockSize );
+
+        // the crushing stages are fused with the sample-and-hold (when Decimated) so the latency of its recurrence
+        // overlaps with the quantization of the subsequent frames
+
+        template <bool Decimated>
+        void crushGroup( int firstLane, const Lanes& crushing, const Lanes& periods, int blockSize );
+        template <bool Dithered, bool NoiseShaped, bool Decimated>
+        void crush( int firstLane, const Lanes& crushing, const Lanes& periods, int blockSize );
+        template <bool Ramping, bool Decimated>
+        void crushAntiAliased( int firstLane, const Lanes& crushing, const Lanes& periods, int blockSize );
+        void decimate( int firstLane, const Lanes& periods, int blockSize );
+
+        // sample-and-hold state of the lanes of a group (see BitCrusher::decimate()), the remaining hold time of each
+        // lane is tracked fractionally, a period of a single sample captures each sample (e.g. leaves the lane unchanged)
+
+        struct HoldState {
+            alignas( 32 ) float held[ LANES ];
+            alignas( 32 ) float remaining[ LANES ];
+            float* heldSamples;
+            float* holdRemaining;
+
+            HoldState( float* heldSamples, float* holdRemaining ) : heldSamples( heldSamples ), holdRemaining( holdRemaining )
+            {
+                std::copy( heldSamples,   heldSamples   + LANES, held );
+                std::copy( holdRemaining, holdRemaining + LANES, remaining );
+            }
+
+            void store()
+            {
+                std::copy( held,      held      + LANES, heldSamples );
+                std::copy( remaining, remaining + LANES, holdRemaining );
+            }
+
+            inline void apply( float* frame, const Lanes& periods )
+            {
+#if defined( __GNUC__ ) && !defined( __clang__ )
+                #pragma GCC unroll 0
+#endif
+                for ( int l = 0; l < LANES; ++l )
+                {
+                    float capture  = ( float ) ( remaining[ l ] <= 0.f ); // 1 when capturing a new sample
+                    held[ l ]      = frame[ l ] * capture + held[ l ] * ( 1.f - capture );
+                    remaining[ l ] = remaining[ l ] + periods.values[ l ] * capture - 1.f;
+                    frame[ l ]     = held[ l ];
+                }
+            }
+        };
+
+        // round to the nearest integer (ties to even) in a form the compiler vectorizes without SSE4.1: adding and
+        // subtracting 1.5 * 2^23 drops the fraction (exact for the 16-bit range of the quantizer levels, note this
+        // relies on the compiler not reassociating floating point math, e.g. no -ffast-math)
+
+        static inline float roundLane( float value )
+        {
+            const float magic = 12582912.f; // 1.5 * 2^23
+            return ( value + magic ) - magic;
+        }
+};
+}
+
+#endif
@@ -0,0 +1,165 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "oversampler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Igorski {
+
+/* constructor / destructor */
+
+Oversampler::Oversampler( int amountOfChannels, int maxBufferSize )
+{
+    _amountOfChannels = amountOfChannels;
+    _factor           = 1;
+    _amountOfStages   = 0;
+    _phase            = HalfBandFilter::LINEAR_PHASE;
+
+    for ( int c = 0; c < amountOfChannels; ++c )
+    {
+        // each stage operates on twice the amount of samples of the previous stage
+
+        for ( int stage = 0, size = maxBufferSize; stage < MAX_STAGES; ++stage, size *= 2 )
+        {
+            HalfBandFilter::Response response = ( stage == 0 ) ? HalfBandFilter::STEEP : HalfBandFilter::RELAXED;
+
+            _upsamplers.push_back  ( new HalfBandFilter( response, _phase, size ));
+            _downsamplers.push_back( new HalfBandFilter( response, _phase, size ));
+        }
+    }
+    _buffer = new AudioBuffer( amountOfChannels, maxBufferSize * MAX_FACTOR );
+}
+
+Oversampler::~Oversampler()
+{
+    for ( size_t i = 0; i < _upsamplers.size(); ++i ) {
+        delete _upsamplers[ i ];
+        delete _downsamplers[ i ];
+    }
+    delete _buffer;
+}
+
+/* public methods */
+
+int Oversampler::getFactor()
+{
+    return _factor;
+}
+
+void Oversampler::setFactor( int factor )
+{
+    int amountOfStages = 0;
+    while (( 1 << amountOfStages ) < factor && amountOfStages < MAX_STAGES ) {
+        ++amountOfStages;
+    }
+
+    if ( amountOfStages == _amountOfStages ) {
+        return;
+    }
+    _amountOfStages = amountOfStages;
+    _factor         = 1 << amountOfStages;
+
+    reset();
+}
+
+HalfBandFilter::Phase Oversampler::getPhase()
+{
+    return _phase;
+}
+
+void Oversampler::setPhase( HalfBandFilter::Phase phase )
+{
+    if ( phase == _phase ) {
+        return;
+    }
+    _phase = phase;
+
+    for ( size_t i = 0; i < _upsamplers.size(); ++i ) {
+        _upsamplers[ i ]->setPhase( phase );
+        _downsamplers[ i ]->setPhase( phase );
+    }
+}
+
+int Oversampler::getLatencySamples()
+{
+    // each stage delays the signal twice (once for up- and once for downsampling)
+    // at its own rate, which is expressed in samples at the host rate
+
+    float latency = 0.f;
+
+    for ( int stage = 0; stage < _amountOfStages; ++stage ) {
+        float delay = _upsamplers[ stage ]->getLatency() + _downsamplers[ stage ]->getLatency();
+        latency += delay / ( float ) ( 2 << stage );
+    }
+    return ( int ) round( latency );
+}
+
+AudioBuffer* Oversampler::upsample( AudioBuffer* input, int bufferSize )
+{
+    int amountOfChannels = std::min( input->amountOfChannels, _amountOfChannels );
+
+    for ( int c = 0; c < amountOfChannels; ++c )
+    {
+        float* channelBuffer = _buffer->getBufferForChannel( c );
+        HalfBandFilter** filters = &_upsamplers[ c * MAX_STAGES ];
+
+        // the cascade operates in-place, doubling the contents with each stage
+
+        filters[ 0 ]->upsample( input->getBufferForChannel( c ), channelBuffer, bufferSize );
+
+        for ( int stage = 1, size = bufferSize * 2; stage < _amountOfStages; ++stage, size *= 2 ) {
+            filters[ stage ]->upsample( channelBuffer, channelBuffer, size );
+        }
+    }
+    return _buffer;
+}
+
+void Oversampler::downsample( AudioBuffer* output, int bufferSize )
+{
+    int amountOfChannels = std::min( output->amountOfChannels, _amountOfChannels );
+
+    for ( int c = 0; c < amountOfChannels; ++c )
+    {
+        float* channelBuffer = _buffer->getBufferForChannel( c );
+        HalfBandFilter** filters = &_downsamplers[ c * MAX_STAGES ];
+
+        // traverse the cascade in reverse, halving the contents with each stage
+
+        for ( int stage = _amountOfStages - 1, size = bufferSize << stage; stage > 0; --stage, size /= 2 ) {
+            filters[ stage ]->downsample( channelBuffer, channelBuffer, size );
+        }
+        filters[ 0 ]->downsample( channelBuffer, output->getBufferForChannel( c ), bufferSize );
+    }
+}
+
+/* private methods */
+
+void Oversampler::reset()
+{
+    for ( size_t i = 0; i < _upsamplers.size(); ++i ) {
+        _upsamplers[ i ]->reset();
+        _downsamplers[ i ]->reset();
+    }
+}
+
+}
@@ -0,0 +1,99 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __OVERSAMPLER_H_INCLUDED__
+#define __OVERSAMPLER_H_INCLUDED__
+
+#include "audiobuffer.h"
+#include "halfbandfilter.h"
+#include <vector>
+
+namespace Igorski {
+/**
+ * Runs a processing stage at 2, 4 or 8 times the host rate, by means of
+ * a cascade of half-band filters (one per doubling of the rate). The first stage
+ * of the cascade uses a steep filter, subsequent stages a relaxed (shorter) one.
+ *
+ * All memory is allocated upon construction (which happens in setupProcessing),
+ * changing the factor or phase at runtime merely switches the active filters.
+ */
+class Oversampler
+{
+    public:
+        static constexpr int MAX_FACTOR = VST::MAX_OVERSAMPLING;
+        static constexpr int MAX_STAGES = 3; // log2( MAX_FACTOR )
+
+        Oversampler( int amountOfChannels, int maxBufferSize );
+        ~Oversampler();
+
+        // factor is either 1 (disables oversampling), 2, 4 or 8
+
+        int getFactor();
+        void setFactor( int factor );
+
+        HalfBandFilter::Phase getPhase();
+        void setPhase( HalfBandFilter::Phase phase );
+
+        // the delay introduced by the up- and downsampling filters, in samples at the host rate
+
+        int getLatencySamples();
+
+        /**
+         * upsample given bufferSize of input, the returned buffer
+         * holds bufferSize * getFactor() samples for each channel
+         */
+        AudioBuffer* upsample( AudioBuffer* input, int bufferSize );
+
+        /**
+         * downsample the contents of the buffer returned by upsample()
+         * into given output, writing bufferSize samples for each channel
+         */
+        void downsample( AudioBuffer* output, int bufferSize );
+
+        /**
+         * convenience method to run given stage (a callable accepting an AudioBuffer*
+         * and the amount of samples to process) at the oversampled rate
+         * the contents of given buffer are replaced by the stage's output
+         */
+        template <typename Stage>
+        void process( AudioBuffer* buffer, int bufferSize, Stage stage );
+
+    private:
+        int _amountOfChannels;
+        int _factor;
+        int _amountOfStages;
+        HalfBandFilter::Phase _phase;
+
+        // for each channel the filters for each stage of the cascade, in [ channel * MAX_STAGES + stage ] order
+
+        std::vector<HalfBandFilter*> _upsamplers;
+        std::vector<HalfBandFilter*> _downsamplers;
+
+        AudioBuffer* _buffer; // the oversampled signal
+
+        void reset();
+};
+}
+
+#include "oversampler.tcc"
+
+#endif
@@ -38,8 +38,63 @@ enum
     kBitCrushLfoDepthId = 3,    // Bit crush LFO depth
     kWetMixId = 4,    // Wet mix
     kDryMixId = 5,    // Dry mix
+    kDecimationId = 6,    // Downsampling
+    kDecimationLfoDepthId = 7,    // Downsampling LFO depth
+    kDitherId = 8,    // Dither
+    kNoiseShapingId = 9,    // Noise shaping
+    kOutputWordLengthId = 10,    // 16-bit output
+    kAntiAliasingId = 11,    // Anti-aliasing
+    kBitCrushLfoWaveformId = 12,    // Bit crush LFO waveform
+    kModLfoRateId = 13,    // Mod LFO rate
+    kModLfoDepthId = 14,    // Mod LFO to downsampling
+    kEnvelopeDepthId = 15,    // Envelope to resolution
+    kOversamplingId = 16,    // Oversampling
+    kLinearPhaseId = 17,    // Linear phase
+    kEcoModeId = 18,    // Eco mode
+    kConvolutionMixId = 19,    // Convolution mix
+    kDelayTimeId = 20,    // Delay time
+    kDelayFeedbackId = 21,    // Delay feedback
+    kDelayMixId = 22,    // Delay mix
+    kChorusRateId = 23,    // Delay modulation rate
+    kChorusDepthId = 24,    // Delay modulation depth
+    kDelayInterpolationId = 25,    // Delay interpolation
+    kLowCutId = 26,    // Low cut
+    kHighCutId = 27,    // High cut
+    kSaturationId = 28,    // Saturation
+    kSaturationCurveId = 29,    // Saturation curve
+    kBandsId = 30,    // Crusher bands
+    kCrossover1Id = 31,    // Crossover 1
+    kCrossover2Id = 32,    // Crossover 2
+    kCrossover3Id = 33,    // Crossover 3
+    kBand1ResolutionId = 34,    // Band 1 resolution
+    kBand2ResolutionId = 35,    // Band 2 resolution
+    kBand3ResolutionId = 36,    // Band 3 resolution
+    kBand4ResolutionId = 37,    // Band 4 resolution
+    kBand1DecimationId = 38,    // Band 1 downsampling
+    kBand2DecimationId = 39,    // Band 2 downsampling
+    kBand3DecimationId = 40,    // Band 3 downsampling
+    kBand4DecimationId = 41,    // Band 4 downsampling
+    kReverbMixId = 42,    // Reverb mix
+    kReverbSizeId = 43,    // Reverb size
+    kReverbDecayId = 44,    // Reverb decay
+    kReverbDampingId = 45,    // Reverb damping
+    kSpectralMagnitudeId = 46,    // Spectral magnitude resolution
+    kSpectralPhaseId = 47,    // Spectral phase resolution
+    kSpectralMixId = 48,    // Spectral crusher mix
+    kSpectralSizeId = 49,    // Spectral frame size
+    kSidechainDuckingId = 50,    // Sidechain ducking
+    kSidechainCrushId = 51,    // Sidechain to resolution
+    kSequencerCrushId = 52,    // Sequencer to resolution
+    kSequencerMixId = 53,    // Sequencer to mix
+    kSequencerStepsId = 54,    // Sequencer steps
+    kSequencerPatternId = 55,    // Sequencer pattern
+    kSequencerGlideId = 56,    // Sequencer glide
+    kStutterId = 57,    // Stutter
+    kStutterLengthId = 58,    // Stutter length
 
 // --- AUTO-GENERATED END
+
+    kAmountOfParams // keep last, used to size per-parameter storage (see ModulationMatrix)
 };
 
 #endif
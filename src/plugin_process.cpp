@@ -21,6 +21,7 @@
  * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 #include "plugin_process.h"
+#include <algorithm>
 #include <math.h>
 #include "calc.h"
 
@@ -34,18 +35,59 @@ PluginProcess::PluginProcess( int amountOfChannels ) {
 
     // create the child processors
 
-    bitCrusher = new BitCrusher( 8, .5f, .5f );
-    limiter    = new Limiter( 10.f, 500.f, .6f );
+    bitCrusher = new BitCrusher( 8, .5f, .5f, amountOfChannels );
+    multibandCrusher = new MultibandCrusher( .5f, .5f, amountOfChannels, VST::BUFFER_SIZE * VST::MAX_OVERSAMPLING );
+    // the limiter ducks the wet signal when keyed by the sidechain (see setSidechainDucking())
+    // its parameters are normalized (see Limiter::recalculate()), the trim keeps unity gain
+    limiter    = new Limiter( .15f, .5f, 1.f );
+    limiter->setTrim( .5f );
+    toneFilter = new BiquadBank( amountOfChannels, 2, VST::BUFFER_SIZE );
+    dryDelay   = new CompensationDelay( amountOfChannels, MAX_LATENCY, VST::BUFFER_SIZE );
+    _dryBuffer = new AudioBuffer( amountOfChannels, VST::BUFFER_SIZE );
+    waveshaper = new Waveshaper( amountOfChannels );
 
-    // will be lazily created in the process function
-    _preMixBuffer  = nullptr;
-    _postMixBuffer = nullptr;
+    outputDither = new Dither( amountOfChannels );
+    modulationMatrix = new ModulationMatrix();
+    oversampler      = new Oversampler( amountOfChannels, VST::BUFFER_SIZE );
+    undersampler     = new Undersampler( amountOfChannels, VST::BUFFER_SIZE );
+    convolver        = new Convolver( amountOfChannels, VST::BUFFER_SIZE );
+    crossover        = new Crossover( amountOfChannels, VST::BUFFER_SIZE * VST::MAX_OVERSAMPLING );
+    delayLine        = new DelayLine( amountOfChannels, VST::BUFFER_SIZE );
+    reverb           = new Reverb();
+    spectralCrusher  = new SpectralCrusher( amountOfChannels );
+    stutter          = new Stutter( amountOfChannels );
+    setOutputBitDepth( 0 );
+
+    // default tempo for hosts that don't provide a processing context
+    setTempo( 120.0, 4, 4 );
+
+    _sidechainLevels.resize( VST::BUFFER_SIZE, 0.f );
+
+    // the mix buffers are allocated at the maximum block size, each cycle processes only its own frames
+
+    _preMixBuffer  = new AudioBuffer( amountOfChannels, VST::BUFFER_SIZE );
+    _postMixBuffer = new AudioBuffer( amountOfChannels, VST::BUFFER_SIZE );
 }
 
 PluginProcess::~PluginProcess() {
     delete bitCrusher;
+    delete multibandCrusher;
     delete limiter;
+    delete toneFilter;
+    delete dryDelay;
+    delete waveshaper;
+    delete outputDither;
+    delete modulationMatrix;
+    delete oversampler;
+    delete undersampler;
+    delete convolver;
+    delete crossover;
+    delete delayLine;
+    delete reverb;
+    delete spectralCrusher;
+    delete stutter;
     delete _postMixBuffer;
+    delete _dryBuffer;
     delete _preMixBuffer;
 }
 
@@ -59,6 +101,37 @@ void PluginProcess::setWetMix( float value ) {
     _wetMix = value;
 }
 
+void PluginProcess::setOutputBitDepth( int bits ) {
+    _outputBitDepth = bits;
+}
+
+void PluginProcess::setOversampling( int factor, HalfBandFilter::Phase phase ) {
+    oversampler->setFactor( factor );
+    oversampler->setPhase( phase );
+    undersampler->setPhase( phase );
+
+    cacheProcessingRate();
+}
+
+void PluginProcess::setEcoMode( bool enabled ) {
+    undersampler->setFactor( enabled ? Undersampler::getFactorForRate( VST::SAMPLE_RATE, ECO_SAMPLE_RATE ) : 1 );
+
+    cacheProcessingRate();
+}
+
+void PluginProcess::setSidechainDucking( float value ) {
+    _sidechainDucking = Calc::cap( value );
+
+    // the threshold lowers as the ducking increases (full ducking equals -40 dB)
+    limiter->setThreshold( 1.f - _sidechainDucking );
+}
+
+int PluginProcess::getLatencySamples() {
+    // the oversampler operates at the reduced rate when in eco mode
+    return undersampler->getLatencySamples() + oversampler->getLatencySamples() * undersampler->getFactor() +
+           spectralCrusher->getLatencySamples();
+}
+
 bool PluginProcess::setTempo( double tempo, int32 timeSigNumerator, int32 timeSigDenominator )
 {
     if ( _tempo == tempo && _timeSigNumerator == timeSigNumerator && _timeSigDenominator == timeSigDenominator ) {
@@ -69,13 +142,114 @@ bool PluginProcess::setTempo( double tempo, int32 timeSigNumerator, int32 timeSi
     _timeSigDenominator = timeSigDenominator;
     _tempo              = tempo;
 
-    _fullMeasureDuration = ( 60.f / _tempo ) * _timeSigDenominator; // seconds per measure
-    _fullMeasureSamples  = Calc::secondsToBuffer( _fullMeasureDuration ); // samples per measure
-    _beatSamples         = ceil( _fullMeasureSamples / _timeSigDenominator ); // samples per beat
-    _halfMeasureSamples  = ceil( _fullMeasureSamples / 2 ); // samples per half measure
-    _sixteenthSamples    = ceil( _fullMeasureSamples / 16 ); // samples per 16th note
+    // a measure spans numerator notes of ( 1 / denominator ) length, e.g. 6/8 equals three quarter notes
+
+    double quarterNoteSamples = ( 60.0 / _tempo ) * VST::SAMPLE_RATE;
+
+    _fullMeasureSamples = quarterNoteSamples * 4.0 * _timeSigNumerator / _timeSigDenominator; // samples per measure
+    _beatSamples        = _fullMeasureSamples / _timeSigNumerator; // samples per beat
+    _halfMeasureSamples = _fullMeasureSamples / 2.0; // samples per half measure
+    _sixteenthSamples   = quarterNoteSamples / 4.0;  // samples per 16th note
+
+    cacheDelayTime();
+    cacheStutterLength();
+
+    // the step sequencer advances in 16th notes
+
+    modulationMatrix->getSequencer()->setStepLength( _sixteenthSamples );
 
     return true;
 }
 
+void PluginProcess::setTransportPosition( int64 samplePosition )
+{
+    modulationMatrix->getSequencer()->setPosition( samplePosition );
+}
+
+void PluginProcess::setAmountOfBands( int value ) {
+    _amountOfBands = std::min( Crossover::MAX_BANDS, std::max( 1, value ));
+
+    if ( _amountOfBands > 1 ) {
+        crossover->setAmountOfBands( _amountOfBands );
+    }
+}
+
+void PluginProcess::setDelayTime( DelayTime value ) {
+    _delayTime = value;
+
+    cacheDelayTime();
+}
+
+void PluginProcess::setStutterLength( StutterLength value ) {
+    _stutterLength = value;
+
+    cacheStutterLength();
+}
+
+void PluginProcess::setToneFilter( float lowCut, float highCut ) {
+    _toneFilterActive = lowCut > 0.f || highCut < 1.f;
+
+    // low cut spans 20 Hz - 2 kHz, high cut 1 kHz - 20 kHz (both exponentially scaled)
+
+    toneFilter->setFilter( 0, BiquadBank::HIGH_PASS, 20.f * powf( 100.f, lowCut ), .707f );
+    toneFilter->setFilter( 1, BiquadBank::LOW_PASS, 1000.f * powf( 20.f, highCut ), .707f );
+}
+
+/* private methods */
+
+void PluginProcess::cacheProcessingRate() {
+    float ratio = ( float ) oversampler->getFactor() / ( float ) undersampler->getFactor();
+
+    bitCrusher->setProcessingRate( ratio );
+    multibandCrusher->setProcessingRate( ratio );
+    crossover->setProcessingRate( ratio );
+    waveshaper->setProcessingRate( ratio );
+}
+
+void PluginProcess::cacheDelayTime() {
+    double samples;
+    switch ( _delayTime ) {
+        default:
+        case SHORT:
+            samples = Calc::secondsToBuffer( SHORT_DELAY_TIME );
+            break;
+        case SIXTEENTH:
+            samples = _sixteenthSamples;
+            break;
+        case BEAT:
+            samples = _beatSamples;
+            break;
+        case HALF_MEASURE:
+            samples = _halfMeasureSamples;
+            break;
+        case FULL_MEASURE:
+            samples = _fullMeasureSamples;
+            break;
+    }
+    delayLine->setDelaySamples(( float ) samples );
+}
+
+void PluginProcess::cacheStutterLength() {
+    double samples;
+    switch ( _stutterLength ) {
+        default:
+        case STUTTER_SIXTEENTH:
+            samples = _sixteenthSamples;
+            break;
+        case STUTTER_EIGHTH:
+            samples = _sixteenthSamples * 2.0;
+            break;
+        case STUTTER_BEAT:
+            samples = _beatSamples;
+            break;
+        case STUTTER_HALF_MEASURE:
+            samples = _halfMeasureSamples;
+            break;
+        case STUTTER_FULL_MEASURE:
+            samples = _fullMeasureSamples;
+            break;
+    }
+    stutter->setRepeatLength(( int ) round( samples ));
+}
+
 }
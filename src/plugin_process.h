@@ -25,8 +25,24 @@
 
 #include "global.h"
 #include "audiobuffer.h"
+#include "biquadbank.h"
 #include "bitcrusher.h"
+#include "compensationdelay.h"
+#include "convolver.h"
+#include "crossover.h"
+#include "delayline.h"
+#include "dither.h"
 #include "limiter.h"
+#include "modulationmatrix.h"
+#include "multibandcrusher.h"
+#include "oversampler.h"
+#include "reverb.h"
+#include "spectralcrusher.h"
+#include "stutter.h"
+#include "undersampler.h"
+#include "waveshaper.h"
+#include "calc.h"
+#include <vector>
 
 using namespace Steinberg;
 
@@ -38,53 +54,202 @@ class PluginProcess {
         ~PluginProcess();
 
         // apply effect to incoming sampleBuffer contents
+        // sidechainBuffer holds the channels of the sidechain input bus (read in place),
+        // it is nullptr when the bus is inactive or disconnected
+        // wetOutBuffer and dryOutBuffer (when provided) receive the wet and the latency compensated dry
+        // signal separately (at their mix levels), these must hold at least numOutChannels channels
 
         template <typename SampleType>
         void process( SampleType** inBuffer, SampleType** outBuffer, int numInChannels, int numOutChannels,
-            int bufferSize, uint32 sampleFramesSize
+            int bufferSize, uint32 sampleFramesSize,
+            SampleType** sidechainBuffer = nullptr, int numSidechainChannels = 0,
+            SampleType** wetOutBuffer = nullptr, SampleType** dryOutBuffer = nullptr
         );
 
+        // bypass the processing chain, the input is written into the output delayed by the latency of the
+        // processing chain (see getLatencySamples()) so toggling the bypass doesn't shift the signal in time
+
+        template <typename SampleType>
+        void bypass( SampleType** inBuffer, SampleType** outBuffer, int numInChannels, int numOutChannels, int bufferSize );
+
         // setters
 
         void setDryMix( float value );
         void setWetMix( float value );
 
+        // reduce the word length of the output to given amount of bits (0 disables the reduction)
+        // the reduction is dithered according to the mode of outputDither
+
+        void setOutputBitDepth( int bits );
+
+        // run the bit crusher at given multiple of the host rate (1, 2, 4 or 8) to suppress aliasing
+        // this introduces latency (see getLatencySamples()), which is lowest for MINIMUM_PHASE filters
+        // (the phase applies to the eco mode filters as well)
+
+        void setOversampling( int factor, HalfBandFilter::Phase phase );
+
+        // eco mode runs the wet chain at a reduced rate (ECO_SAMPLE_RATE or the nearest rate above)
+        // on high rate sessions, the dry signal remains at the host rate
+
+        void setEcoMode( bool enabled );
+
+        static constexpr float ECO_SAMPLE_RATE = 44100.f;
+
+        // the maximum wet chain latency (in samples) the dry path can compensate for
+
+        static constexpr int MAX_LATENCY = STFT::MAX_SIZE + 1024;
+
+        // the amount (0 - 1 range) by which the sidechain ducks the wet signal (through the limiters
+        // detector), 0 disables ducking. Has no effect when no sidechain is provided
+
+        void setSidechainDucking( float value );
+
+        // the delay (in samples) introduced by the processing chain, to be reported to the host
+
+        int getLatencySamples();
+
         // synchronize the effects tempo with the host - when desired -
         // tempo is in BPM, time signature provided as: timeSigNumerator / timeSigDenominator (e.g. 3/4)
         // returns true when tempo has updated, false to indicate no change was made
 
         bool setTempo( double tempo, int32 timeSigNumerator, int32 timeSigDenominator );
 
+        // synchronize the step sequencer with the host transport, samplePosition being the
+        // position (in samples) of the start of the next process cycle. When not provided
+        // (e.g. the transport is stopped) the sequencer continues freely
+
+        void setTransportPosition( int64 samplePosition );
+
+        // delay times of the delay line, all but SHORT follow the host tempo
+
+        enum DelayTime {
+            SHORT = 0, // fixed SHORT_DELAY_TIME, for chorus and flanging
+            SIXTEENTH,
+            BEAT,
+            HALF_MEASURE,
+            FULL_MEASURE
+        };
+        static constexpr int AMOUNT_OF_DELAY_TIMES = 5;
+        static constexpr float SHORT_DELAY_TIME    = .01f; // in seconds
+
+        void setDelayTime( DelayTime value );
+
+        // repeat lengths of the stutter, all follow the host tempo
+
+        enum StutterLength {
+            STUTTER_SIXTEENTH = 0,
+            STUTTER_EIGHTH,
+            STUTTER_BEAT,
+            STUTTER_HALF_MEASURE,
+            STUTTER_FULL_MEASURE
+        };
+        static constexpr int AMOUNT_OF_STUTTER_LENGTHS = 5;
+
+        void setStutterLength( StutterLength value );
+
+        // tone shaping of the crushed signal by a high pass (lowCut) and low pass (highCut) filter
+        // values are normalized, the filters are bypassed when at their extremes (0 and 1 respectively)
+
+        void setToneFilter( float lowCut, float highCut );
+
+        // split the signal into given amount of bands prior to crushing, the bands being crushed by
+        // multibandCrusher, a value of 1 crushes the full band signal using bitCrusher
+
+        void setAmountOfBands( int value );
+
         // child processors
 
         BitCrusher* bitCrusher;
+        MultibandCrusher* multibandCrusher;
+        BiquadBank* toneFilter;
+        CompensationDelay* dryDelay;
+        Convolver* convolver;
+        Crossover* crossover;
+        DelayLine* delayLine;
         Limiter* limiter;
+        Dither* outputDither;
+        ModulationMatrix* modulationMatrix;
+        Oversampler* oversampler;
+        Reverb* reverb;
+        SpectralCrusher* spectralCrusher;
+        Stutter* stutter;
+        Undersampler* undersampler;
+        Waveshaper* waveshaper;
 
     private:
-        AudioBuffer* _preMixBuffer;  // buffer used for the pre effect mixing
-        AudioBuffer* _postMixBuffer; // buffer used for the post effect mixing
+        AudioBuffer* _preMixBuffer;  // buffer used for the pre effect mixing (allocated at the maximum block size)
+        AudioBuffer* _postMixBuffer; // buffer used for the post effect mixing (allocated at the maximum block size)
+        AudioBuffer* _dryBuffer;     // buffer holding the latency compensated dry signal (allocated at the maximum block size)
 
         float _dryMix;
         float _wetMix;
+        int _outputBitDepth;
         int _amountOfChannels;
 
         // tempo related
 
+        // note durations are fractional (in samples), preventing tempo synced processors from drifting from the host
+
         double _tempo              = 0.0;
         int32 _timeSigNumerator    = 0;
         int32 _timeSigDenominator  = 0;
-        float _fullMeasureDuration = 1.f;
-        int _fullMeasureSamples    = 1;
-        int _halfMeasureSamples    = 1;
-        int _beatSamples           = 1;
-        int _sixteenthSamples      = 1;
+        double _fullMeasureSamples = 1.0;
+        double _halfMeasureSamples = 1.0;
+        double _beatSamples        = 1.0;
+        double _sixteenthSamples   = 1.0;
+
+        DelayTime _delayTime = SHORT;
+        StutterLength _stutterLength = STUTTER_BEAT;
+
+        bool _toneFilterActive = false;
+        int _amountOfBands     = 1;
+        float _sidechainDucking = 0.f;
+
+        // peak level across the channels of the sidechain for each sample of the current process cycle
+
+        std::vector<float> _sidechainLevels;
+
+        // applies the current delay time (in samples for the current tempo) onto the delay line
+
+        void cacheDelayTime();
+
+        // applies the current stutter length (in samples for the current tempo) onto the stutter
 
-        // ensures the pre- and post mix buffers match the appropriate amount of channels
-        // and buffer size. this also clones the contents of given in buffer into the pre-mix buffer
-        // the buffers are pooled so this can be called upon each process cycle without allocation overhead
+        void cacheStutterLength();
+
+        // clones the contents of given in buffer into the pre-mix buffer (only the first bufferSize frames
+        // are written, the mix buffers are allocated upon construction so no allocation takes place here)
 
         template <typename SampleType>
         void prepareMixBuffers( SampleType** inBuffer, int numInChannels, int bufferSize );
+
+        // mix the dry signal (either the input or the delayed dry signal) and the post mix buffer into the output
+
+        template <typename SampleType, typename DrySampleType>
+        void mixOutput( DrySampleType** dryBuffer, SampleType** outBuffer, int amountOfChannels, int bufferSize,
+                        bool mixDry, const float* wetModulation, const float* dryModulation );
+
+        // write given source (either the post mix buffer or the dry signal) at its (modulated) mix level
+        // into an auxiliary output
+
+        template <typename SampleType, typename SourceSampleType>
+        void writeAuxiliaryOutput( SourceSampleType** source, SampleType** outBuffer, int amountOfChannels, int bufferSize,
+                                   float mix, const float* modulation );
+
+        // mix CHANNELS channels (starting at firstChannel) of the dry signal and post mix buffer into the output
+
+        template <typename SampleType, typename DrySampleType, int CHANNELS>
+        void mixChannels( DrySampleType** dryBuffer, SampleType** outBuffer, int firstChannel, int bufferSize,
+                          bool mixDry, const float* wetModulation, const float* dryModulation );
+
+        // rectify the sidechain into _sidechainLevels, returns nullptr when no sidechain is provided
+
+        template <typename SampleType>
+        const float* prepareSidechain( SampleType** sidechainBuffer, int numSidechainChannels, int bufferSize );
+
+        // the bit crusher is informed of the rate it is processing at (relative to the host rate)
+
+        void cacheProcessingRate();
 };
 }
 
@@ -24,73 +24,290 @@ namespace Igorski
 {
 template <typename SampleType>
 void PluginProcess::process( SampleType** inBuffer, SampleType** outBuffer, int numInChannels, int numOutChannels,
-                             int bufferSize, uint32 sampleFramesSize ) {
+                             int bufferSize, uint32 sampleFramesSize,
+                             SampleType** sidechainBuffer, int numSidechainChannels,
+                             SampleType** wetOutBuffer, SampleType** dryOutBuffer ) {
 
     // input and output buffers can be float or double as defined
     // by the templates SampleType value. Internally we process
     // audio as floats
 
-    SampleType inSample;
-    int i, readIndex;
+    // the processors are sized for the negotiated arrangement, in which the in- and output match
 
-    bool mixDry = _dryMix != 0.f;
+    int amountOfChannels = std::min( _amountOfChannels, std::min( numInChannels, numOutChannels ));
 
-    SampleType dryMix = ( SampleType ) _dryMix;
-    SampleType wetMix = ( SampleType ) _wetMix;
+    prepareMixBuffers( inBuffer, amountOfChannels, bufferSize );
 
-    prepareMixBuffers( inBuffer, numInChannels, bufferSize );
+    const float* keyLevels = prepareSidechain( sidechainBuffer, numSidechainChannels, bufferSize );
 
-    for ( int32 c = 0; c < numInChannels; ++c )
-    {
-        SampleType* channelInBuffer  = inBuffer[ c ];
-        SampleType* channelOutBuffer = outBuffer[ c ];
-        float* channelPreMixBuffer   = _preMixBuffer->getBufferForChannel( c );
-        float* channelPostMixBuffer  = _postMixBuffer->getBufferForChannel( c );
+    // evaluate the modulation sources for this block (envelopes follow the input signal, or the sidechain when keyed)
 
-        // example processing: apply some bit crushing onto the premix buffer
-        bitCrusher->process( channelPreMixBuffer, bufferSize );
+    modulationMatrix->process( _preMixBuffer, bufferSize, keyLevels );
 
-        // POST MIX processing
-        // apply the post mix effect processing
+    const float* wetModulation = modulationMatrix->getModulation( kWetMixId );
+    const float* dryModulation = modulationMatrix->getModulation( kDryMixId );
 
-        // this is just cloning the pre mix buffer so we can hear output in this example
-        for ( i = 0; i < bufferSize; ++i ) {
-            channelPostMixBuffer[ i ] = ( float ) channelPreMixBuffer[ i ];
-        }
+    bool mixDry = _dryMix != 0.f || dryModulation != nullptr;
 
-        // mix the input and processed post mix buffers into the output buffer
+    // delay the dry signal by the latency of the wet chain (when there is no latency the
+    // dry signal is only recorded, so it continues seamlessly once latency is introduced)
 
-        for ( i = 0; i < bufferSize; ++i ) {
+    dryDelay->setDelay( getLatencySamples() );
+    bool isDryDelayed = dryDelay->getDelay() > 0;
 
-            // before writing to the out buffer we take a snapshot of the current in sample
-            // value as VST2 in Ableton Live supplies the same buffer for inBuffer and outBuffer!
-            inSample = channelInBuffer[ i ];
+    if ( isDryDelayed ) {
+        dryDelay->process( _preMixBuffer, _dryBuffer, bufferSize );
+    } else {
+        dryDelay->write( _preMixBuffer, bufferSize );
+    }
 
-            // wet mix (e.g. the effected signal)
-            channelOutBuffer[ i ] = ( SampleType ) channelPostMixBuffer[ i ] * wetMix;
+    // beat repeat of the wet signal (records continuously, replaces the signal while engaged)
 
-            // dry mix (e.g. mix in the input signal)
-            if ( mixDry ) {
-                channelOutBuffer[ i ] += ( inSample * dryMix );
+    stutter->process( _preMixBuffer, bufferSize );
+
+    // example processing: apply some bit crushing onto the premix buffer
+    // (either onto the full band or split into multiple bands, each crushed separately)
+    const float* amountModulation     = modulationMatrix->getModulation( kBitDepthId );
+    const float* decimationModulation = modulationMatrix->getModulation( kDecimationId );
+
+    bitCrusher->setModulation( amountModulation, decimationModulation, bufferSize );
+    multibandCrusher->setModulation( amountModulation, decimationModulation, bufferSize );
+    // (oversampled when requested as quantization and sample-and-hold are prone to aliasing)
+    // in eco mode the wet chain runs at a reduced rate
+    undersampler->process( _preMixBuffer, bufferSize, [ this ]( AudioBuffer* wetBuffer, int wetSize ) {
+        oversampler->process( wetBuffer, wetSize, [ this ]( AudioBuffer* buffer, int size ) {
+            // saturate prior to crushing
+            if ( waveshaper->isActive() ) {
+                waveshaper->process( buffer, size );
             }
+            if ( _amountOfBands == 1 ) {
+                bitCrusher->process( buffer, size );
+                return;
+            }
+            crossover->split( buffer, size );
+            multibandCrusher->process( crossover, size );
+            crossover->merge( buffer, size );
+        });
+    });
+
+    // bit reduction in the frequency domain
+
+    if ( spectralCrusher->isActive() ) {
+        spectralCrusher->process( _preMixBuffer, bufferSize );
+    }
+
+    // tone shaping of the crushed signal
+
+    if ( _toneFilterActive ) {
+        toneFilter->process( _preMixBuffer, bufferSize );
+    }
+
+    // delay line (applied at the host rate, as the delay line is dimensioned for it)
+
+    delayLine->process( _preMixBuffer, bufferSize );
+
+    // POST MIX processing
+    // convolve the processed signal with the impulse response (copies the pre mix buffer when none is loaded)
+
+    convolver->process( _preMixBuffer, _postMixBuffer, bufferSize );
+
+    // add space to the crushed signal
+
+    if ( reverb->isActive() ) {
+        reverb->process( _postMixBuffer, bufferSize );
+    }
+
+    // duck the wet signal by the sidechain
+
+    if ( keyLevels != nullptr && _sidechainDucking > 0.f ) {
+        float* wetChannels[ VST::MAX_CHANNELS ];
+        for ( int c = 0; c < amountOfChannels; ++c ) {
+            wetChannels[ c ] = _postMixBuffer->getBufferForChannel( c );
+        }
+        limiter->process<float>( wetChannels, bufferSize, amountOfChannels, keyLevels );
+    }
+
+    // when the wet chain introduces latency, the dry signal is delayed by the same amount to stay in phase
+
+    float* dryChannels[ VST::MAX_CHANNELS ];
+    if ( isDryDelayed ) {
+        for ( int c = 0; c < amountOfChannels; ++c ) {
+            dryChannels[ c ] = _dryBuffer->getBufferForChannel( c );
+        }
+    }
+
+    // write the wet and dry signals into their separate outputs (when requested by the host)
+    // this precedes the mixing as the output buffer can be the same as the input buffer
+
+    if ( wetOutBuffer != nullptr ) {
+        float* wetChannels[ VST::MAX_CHANNELS ];
+        for ( int c = 0; c < amountOfChannels; ++c ) {
+            wetChannels[ c ] = _postMixBuffer->getBufferForChannel( c );
+        }
+        writeAuxiliaryOutput<SampleType, float>( wetChannels, wetOutBuffer, amountOfChannels, bufferSize, _wetMix, wetModulation );
+    }
+
+    // the dry output is written at unity gain (regardless of the dry mix) to allow parallel processing in the host
+
+    if ( dryOutBuffer != nullptr ) {
+        if ( isDryDelayed ) {
+            writeAuxiliaryOutput<SampleType, float>( dryChannels, dryOutBuffer, amountOfChannels, bufferSize, 1.f, nullptr );
+        } else {
+            writeAuxiliaryOutput<SampleType, SampleType>( inBuffer, dryOutBuffer, amountOfChannels, bufferSize, 1.f, nullptr );
+        }
+    }
+
+    // mix the input and processed post mix buffers into the output buffer
+
+    if ( isDryDelayed ) {
+        mixOutput<SampleType, float>( dryChannels, outBuffer, amountOfChannels, bufferSize, mixDry, wetModulation, dryModulation );
+    } else {
+        mixOutput<SampleType, SampleType>( inBuffer, outBuffer, amountOfChannels, bufferSize, mixDry, wetModulation, dryModulation );
+    }
+
+    // output channels without a matching input (should the host not honour the arrangement) are silenced
+
+    for ( int c = amountOfChannels; c < numOutChannels; ++c ) {
+        std::fill( outBuffer[ c ], outBuffer[ c ] + bufferSize, ( SampleType ) 0 );
+        if ( wetOutBuffer != nullptr ) {
+            std::fill( wetOutBuffer[ c ], wetOutBuffer[ c ] + bufferSize, ( SampleType ) 0 );
+        }
+        if ( dryOutBuffer != nullptr ) {
+            std::fill( dryOutBuffer[ c ], dryOutBuffer[ c ] + bufferSize, ( SampleType ) 0 );
         }
     }
 
     // limit the output signal in case its gets hot
     //limiter->process<SampleType>( outBuffer, bufferSize, numOutChannels );
+
+    // final word length reduction
+
+    if ( _outputBitDepth > 0 ) {
+        for ( int32 c = 0; c < amountOfChannels; ++c ) {
+            outputDither->process<SampleType>( outBuffer[ c ], bufferSize, c, _outputBitDepth );
+        }
+    }
 }
 
 template <typename SampleType>
-void PluginProcess::prepareMixBuffers( SampleType** inBuffer, int numInChannels, int bufferSize )
+void PluginProcess::bypass( SampleType** inBuffer, SampleType** outBuffer, int numInChannels, int numOutChannels, int bufferSize )
 {
-    // if the pre mix buffer wasn't created yet or the buffer size has changed
-    // delete existing buffer and create new one to match properties
+    int amountOfChannels = std::min( _amountOfChannels, std::min( numInChannels, numOutChannels ));
+
+    // the input passes through the dry delay (as it would while processing), which keeps its history
+    // continuous so the dry signal remains aligned when the bypass is toggled
+
+    prepareMixBuffers( inBuffer, amountOfChannels, bufferSize );
+
+    dryDelay->setDelay( getLatencySamples() );
+
+    if ( dryDelay->getDelay() > 0 ) {
+        dryDelay->process( _preMixBuffer, _dryBuffer, bufferSize );
+
+        float* dryChannels[ VST::MAX_CHANNELS ];
+        for ( int c = 0; c < amountOfChannels; ++c ) {
+            dryChannels[ c ] = _dryBuffer->getBufferForChannel( c );
+        }
+        writeAuxiliaryOutput<SampleType, float>( dryChannels, outBuffer, amountOfChannels, bufferSize, 1.f, nullptr );
+    } else {
+        dryDelay->write( _preMixBuffer, bufferSize );
 
-    if ( _preMixBuffer == nullptr || _preMixBuffer->bufferSize != bufferSize ) {
-        delete _preMixBuffer;
-        _preMixBuffer = new AudioBuffer( numInChannels, bufferSize );
+        for ( int c = 0; c < amountOfChannels; ++c ) {
+            if ( inBuffer[ c ] != outBuffer[ c ] ) {
+                std::copy( inBuffer[ c ], inBuffer[ c ] + bufferSize, outBuffer[ c ]);
+            }
+        }
+    }
+
+    for ( int c = amountOfChannels; c < numOutChannels; ++c ) {
+        std::fill( outBuffer[ c ], outBuffer[ c ] + bufferSize, ( SampleType ) 0 );
+    }
+}
+
+template <typename SampleType, typename DrySampleType>
+void PluginProcess::mixOutput( DrySampleType** dryBuffer, SampleType** outBuffer, int amountOfChannels, int bufferSize,
+                               bool mixDry, const float* wetModulation, const float* dryModulation )
+{
+    // mono and stereo have dedicated kernels, other layouts are mixed one channel at a time
+
+    switch ( amountOfChannels ) {
+        case 1:
+            mixChannels<SampleType, DrySampleType, 1>( dryBuffer, outBuffer, 0, bufferSize, mixDry, wetModulation, dryModulation );
+            break;
+        case 2:
+            mixChannels<SampleType, DrySampleType, 2>( dryBuffer, outBuffer, 0, bufferSize, mixDry, wetModulation, dryModulation );
+            break;
+        default:
+            for ( int c = 0; c < amountOfChannels; ++c ) {
+                mixChannels<SampleType, DrySampleType, 1>( dryBuffer, outBuffer, c, bufferSize, mixDry, wetModulation, dryModulation );
+            }
+            break;
+    }
+}
+
+template <typename SampleType, typename SourceSampleType>
+void PluginProcess::writeAuxiliaryOutput( SourceSampleType** source, SampleType** outBuffer, int amountOfChannels, int bufferSize,
+                                          float mix, const float* modulation )
+{
+    for ( int c = 0; c < amountOfChannels; ++c )
+    {
+        SourceSampleType* channelSource = source[ c ];
+        SampleType* channelOut          = outBuffer[ c ];
+
+        if ( modulation == nullptr ) {
+            for ( int i = 0; i < bufferSize; ++i ) {
+                channelOut[ i ] = ( SampleType ) channelSource[ i ] * ( SampleType ) mix;
+            }
+        } else {
+            for ( int i = 0; i < bufferSize; ++i ) {
+                channelOut[ i ] = ( SampleType ) channelSource[ i ] * ( SampleType ) Calc::cap( mix + modulation[ i ]);
+            }
+        }
+    }
+}
+
+template <typename SampleType, typename DrySampleType, int CHANNELS>
+void PluginProcess::mixChannels( DrySampleType** dryBuffer, SampleType** outBuffer, int firstChannel, int bufferSize,
+                                 bool mixDry, const float* wetModulation, const float* dryModulation )
+{
+    SampleType dryMix = ( SampleType ) _dryMix;
+    SampleType wetMix = ( SampleType ) _wetMix;
+
+    DrySampleType* channelInBuffers[ CHANNELS ];
+    SampleType* channelOutBuffers  [ CHANNELS ];
+    float* channelPostMixBuffers [ CHANNELS ];
+
+    for ( int c = 0; c < CHANNELS; ++c ) {
+        channelInBuffers[ c ]      = dryBuffer[ firstChannel + c ];
+        channelOutBuffers[ c ]     = outBuffer[ firstChannel + c ];
+        channelPostMixBuffers[ c ] = _postMixBuffer->getBufferForChannel( firstChannel + c );
     }
 
+    for ( int i = 0; i < bufferSize; ++i )
+    {
+        // the (modulated) mix is shared by all channels
+
+        SampleType wet = ( wetModulation == nullptr ) ? wetMix : ( SampleType ) Calc::cap( _wetMix + wetModulation[ i ]);
+        SampleType dry = ( SampleType ) 0;
+        if ( mixDry ) {
+            dry = ( dryModulation == nullptr ) ? dryMix : ( SampleType ) Calc::cap( _dryMix + dryModulation[ i ]);
+        }
+
+        for ( int c = 0; c < CHANNELS; ++c )
+        {
+            // before writing to the out buffer we take a snapshot of the current in sample
+            // value as VST2 in Ableton Live supplies the same buffer for inBuffer and outBuffer!
+            SampleType inSample = ( SampleType ) channelInBuffers[ c ][ i ];
+
+            // wet mix (e.g. the effected signal) and dry mix (e.g. mix in the input signal)
+            channelOutBuffers[ c ][ i ] = ( SampleType ) channelPostMixBuffers[ c ][ i ] * wet + inSample * dry;
+        }
+    }
+}
+
+template <typename SampleType>
+void PluginProcess::prepareMixBuffers( SampleType** inBuffer, int numInChannels, int bufferSize )
+{
     // clone the in buffer contents
     // note the clone is always cast to float as it is
     // used for internal processing (see PluginProcess::process)
@@ -104,13 +321,38 @@ void PluginProcess::prepareMixBuffers( SampleType** inBuffer, int numInChannels,
         }
     }
 
-    // if the post mix buffer wasn't created yet or the buffer size has changed
-    // delete existing buffer and create new one to match properties
+    // channels without a matching input (should the host not honour the arrangement) are silenced
 
-    if ( _postMixBuffer == nullptr || _postMixBuffer->bufferSize != bufferSize ) {
-        delete _postMixBuffer;
-        _postMixBuffer = new AudioBuffer( numInChannels, bufferSize );
+    for ( int c = numInChannels; c < _amountOfChannels; ++c ) {
+        float* outChannelBuffer = _preMixBuffer->getBufferForChannel( c );
+        std::fill( outChannelBuffer, outChannelBuffer + bufferSize, 0.f );
+    }
+}
+
+template <typename SampleType>
+const float* PluginProcess::prepareSidechain( SampleType** sidechainBuffer, int numSidechainChannels, int bufferSize )
+{
+    if ( sidechainBuffer == nullptr || numSidechainChannels == 0 ) {
+        return nullptr;
+    }
+
+    if (( int ) _sidechainLevels.size() < bufferSize ) {
+        _sidechainLevels.resize( bufferSize ); // should not happen as host honours maxSamplesPerBlock
+    }
+
+    // the sidechain is read directly from the hosts buffers, only its level is stored
+
+    float* levels = _sidechainLevels.data();
+    std::fill( levels, levels + bufferSize, 0.f );
+
+    for ( int c = 0; c < numSidechainChannels; ++c )
+    {
+        SampleType* channelBuffer = sidechainBuffer[ c ];
+        for ( int i = 0; i < bufferSize; ++i ) {
+            levels[ i ] = std::max( levels[ i ], ( float ) fabs( channelBuffer[ i ]));
+        }
     }
+    return levels;
 }
 
 }
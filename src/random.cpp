@@ -0,0 +1,101 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "random.h"
+
+namespace Igorski {
+
+/* constructor */
+
+Random::Random( uint32_t seed )
+{
+    // seed the lanes using splitmix32 so that no lane starts in the all-zero state
+
+    for ( int l = 0; l < LANES; ++l )
+    {
+        uint32_t* state[ 4 ] = { &_s0[ l ], &_s1[ l ], &_s2[ l ], &_s3[ l ] };
+
+        for ( int s = 0; s < 4; ++s )
+        {
+            uint32_t z = ( seed += 0x9E3779B9 );
+            z = ( z ^ ( z >> 16 )) * 0x85EBCA6B;
+            z = ( z ^ ( z >> 13 )) * 0xC2B2AE35;
+            *state[ s ] = ( z ^ ( z >> 16 )) | 1;
+        }
+    }
+}
+
+Random::~Random()
+{
+
+}
+
+/* public methods */
+
+void Random::uniform( float* buffer, int bufferSize )
+{
+    int i = 0;
+
+    for ( ; i <= bufferSize - LANES; i += LANES ) {
+        next( buffer + i );
+    }
+
+    // remainder
+
+    if ( i < bufferSize )
+    {
+        float values[ LANES ];
+        next( values );
+
+        for ( int l = 0; i < bufferSize; ++i, ++l ) {
+            buffer[ i ] = values[ l ];
+        }
+    }
+}
+
+void Random::triangular( float* buffer, int bufferSize )
+{
+    float values[ LANES ];
+    int i = 0;
+
+    for ( ; i <= bufferSize - LANES; i += LANES )
+    {
+        next( buffer + i );
+        next( values );
+
+        for ( int l = 0; l < LANES; ++l ) {
+            buffer[ i + l ] = ( buffer[ i + l ] + values[ l ] ) * .5f;
+        }
+    }
+
+    // remainder
+
+    for ( ; i < bufferSize; ++i )
+    {
+        float first[ LANES ];
+        next( first );
+        next( values );
+        buffer[ i ] = ( first[ 0 ] + values[ 0 ] ) * .5f;
+    }
+}
+
+}
@@ -0,0 +1,87 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __RANDOM_H_INCLUDED__
+#define __RANDOM_H_INCLUDED__
+
+#include <stdint.h>
+
+namespace Igorski {
+
+/**
+ * Random provides blocks of pseudo random numbers suitable for use on the
+ * audio thread (e.g. no locking or system calls as is the case with rand())
+ *
+ * The generator is xoshiro128+ running four independent streams side by side,
+ * a whole block is rendered in one pass so the compiler can vectorize the lanes
+ */
+class Random {
+
+    public:
+        Random( uint32_t seed );
+        ~Random();
+
+        // fill given buffer with uniformly distributed values in the -1.f to +1.f range
+
+        void uniform( float* buffer, int bufferSize );
+
+        // fill given buffer with values in the -1.f to +1.f range following a
+        // triangular probability density function (e.g. the sum of two uniform values)
+
+        void triangular( float* buffer, int bufferSize );
+
+    private:
+        static constexpr int LANES = 4;
+
+        uint32_t _s0[ LANES ];
+        uint32_t _s1[ LANES ];
+        uint32_t _s2[ LANES ];
+        uint32_t _s3[ LANES ];
+
+        // advance all lanes, writing a bipolar float for each lane into given output
+
+        inline void next( float* output )
+        {
+            for ( int l = 0; l < LANES; ++l )
+            {
+                uint32_t result = _s0[ l ] + _s3[ l ];
+                uint32_t t      = _s1[ l ] << 9;
+
+                _s2[ l ] ^= _s0[ l ];
+                _s3[ l ] ^= _s1[ l ];
+                _s1[ l ] ^= _s2[ l ];
+                _s0[ l ] ^= _s3[ l ];
+                _s2[ l ] ^= t;
+                _s3[ l ]  = ( _s3[ l ] << 11 ) | ( _s3[ l ] >> 21 );
+
+                // the upper 23 bits form the mantissa of a float in the 1.f - 2.f range
+
+                union { uint32_t i; float f; } bits;
+                bits.i = ( result >> 9 ) | 0x3F800000;
+
+                output[ l ] = bits.f * 2.f - 3.f;
+            }
+        }
+};
+}
+
+#endif
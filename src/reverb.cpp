@@ -0,0 +1,281 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "reverb.h"
+#include "global.h"
+#include "calc.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Igorski {
+
+// delay line lengths (in milliseconds at a size of 1), chosen to be mutually
+// prime-ish so the echoes of the lines do not coincide
+
+static constexpr float LINE_LENGTHS[ Reverb::LINES ] = {
+    31.7f, 37.3f, 41.9f, 47.3f, 53.1f, 59.3f, 67.7f, 73.1f
+};
+
+/* constructor / destructor */
+
+Reverb::Reverb()
+{
+    int longest = ( int ) ceil( LINE_LENGTHS[ LINES - 1 ] * MAX_SIZE * VST::SAMPLE_RATE / 1000.f ) + 1;
+
+    _capacity = 1;
+    while ( _capacity < longest ) {
+        _capacity <<= 1;
+    }
+    _mask = _capacity - 1;
+
+    // lines are spaced a cache line further apart than their power of two capacity, otherwise
+    // the shared write position of all lines would map onto the same cache set
+
+    _stride = _capacity + LINE_PADDING;
+    _buffer.resize(( size_t ) _stride * LINES, 0.f );
+    _writeIndex = 0;
+
+    _size    = .5f;
+    _decay   = .5f;
+    _damping = .5f;
+    _mix     = 0.f;
+
+    _chunk.resize( MAX_CHUNK_SIZE * LINES, 0.f );
+    _wetLeft.resize( MAX_CHUNK_SIZE, 0.f );
+    _wetRight.resize( MAX_CHUNK_SIZE, 0.f );
+
+    cacheLines();
+    reset();
+}
+
+Reverb::~Reverb()
+{
+
+}
+
+/* public methods */
+
+void Reverb::setSize( float value )
+{
+    if ( value == _size ) {
+        return;
+    }
+    _size = Calc::cap( value );
+    cacheLines();
+}
+
+void Reverb::setDecay( float value )
+{
+    if ( value == _decay ) {
+        return;
+    }
+    _decay = Calc::cap( value );
+    cacheLines();
+}
+
+void Reverb::setDamping( float value )
+{
+    if ( value == _damping ) {
+        return;
+    }
+    _damping = Calc::cap( value );
+    cacheLines();
+}
+
+void Reverb::setMix( float value )
+{
+    _mix = Calc::cap( value );
+}
+
+bool Reverb::isActive()
+{
+    return _mix > 0.f;
+}
+
+void Reverb::reset()
+{
+    std::fill( _buffer.begin(), _buffer.end(), 0.f );
+    std::fill( _dampingState, _dampingState + LINES, 0.f );
+}
+
+void Reverb::process( AudioBuffer* buffer, int bufferSize )
+{
+    if ( buffer->amountOfChannels == 0 ) {
+        return;
+    }
+
+    float* left  = buffer->getBufferForChannel( 0 );
+    float* right = buffer->amountOfChannels > 1 ? buffer->getBufferForChannel( 1 ) : left;
+
+    // the feedback written into a line is only read back after the length of the line, as such
+    // chunks no longer than the shortest line can be processed without a dependency between frames
+    // (reading each lines output for the chunk, then writing each lines input for the chunk)
+
+    int maxChunkSize = std::min( MAX_CHUNK_SIZE, *std::min_element( _lengths, _lengths + LINES ));
+
+    for ( int offset = 0; offset < bufferSize; )
+    {
+        int chunkSize = std::min( maxChunkSize, bufferSize - offset );
+
+        processChunk( left + offset, right + offset, right != left, chunkSize );
+
+        offset += chunkSize;
+    }
+}
+
+/* private methods */
+
+void Reverb::cacheLines()
+{
+    float size = MIN_SIZE + _size * ( MAX_SIZE - MIN_SIZE );
+
+    // decay (RT60) is scaled exponentially, high frequencies decay faster according to the damping
+
+    float decay              = MIN_DECAY * powf( MAX_DECAY / MIN_DECAY, _decay );
+    float highFrequencyDecay = decay * ( 1.f - _damping * .9f );
+
+    for ( int l = 0; l < LINES; ++l )
+    {
+        int length = ( int ) ( LINE_LENGTHS[ l ] * size * VST::SAMPLE_RATE / 1000.f );
+        _lengths[ l ] = std::min( _capacity - 1, std::max( 1, length ));
+
+        // gain per pass through the line to decay by 60 dB in the decay time
+
+        float seconds = ( float ) _lengths[ l ] / VST::SAMPLE_RATE;
+        _gains[ l ]   = powf( 10.f, -3.f * seconds / decay );
+
+        // the damping filter attenuates the Nyquist frequency (relative to DC) such that
+        // the high frequencies decay in highFrequencyDecay, e.g. ( 1 - p ) / ( 1 + p ) equals the ratio
+
+        float ratio = powf( 10.f, -3.f * seconds / highFrequencyDecay ) / _gains[ l ];
+        _dampingCoefficients[ l ] = ( 1.f - ratio ) / ( 1.f + ratio );
+    }
+}
+
+void Reverb::processChunk( float* left, float* right, bool isStereo, int chunkSize )
+{
+    // the Householder reflection, output gain normalizes the sum of LINES / 2 lines per channel
+
+    constexpr float REFLECTION = 2.f / ( float ) LINES;
+    constexpr float INPUT_GAIN = .5f;
+    const float outputGain     = 1.f / sqrtf(( float ) LINES * .5f );
+
+    float dry = 1.f - _mix;
+    float wet = _mix;
+
+    // read the output of each line for the chunk (lines[ l ] holds the chunk of line l)
+
+    float* lines[ LINES ];
+
+    for ( int l = 0; l < LINES; ++l )
+    {
+        lines[ l ] = &_chunk[( size_t ) l * MAX_CHUNK_SIZE ];
+
+        const float* line = &_buffer[( size_t ) l * _stride ];
+        int readIndex = ( _writeIndex - _lengths[ l ]) & _mask;
+        int wrapIndex = std::min( chunkSize, _capacity - readIndex );
+
+        std::copy( line + readIndex, line + readIndex + wrapIndex, lines[ l ]);
+        std::copy( line, line + ( chunkSize - wrapIndex ), lines[ l ] + wrapIndex );
+    }
+
+    // damping (one pole low pass per line), the only recursion within the chunk. The line state is
+    // copied into local arrays so the compiler keeps all lanes in registers across the chunk
+
+    alignas( 32 ) float damping[ LINES ];
+    alignas( 32 ) float inverseDamping[ LINES ];
+    alignas( 32 ) float state[ LINES ];
+
+    for ( int l = 0; l < LINES; ++l ) {
+        damping[ l ]        = _dampingCoefficients[ l ];
+        inverseDamping[ l ] = 1.f - _dampingCoefficients[ l ];
+        state[ l ]          = _dampingState[ l ];
+    }
+
+    for ( int i = 0; i < chunkSize; ++i )
+    {
+        for ( int l = 0; l < LINES; ++l ) {
+            state[ l ] = state[ l ] * damping[ l ] + lines[ l ][ i ] * inverseDamping[ l ];
+            lines[ l ][ i ] = state[ l ];
+        }
+    }
+    std::copy( state, state + LINES, _dampingState );
+
+    // mix the outputs through the Householder matrix (I - 2/N * 11T), which only requires the sum
+    // of all lines. Even lines are fed by and summed into the left channel, odd lines into the right.
+    // All loops below are over the samples of the chunk and vectorize without dependencies
+
+    float* wetLeft  = _wetLeft.data();
+    float* wetRight = _wetRight.data();
+
+    std::fill( wetLeft,  wetLeft  + chunkSize, 0.f );
+    std::fill( wetRight, wetRight + chunkSize, 0.f );
+
+    for ( int l = 0; l < LINES; l += 2 )
+    {
+        const float* even = lines[ l ];
+        const float* odd  = lines[ l + 1 ];
+
+        for ( int i = 0; i < chunkSize; ++i ) {
+            wetLeft[ i ]  += even[ i ];
+            wetRight[ i ] += odd[ i ];
+        }
+    }
+
+    for ( int l = 0; l < LINES; l += 2 )
+    {
+        float* even = lines[ l ];
+        float* odd  = lines[ l + 1 ];
+        float evenGain = _gains[ l ];
+        float oddGain  = _gains[ l + 1 ];
+
+        for ( int i = 0; i < chunkSize; ++i ) {
+            float reflection = ( wetLeft[ i ] + wetRight[ i ]) * REFLECTION;
+            even[ i ] = ( even[ i ] - reflection ) * evenGain + left[ i ]  * INPUT_GAIN;
+            odd[ i ]  = ( odd[ i ]  - reflection ) * oddGain  + right[ i ] * INPUT_GAIN;
+        }
+    }
+
+    for ( int i = 0; i < chunkSize; ++i ) {
+        left[ i ] = left[ i ] * dry + wetLeft[ i ] * outputGain * wet;
+    }
+    if ( isStereo ) {
+        for ( int i = 0; i < chunkSize; ++i ) {
+            right[ i ] = right[ i ] * dry + wetRight[ i ] * outputGain * wet;
+        }
+    }
+
+    // write the input of each line for the chunk
+
+    int wrapIndex = std::min( chunkSize, _capacity - _writeIndex );
+
+    for ( int l = 0; l < LINES; ++l )
+    {
+        float* line = &_buffer[( size_t ) l * _stride ];
+
+        std::copy( lines[ l ], lines[ l ] + wrapIndex, line + _writeIndex );
+        std::copy( lines[ l ] + wrapIndex, lines[ l ] + chunkSize, line );
+    }
+    _writeIndex = ( _writeIndex + chunkSize ) & _mask;
+}
+
+}
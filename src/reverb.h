@@ -0,0 +1,113 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __REVERB_H_INCLUDED__
+#define __REVERB_H_INCLUDED__
+
+#include "audiobuffer.h"
+#include <vector>
+
+namespace Igorski {
+/**
+ * Feedback delay network reverb.
+ *
+ * LINES delay lines are fed back into each other through a Householder matrix
+ * (e.g. each line receives its own output minus 2 / LINES times the sum of all outputs),
+ * which is lossless and costs a single sum and multiply-add per line rather than a full
+ * matrix multiplication. Each line has a one pole low pass damping filter and a feedback gain
+ * derived from its length so all lines decay at the same rate.
+ *
+ * The delay lines share a single contiguous block (allocated upon construction, which happens in
+ * setupProcessing) in which each line occupies a power of two region, so all lines share the same write
+ * position. Audio is processed in chunks no longer than the shortest line, as such the feedback written
+ * within a chunk is never read back within that same chunk. This allows the matrix, gain and mixing
+ * stages to be written as loops over the samples of the chunk which the compiler vectorizes, leaving
+ * only the damping filters as a recursion (where the lines are processed side by side as lanes).
+ *
+ * The even lines are fed by (and make up) the left channel, the odd lines the right channel.
+ */
+class Reverb
+{
+    public:
+        static constexpr int LINES          = 8;
+        static constexpr float MIN_SIZE     = .25f; // scale of the delay line lengths
+        static constexpr float MAX_SIZE     = 2.f;
+        static constexpr float MIN_DECAY    = .2f;  // in seconds (RT60)
+        static constexpr float MAX_DECAY    = 10.f;
+
+        Reverb();
+        ~Reverb();
+
+        // the room size in the 0 - 1 range (scales the delay line lengths between MIN_SIZE and MAX_SIZE)
+
+        void setSize( float value );
+
+        // decay time in the 0 - 1 range (exponentially scaled between MIN_DECAY and MAX_DECAY)
+
+        void setDecay( float value );
+
+        // high frequency damping in the 0 - 1 range
+
+        void setDamping( float value );
+
+        // the balance between the input (0) and reverberated signal (1), 0 bypasses the reverb
+
+        void setMix( float value );
+
+        bool isActive();
+
+        void reset();
+
+        // apply the reverb onto the (up to) first two channels of given buffer, in place
+
+        void process( AudioBuffer* buffer, int bufferSize );
+
+    private:
+        float _size;
+        float _decay;
+        float _damping;
+        float _mix;
+
+        int _capacity; // per line, power of two
+        int _mask;
+        int _stride;   // distance between the start of each line
+        int _writeIndex;
+
+        std::vector<float> _buffer; // all lines, each occupying _capacity samples
+        std::vector<float> _chunk;  // the current chunk of each line
+        std::vector<float> _wetLeft;
+        std::vector<float> _wetRight;
+
+        static constexpr int MAX_CHUNK_SIZE = 256;
+        static constexpr int LINE_PADDING   = 16;
+
+        alignas( 32 ) int _lengths[ LINES ];   // in samples
+        alignas( 32 ) float _gains[ LINES ];   // feedback gain per line
+        alignas( 32 ) float _dampingCoefficients[ LINES ];
+        alignas( 32 ) float _dampingState[ LINES ];
+
+        void cacheLines();
+        void processChunk( float* left, float* right, bool isStereo, int chunkSize );
+};
+}
+
+#endif
@@ -0,0 +1,152 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "spectralcrusher.h"
+#include "calc.h"
+#include <cmath>
+
+namespace Igorski {
+
+/* constructor / destructor */
+
+SpectralCrusher::SpectralCrusher( int amountOfChannels )
+{
+    _stft = new STFT( amountOfChannels );
+
+    _mix       = 1.f;
+    _wasActive = false;
+
+    setFrameSize( 2048 );
+    setMagnitudeResolution( 1.f );
+    setPhaseResolution( 1.f );
+}
+
+SpectralCrusher::~SpectralCrusher()
+{
+    delete _stft;
+}
+
+/* public methods */
+
+void SpectralCrusher::setFrameSize( int size )
+{
+    _stft->setFrameSize( size, OVERLAP );
+}
+
+void SpectralCrusher::setMagnitudeResolution( float value )
+{
+    _magnitudeResolution = Calc::cap( value );
+    _magnitudeLevels     = powf( 2.f, 1.f + _magnitudeResolution * ( MAX_BITS - 1.f )) - 1.f;
+
+    cacheActive();
+}
+
+void SpectralCrusher::setPhaseResolution( float value )
+{
+    _phaseResolution = Calc::cap( value );
+    _phaseLevels     = powf( 2.f, 1.f + _phaseResolution * ( MAX_BITS - 1.f ));
+
+    cacheActive();
+}
+
+void SpectralCrusher::setMix( float value )
+{
+    _mix = Calc::cap( value );
+
+    cacheActive();
+}
+
+bool SpectralCrusher::isActive()
+{
+    return _mix > 0.f && ( _magnitudeResolution < 1.f || _phaseResolution < 1.f );
+}
+
+int SpectralCrusher::getLatencySamples()
+{
+    return isActive() ? _stft->getLatencySamples() : 0;
+}
+
+void SpectralCrusher::process( AudioBuffer* buffer, int bufferSize )
+{
+    _stft->process( buffer, bufferSize, [ this ]( float* real, float* imag, int amountOfBins, int /* channel */ ) {
+        crush( real, imag, amountOfBins );
+    });
+}
+
+/* private methods */
+
+void SpectralCrusher::cacheActive()
+{
+    bool active = isActive();
+
+    if ( active && !_wasActive ) {
+        _stft->reset();
+    }
+    _wasActive = active;
+}
+
+void SpectralCrusher::crush( float* real, float* imag, int amountOfBins )
+{
+    float dry = 1.f - _mix;
+    float wet = _mix;
+
+    // magnitudes are quantized relative to the loudest bin
+
+    float peak = 0.f;
+    for ( int i = 0; i < amountOfBins; ++i ) {
+        peak = std::max( peak, real[ i ] * real[ i ] + imag[ i ] * imag[ i ]);
+    }
+    if ( peak == 0.f ) {
+        return;
+    }
+    peak = sqrtf( peak );
+
+    float toLevel   = _magnitudeLevels / peak;
+    float fromLevel = peak / _magnitudeLevels;
+
+    bool crushPhase  = _phaseResolution < 1.f;
+    float toStep     = _phaseLevels / ( 2.f * ( float ) M_PI );
+    float fromStep   = ( 2.f * ( float ) M_PI ) / _phaseLevels;
+
+    for ( int i = 0; i < amountOfBins; ++i )
+    {
+        float magnitude = sqrtf( real[ i ] * real[ i ] + imag[ i ] * imag[ i ]);
+        float crushed   = roundf( magnitude * toLevel ) * fromLevel;
+
+        float crushedReal, crushedImag;
+
+        if ( crushPhase ) {
+            float phase = roundf( atan2f( imag[ i ], real[ i ]) * toStep ) * fromStep;
+            crushedReal = crushed * cosf( phase );
+            crushedImag = crushed * sinf( phase );
+        } else {
+            // retain the phase, scale the bin to the crushed magnitude
+            float scale = magnitude > 0.f ? crushed / magnitude : 0.f;
+            crushedReal = real[ i ] * scale;
+            crushedImag = imag[ i ] * scale;
+        }
+        real[ i ] = real[ i ] * dry + crushedReal * wet;
+        imag[ i ] = imag[ i ] * dry + crushedImag * wet;
+    }
+}
+
+}
@@ -0,0 +1,92 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __SPECTRALCRUSHER_H_INCLUDED__
+#define __SPECTRALCRUSHER_H_INCLUDED__
+
+#include "audiobuffer.h"
+#include "stft.h"
+
+namespace Igorski {
+/**
+ * Bit reduction in the frequency domain: the magnitude and phase of each bin of the
+ * short-time spectrum (see STFT) are quantized to a reduced resolution.
+ *
+ * Magnitudes are quantized relative to the loudest bin of the frame, as such low resolutions
+ * leave only the dominant partials (with a metallic, "low bitrate" character). Phases are
+ * quantized to equal steps around the circle, smearing transients and tonality.
+ *
+ * The crusher adds a latency of one frame size while active (see getLatencySamples()).
+ */
+class SpectralCrusher
+{
+    public:
+        static constexpr int OVERLAP  = 4;  // 75% overlap
+        static constexpr float MAX_BITS = 16.f;
+
+        SpectralCrusher( int amountOfChannels );
+        ~SpectralCrusher();
+
+        // size of the analysis frames, a power of two in the STFT::MIN_SIZE - STFT::MAX_SIZE range
+        // larger sizes increase the frequency resolution at the expense of time resolution (and latency)
+
+        void setFrameSize( int size );
+
+        // resolution in the 0 - 1 range (scaled to 1 - MAX_BITS bits), 1 leaves the magnitudes or phases untouched
+
+        void setMagnitudeResolution( float value );
+        void setPhaseResolution( float value );
+
+        // the balance between the input (0) and crushed signal (1)
+        // (the input is mixed in the spectral domain and thus shares the latency of the crushed signal)
+
+        void setMix( float value );
+
+        // whether the crusher affects the signal (when not, process() need not be called)
+
+        bool isActive();
+
+        int getLatencySamples();
+
+        void process( AudioBuffer* buffer, int bufferSize );
+
+    private:
+        STFT* _stft;
+
+        float _magnitudeResolution;
+        float _phaseResolution;
+        float _mix;
+
+        float _magnitudeLevels; // amount of quantization levels for the magnitude and phase
+        float _phaseLevels;
+
+        // the STFT is not run while inactive, its frames are cleared when becoming active again
+        // so no audio of the previous active period is resynthesized
+
+        bool _wasActive;
+        void cacheActive();
+
+        void crush( float* real, float* imag, int amountOfBins );
+};
+}
+
+#endif
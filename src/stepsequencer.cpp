@@ -0,0 +1,202 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "stepsequencer.h"
+#include "random.h"
+#include <algorithm>
+#include <math.h>
+
+namespace Igorski {
+
+/* constructor */
+
+StepSequencer::StepSequencer()
+{
+    _amountOfSteps = MIN_STEPS;
+    _stepLength    = 1.0;
+    _stepIndex     = 0;
+    _elapsed       = 0;
+    _position      = -1;
+    _origin        = 0;
+    _amountOfRetriggers = 0;
+    _glide         = 0.f;
+    _value         = 0.f;
+
+    std::fill( _steps, _steps + MAX_STEPS, 0.f );
+
+    cacheGlideCoefficient();
+}
+
+StepSequencer::~StepSequencer()
+{
+    // nowt...
+}
+
+/* public methods */
+
+int StepSequencer::getAmountOfSteps()
+{
+    return _amountOfSteps;
+}
+
+void StepSequencer::setAmountOfSteps( int value )
+{
+    _amountOfSteps = std::min( MAX_STEPS, std::max( MIN_STEPS, value ));
+}
+
+float StepSequencer::getStep( int index )
+{
+    return _steps[ index ];
+}
+
+void StepSequencer::setStep( int index, float value )
+{
+    _steps[ index ] = std::min( 1.f, std::max( -1.f, value ));
+}
+
+void StepSequencer::generatePattern( uint32_t seed )
+{
+    Random random( seed );
+    random.uniform( _steps, MAX_STEPS );
+}
+
+void StepSequencer::setStepLength( double samples )
+{
+    // the current step continues (with its progress capped to the new length), when following
+    // the transport the next block realigns the step with the host position (see renderBlock())
+
+    int64_t progress = _elapsed - getStepStart( _stepIndex );
+
+    _stepLength = std::max( 1.0, samples );
+    _elapsed    = getStepStart( _stepIndex ) + std::min( progress, getStepStart( _stepIndex + 1 ) - getStepStart( _stepIndex ) - 1 );
+
+    cacheGlideCoefficient();
+}
+
+void StepSequencer::setGlide( float value )
+{
+    _glide = std::min( 1.f, std::max( 0.f, value ));
+
+    cacheGlideCoefficient();
+}
+
+void StepSequencer::setPosition( int64_t samplePosition )
+{
+    _position = samplePosition;
+}
+
+void StepSequencer::retrigger( int sampleOffset )
+{
+    if ( _amountOfRetriggers < MAX_RETRIGGERS ) {
+        _retriggerOffsets[ _amountOfRetriggers++ ] = std::max( 0, sampleOffset );
+    }
+}
+
+void StepSequencer::renderBlock( float* output, int bufferSize )
+{
+    // derive the step and the progress within it from the transport position (once per block)
+    // relative to the position at which the pattern was last retriggered
+
+    int64_t blockPosition = _position;
+
+    if ( _position >= 0 ) {
+        if ( _origin > _position ) {
+            _origin = 0; // transport moved before the retrigger (e.g. looped), realign with the song
+        }
+        _elapsed  = _position - _origin;
+        _position = -1;
+
+        cacheStepIndex();
+    }
+
+    // render the block in segments, each segment ending at a step boundary, a retrigger (or the end of the block)
+
+    float coefficient = _glideCoefficient;
+    float value       = _value;
+    int retrigger     = 0;
+    int i = 0;
+
+    while ( i < bufferSize )
+    {
+        while ( retrigger < _amountOfRetriggers && _retriggerOffsets[ retrigger ] <= i ) {
+            _stepIndex = 0;
+            _elapsed   = 0;
+            if ( blockPosition >= 0 ) {
+                _origin = blockPosition + i;
+            }
+            ++retrigger;
+        }
+
+        int64_t stepEnd = getStepStart( _stepIndex + 1 );
+        int segmentEnd  = ( int ) std::min(( int64_t ) bufferSize, i + ( stepEnd - _elapsed ));
+        if ( retrigger < _amountOfRetriggers ) {
+            segmentEnd = std::min( segmentEnd, _retriggerOffsets[ retrigger ]);
+        }
+        float target = _steps[ _stepIndex % _amountOfSteps ];
+
+        _elapsed += segmentEnd - i;
+
+        for ( ; i < segmentEnd; ++i ) {
+            value += coefficient * ( target - value );
+            output[ i ] = value;
+        }
+
+        if ( _elapsed == stepEnd ) {
+            ++_stepIndex;
+        }
+    }
+    _value = value;
+    _amountOfRetriggers = 0;
+}
+
+/* private methods */
+
+void StepSequencer::cacheGlideCoefficient()
+{
+    // one-pole coefficient, without glide the output jumps to the step value immediately
+
+    if ( _glide <= 0.f ) {
+        _glideCoefficient = 1.f;
+        return;
+    }
+    _glideCoefficient = 1.f - expf( -1.f / std::max( 1.f, _glide * ( float ) _stepLength ));
+}
+
+int64_t StepSequencer::getStepStart( int64_t stepIndex )
+{
+    return ( int64_t ) ceil(( double ) stepIndex * _stepLength );
+}
+
+void StepSequencer::cacheStepIndex()
+{
+    _stepIndex = ( int64_t ) (( double ) _elapsed / _stepLength );
+
+    // the division can round across a step boundary
+
+    if ( _elapsed >= getStepStart( _stepIndex + 1 )) {
+        ++_stepIndex;
+    } else if ( _elapsed < getStepStart( _stepIndex )) {
+        --_stepIndex;
+    }
+}
+
+}
@@ -0,0 +1,124 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __STEPSEQUENCER_H_INCLUDED__
+#define __STEPSEQUENCER_H_INCLUDED__
+
+#include <stdint.h>
+
+namespace Igorski {
+
+/**
+ * StepSequencer is a tempo synced modulation source cycling through a pattern
+ * of 16 to 64 steps (bipolar, -1 to +1 range), each lasting a fixed amount of samples
+ * The step length is fractional (e.g. 5512.5 samples for a 16th note at 120 BPM and 44.1 kHz),
+ * each step starts on the first sample at or after its exact position so the pattern doesn't drift
+ * from the host grid
+ *
+ * The position within the pattern is derived once per block from the host transport
+ * (see setPosition()), after which renderBlock() walks the block in segments between
+ * the step boundaries, so steps change sample accurately without per-sample division.
+ * When no transport position is provided, the sequencer runs freely from where it left off
+ *
+ * The pattern can be restarted at a sample offset within the next block (see retrigger()),
+ * a restart during playback shifts the pattern relative to the transport from then on
+ *
+ * Changes between steps pass through a one-pole smoother, the glide determines its
+ * time constant relative to the step length (no glide equals instant steps)
+ */
+class StepSequencer
+{
+    public:
+        static constexpr int MIN_STEPS = 16;
+        static constexpr int MAX_STEPS = 64;
+        static constexpr int MAX_RETRIGGERS = 16; // per block
+
+        StepSequencer();
+        ~StepSequencer();
+
+        int getAmountOfSteps();
+        void setAmountOfSteps( int value );
+
+        // step values are in the -1 to +1 range
+
+        float getStep( int index );
+        void setStep( int index, float value );
+
+        // fill all steps with a pseudo random pattern, a given seed always produces the same pattern
+
+        void generatePattern( uint32_t seed );
+
+        // the duration of a single step, in samples (e.g. a 16th note at the current tempo)
+
+        void setStepLength( double samples );
+
+        // glide in the 0 - 1 range, where 1 equals a time constant of a full step
+
+        void setGlide( float value );
+
+        // the transport position (in samples) of the start of the next rendered block
+        // a negative value resumes from the current position
+
+        void setPosition( int64_t samplePosition );
+
+        // restart the pattern at given sample offset within the next rendered block
+        // retriggers are to be scheduled in ascending order of offset
+
+        void retrigger( int sampleOffset );
+
+        /**
+         * render the next bufferSize values of the sequencer into given output
+         * this advances the position by bufferSize samples
+         */
+        void renderBlock( float* output, int bufferSize );
+
+    private:
+        float _steps[ MAX_STEPS ];
+        int _amountOfSteps;
+
+        double _stepLength; // in samples
+        int64_t _stepIndex; // steps elapsed since the pattern (re)started
+        int64_t _elapsed;   // samples elapsed since the pattern (re)started
+
+        int64_t _position; // transport position of the next block, negative when unknown
+        int64_t _origin;   // transport position at which the pattern (re)started
+
+        int _retriggerOffsets[ MAX_RETRIGGERS ];
+        int _amountOfRetriggers;
+
+        float _glide;
+        float _glideCoefficient; // per sample
+        float _value;            // current (smoothed) output value
+
+        void cacheGlideCoefficient();
+
+        // the sample (relative to the pattern start) at which given step starts
+
+        int64_t getStepStart( int64_t stepIndex );
+
+        // derive the step from the elapsed samples
+
+        void cacheStepIndex();
+};
+}
+
+#endif
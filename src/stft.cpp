@@ -0,0 +1,156 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "stft.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Igorski {
+
+/* constructor / destructor */
+
+STFT::STFT( int amountOfChannels )
+{
+    _amountOfChannels = amountOfChannels;
+
+    // the transforms and windows are calculated once for all supported sizes
+
+    for ( int size = MIN_SIZE; size <= MAX_SIZE; size *= 2 )
+    {
+        _ffts.push_back( new FFT( size ));
+
+        // square root of the periodic Hann window, applied upon analysis and resynthesis
+
+        std::vector<float> window( size );
+        for ( int i = 0; i < size; ++i ) {
+            window[ i ] = ( float ) sin( M_PI * i / size );
+        }
+        _windows.push_back( window );
+    }
+
+    _input  = new AudioBuffer( amountOfChannels, MAX_SIZE );
+    _output = new AudioBuffer( amountOfChannels, MAX_SIZE );
+
+    _frame.resize( MAX_SIZE );
+    _real.resize( MAX_SIZE / 2 + 1 );
+    _imag.resize( MAX_SIZE / 2 + 1 );
+
+    _size = 0;
+    setFrameSize( 2048, 4 );
+}
+
+STFT::~STFT()
+{
+    for ( auto fft : _ffts ) {
+        delete fft;
+    }
+    delete _input;
+    delete _output;
+}
+
+/* public methods */
+
+void STFT::setFrameSize( int size, int overlap )
+{
+    size    = std::min( MAX_SIZE, std::max( MIN_SIZE, size ));
+    overlap = std::min( MAX_OVERLAP, std::max( 2, overlap ));
+
+    if ( size == _size && size / overlap == _hopSize ) {
+        return;
+    }
+
+    int index = 0;
+    while (( MIN_SIZE << ( index + 1 )) <= size ) {
+        ++index;
+    }
+    _size    = MIN_SIZE << index;
+    _hopSize = _size / overlap;
+    _fft     = _ffts[ index ];
+    _window  = _windows[ index ].data();
+
+    // the squared windows (e.g. a Hann window) of the overlapping frames sum to overlap / 2
+
+    _outputGain = 2.f / ( float ) overlap;
+
+    reset();
+}
+
+int STFT::getSize()
+{
+    return _size;
+}
+
+int STFT::getHopSize()
+{
+    return _hopSize;
+}
+
+int STFT::getAmountOfBins()
+{
+    return _size / 2 + 1;
+}
+
+int STFT::getLatencySamples()
+{
+    return _size;
+}
+
+void STFT::reset()
+{
+    _input->silenceBuffers();
+    _output->silenceBuffers();
+    _position = 0;
+}
+
+/* private methods */
+
+void STFT::analyse( int channel )
+{
+    float* input = _input->getBufferForChannel( channel );
+    float* frame = _frame.data();
+
+    for ( int i = 0; i < _size; ++i ) {
+        frame[ i ] = input[ i ] * _window[ i ];
+    }
+    _fft->forward( frame, _real.data(), _imag.data() );
+
+    std::copy( input + _hopSize, input + _size, input );
+}
+
+void STFT::resynthesize( int channel )
+{
+    float* output = _output->getBufferForChannel( channel );
+    float* frame  = _frame.data();
+
+    _fft->inverse( _real.data(), _imag.data(), frame );
+
+    // the first hop of the output has been emitted, the next frame overlaps the remainder
+
+    std::copy( output + _hopSize, output + _size, output );
+    std::fill( output + _size - _hopSize, output + _size, 0.f );
+
+    for ( int i = 0; i < _size; ++i ) {
+        output[ i ] += frame[ i ] * _window[ i ] * _outputGain;
+    }
+}
+
+}
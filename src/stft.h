@@ -0,0 +1,118 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __STFT_H_INCLUDED__
+#define __STFT_H_INCLUDED__
+
+#include "audiobuffer.h"
+#include "fft.h"
+#include <algorithm>
+#include <vector>
+
+namespace Igorski {
+/**
+ * Short-time Fourier transform engine, runs a spectral processing stage onto
+ * overlapping frames of the signal and resynthesizes the result by overlap-add.
+ *
+ * Host blocks of any size are adapted to frames of a fixed size: input is collected
+ * until a full hop is available, at which point a frame (spanning the last "size" samples)
+ * is analysed, handed to the stage and added to the output. This introduces a latency
+ * of exactly one frame size (see getLatencySamples()).
+ *
+ * Frames are weighted by a square root Hann window both upon analysis and resynthesis,
+ * so an unmodified spectrum is reconstructed perfectly for all supported overlaps.
+ *
+ * All memory (an FFT and window table for each supported size and all frame buffers)
+ * is allocated upon construction (which happens in setupProcessing), changing the
+ * frame size at runtime merely selects the appropriate tables.
+ */
+class STFT
+{
+    public:
+        static constexpr int MIN_SIZE    = 256;
+        static constexpr int MAX_SIZE    = 4096;
+        static constexpr int MAX_OVERLAP = 8;
+
+        STFT( int amountOfChannels );
+        ~STFT();
+
+        // size is a power of two within the MIN_SIZE - MAX_SIZE range, overlap is the amount of
+        // frames each sample is part of (2, 4 or 8, e.g. the hop size equals size / overlap)
+        // changing either clears the frames
+
+        void setFrameSize( int size, int overlap );
+
+        int getSize();
+        int getHopSize();
+        int getAmountOfBins(); // size / 2 + 1
+
+        // the delay of the resynthesized signal relative to the input, in samples
+
+        int getLatencySamples();
+
+        void reset();
+
+        /**
+         * run given stage for each frame that completes within given bufferSize of input. The stage is
+         * a callable accepting the spectrum of the frame as real and imaginary arrays (see FFT), the amount of
+         * bins and the channel index. It modifies the spectrum in place. The contents of given buffer are
+         * replaced by the resynthesized signal
+         */
+        template <typename Stage>
+        void process( AudioBuffer* buffer, int bufferSize, Stage stage );
+
+    private:
+        int _amountOfChannels;
+        int _size;
+        int _hopSize;
+        int _position;     // amount of samples collected for the next hop
+        float _outputGain; // compensates for the summed windows of overlapping frames
+
+        // for each supported size (in ascending order) the transform and window
+
+        std::vector<FFT*> _ffts;
+        std::vector<std::vector<float>> _windows;
+
+        FFT* _fft;
+        const float* _window;
+
+        AudioBuffer* _input;  // the last "size" samples of input for each channel
+        AudioBuffer* _output; // overlap-add accumulator, the first hop holds completed output
+
+        std::vector<float> _frame;
+        std::vector<float> _real;
+        std::vector<float> _imag;
+
+        // window the most recent frame of given channel and transform it into _real and _imag
+        // after which the input is advanced by a hop
+
+        void analyse( int channel );
+
+        // advance the output of given channel by a hop and add the inverse transform of _real and _imag
+
+        void resynthesize( int channel );
+};
+}
+
+#include "stft.tcc"
+
+#endif
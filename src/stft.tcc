@@ -0,0 +1,70 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+namespace Igorski {
+
+template <typename Stage>
+void STFT::process( AudioBuffer* buffer, int bufferSize, Stage stage )
+{
+    int amountOfChannels = std::min( _amountOfChannels, buffer->amountOfChannels );
+    int amountOfBins     = getAmountOfBins();
+    int offset           = 0;
+
+    while ( offset < bufferSize )
+    {
+        // handle the samples up to the end of the current hop
+
+        int chunkSize = std::min( bufferSize - offset, _hopSize - _position );
+
+        for ( int c = 0; c < amountOfChannels; ++c )
+        {
+            float* channelBuffer = buffer->getBufferForChannel( c ) + offset;
+            float* input         = _input->getBufferForChannel( c ) + ( _size - _hopSize + _position );
+            float* output        = _output->getBufferForChannel( c ) + _position;
+
+            for ( int i = 0; i < chunkSize; ++i ) {
+                input[ i ] = channelBuffer[ i ];
+            }
+            for ( int i = 0; i < chunkSize; ++i ) {
+                channelBuffer[ i ] = output[ i ];
+            }
+        }
+
+        _position += chunkSize;
+        offset    += chunkSize;
+
+        if ( _position < _hopSize ) {
+            break;
+        }
+
+        // hop complete, process the frame ending at the current sample
+
+        for ( int c = 0; c < amountOfChannels; ++c ) {
+            analyse( c );
+            stage( _real.data(), _imag.data(), amountOfBins, c );
+            resynthesize( c );
+        }
+        _position = 0;
+    }
+}
+
+}
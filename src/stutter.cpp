@@ -0,0 +1,310 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "stutter.h"
+#include "calc.h"
+#include <algorithm>
+#include <cstring>
+#include <math.h>
+
+namespace Igorski {
+
+/* constructor */
+
+Stutter::Stutter( int amountOfChannels )
+{
+    _amountOfChannels = amountOfChannels;
+    _fadeLength       = std::max( 1, Calc::secondsToBuffer( FADE_TIME ));
+    _maxRepeat        = ( int ) ceil( MAX_CAPTURE_DURATION * std::min( VST::SAMPLE_RATE, MAX_SAMPLE_RATE ));
+    // the loop crossfade reads ahead of the fragment and a full cycle is recorded before its
+    // transitions are captured, size the history so neither overwrites the start of a fragment
+
+    _capacity = _maxRepeat + _fadeLength + VST::BUFFER_SIZE;
+
+    _history = new AudioBuffer( amountOfChannels, _capacity, AudioBuffer::HALF );
+    _loop    = new AudioBuffer( amountOfChannels, _maxRepeat, AudioBuffer::HALF );
+    _output  = new AudioBuffer( amountOfChannels, VST::BUFFER_SIZE );
+    _tail    = new AudioBuffer( amountOfChannels, _fadeLength );
+
+    _writeIndex       = 0;
+    _readIndex        = 0;
+    _loopLength       = _maxRepeat;
+    _repeatLength     = _maxRepeat;
+    _engaged          = false;
+    _isLooping        = false;
+    _gain             = 0.f;
+
+    _amountOfTransitions = 0;
+    _tailRemaining       = 0;
+}
+
+Stutter::~Stutter()
+{
+    delete _history;
+    delete _loop;
+    delete _output;
+    delete _tail;
+}
+
+/* public methods */
+
+int Stutter::getRepeatLength()
+{
+    return _repeatLength;
+}
+
+void Stutter::setRepeatLength( int samples )
+{
+    _repeatLength = std::min( _maxRepeat, std::max( 1, samples ));
+}
+
+bool Stutter::isEngaged()
+{
+    return _engaged;
+}
+
+void Stutter::setEngaged( bool value, int sampleOffset )
+{
+    if ( value == _engaged ) {
+        return;
+    }
+    _engaged = value;
+    schedule( sampleOffset, value );
+}
+
+void Stutter::retrigger( int sampleOffset )
+{
+    _engaged = true;
+    schedule( sampleOffset, true );
+}
+
+bool Stutter::isActive()
+{
+    return _engaged || _isLooping || _gain > 0.f;
+}
+
+void Stutter::process( AudioBuffer* buffer, int bufferSize )
+{
+    int blockStart = _writeIndex; // history position of the first sample of this cycle
+
+    record( buffer, bufferSize );
+
+    // process in segments in between the scheduled transitions, a captured fragment ends at the
+    // last sample preceding the transition, its repetition starts at the transition
+
+    int offset = 0;
+    for ( int t = 0; t <= _amountOfTransitions; ++t )
+    {
+        int segmentEnd = ( t < _amountOfTransitions ) ? std::min( bufferSize, std::max( offset, _transitions[ t ].offset )) : bufferSize;
+
+        if ( segmentEnd > offset ) {
+            renderSegment( buffer, offset, segmentEnd );
+            offset = segmentEnd;
+        }
+
+        if ( t < _amountOfTransitions ) {
+            if ( _transitions[ t ].engage ) {
+                // when a fragment is audible, keep its continuation to crossfade into the new fragment
+                if ( _isLooping || _gain > 0.f ) {
+                    for ( int c = 0; c < _amountOfChannels; ++c ) {
+                        readLoop( c, _readIndex, _tail->getBufferForChannel( c ), _fadeLength );
+                    }
+                    _tailRemaining = _fadeLength;
+                }
+                capture(( blockStart + offset ) % _capacity );
+            }
+            _isLooping = _transitions[ t ].engage;
+        }
+    }
+    _amountOfTransitions = 0;
+}
+
+/* private methods */
+
+void Stutter::schedule( int sampleOffset, bool engage )
+{
+    // when exceeding the maximum amount of transitions, the last one is replaced
+
+    int index = std::min( _amountOfTransitions, MAX_TRANSITIONS - 1 );
+    _transitions[ index ] = { std::max( 0, sampleOffset ), engage };
+    _amountOfTransitions  = index + 1;
+}
+
+void Stutter::renderSegment( AudioBuffer* buffer, int start, int end )
+{
+    if ( !_isLooping && _gain == 0.f ) {
+        return;
+    }
+    int length           = end - start;
+    int amountOfChannels = std::min( _amountOfChannels, buffer->amountOfChannels );
+
+    // render the repeated fragment
+
+    for ( int c = 0; c < _amountOfChannels; ++c ) {
+        readLoop( c, _readIndex, _output->getBufferForChannel( c ) + start, length );
+    }
+    _readIndex = ( _readIndex + length ) % _loopLength;
+
+    // fade out the continuation of the previous fragment (when recaptured during playback)
+
+    if ( _tailRemaining > 0 )
+    {
+        int remaining = _tailRemaining;
+        for ( int c = 0; c < _amountOfChannels; ++c )
+        {
+            float* outputBuffer = _output->getBufferForChannel( c );
+            float* tailBuffer   = _tail->getBufferForChannel( c );
+
+            remaining = _tailRemaining;
+            for ( int i = start; i < end && remaining > 0; ++i, --remaining ) {
+                float gain = ( float ) remaining / ( float ) _fadeLength;
+                outputBuffer[ i ] += ( tailBuffer[ _fadeLength - remaining ] - outputBuffer[ i ]) * gain;
+            }
+        }
+        _tailRemaining = remaining;
+    }
+
+    // crossfade between the input and the repeated fragment
+
+    float target    = _isLooping ? 1.f : 0.f;
+    float increment = 1.f / ( float ) _fadeLength;
+
+    if ( _gain == target ) {
+        // fully engaged, the fragment replaces the input
+        for ( int c = 0; c < amountOfChannels; ++c ) {
+            memcpy( buffer->getBufferForChannel( c ) + start, _output->getBufferForChannel( c ) + start, length * sizeof( float ));
+        }
+        return;
+    }
+
+    float gain = _gain;
+    for ( int c = 0; c < amountOfChannels; ++c )
+    {
+        float* channelBuffer = buffer->getBufferForChannel( c );
+        float* loopBuffer    = _output->getBufferForChannel( c );
+
+        gain = _gain;
+        for ( int i = start; i < end; ++i ) {
+            gain = ( target > gain ) ? std::min( target, gain + increment ) : std::max( target, gain - increment );
+            channelBuffer[ i ] += ( loopBuffer[ i ] - channelBuffer[ i ]) * gain;
+        }
+    }
+    _gain = gain;
+}
+
+void Stutter::readLoop( int channel, int offset, float* output, int length )
+{
+    while ( length > 0 )
+    {
+        int chunkSize = std::min( length, _loopLength - offset );
+
+        _loop->read( channel, offset, output, chunkSize );
+
+        output += chunkSize;
+        length -= chunkSize;
+        offset  = 0;
+    }
+}
+
+void Stutter::record( AudioBuffer* buffer, int bufferSize )
+{
+    // write the block into the history ring (in at most two segments)
+
+    int amountOfChannels = std::min( _amountOfChannels, buffer->amountOfChannels );
+    int firstSegment     = std::min( bufferSize, _capacity - _writeIndex );
+
+    for ( int c = 0; c < amountOfChannels; ++c )
+    {
+        float* channelBuffer = buffer->getBufferForChannel( c );
+
+        _history->write( c, _writeIndex, channelBuffer, firstSegment );
+        _history->write( c, 0, channelBuffer + firstSegment, bufferSize - firstSegment );
+    }
+    _writeIndex += bufferSize;
+    if ( _writeIndex >= _capacity ) {
+        _writeIndex -= _capacity;
+    }
+}
+
+void Stutter::capture( int endIndex )
+{
+    int length     = _repeatLength;
+    int fadeLength = std::min( _fadeLength, length / 2 );
+
+    // start of the fragment within the history
+
+    int start = endIndex - length;
+    if ( start < 0 ) {
+        start += _capacity;
+    }
+    int firstSegment = std::min( length, _capacity - start );
+
+    // the fragment tail is crossfaded into the signal that preceded the fragment start, as
+    // such the end of the loop leads seamlessly into its beginning
+
+    int fadeStart = start - fadeLength;
+    if ( fadeStart < 0 ) {
+        fadeStart += _capacity;
+    }
+
+    float tail[ FADE_CHUNK_SIZE ];
+    float preceding[ FADE_CHUNK_SIZE ];
+
+    for ( int c = 0; c < _amountOfChannels; ++c )
+    {
+        // both buffers share the same storage, the fragment is copied without conversion
+
+        uint16_t* historyBuffer = _history->getHalfBufferForChannel( c );
+        uint16_t* loopBuffer    = _loop->getHalfBufferForChannel( c );
+
+        memcpy( loopBuffer, historyBuffer + start, firstSegment * sizeof( uint16_t ));
+        memcpy( loopBuffer + firstSegment, historyBuffer, ( length - firstSegment ) * sizeof( uint16_t ));
+
+        // the crossfade is calculated in float, in chunks not wrapping around the history
+
+        for ( int i = 0, r = fadeStart; i < fadeLength; )
+        {
+            if ( r == _capacity ) {
+                r = 0;
+            }
+            int chunkSize  = std::min( FADE_CHUNK_SIZE, std::min( fadeLength - i, _capacity - r ));
+            int tailOffset = length - fadeLength + i;
+
+            _loop->read( c, tailOffset, tail, chunkSize );
+            _history->read( c, r, preceding, chunkSize );
+
+            for ( int j = 0; j < chunkSize; ++j ) {
+                float gain = ( float ) ( i + j + 1 ) / ( float ) fadeLength;
+                tail[ j ] += ( preceding[ j ] - tail[ j ]) * gain;
+            }
+            _loop->write( c, tailOffset, tail, chunkSize );
+
+            i += chunkSize;
+            r += chunkSize;
+        }
+    }
+
+    _loopLength = length;
+    _readIndex  = 0;
+}
+
+}
@@ -0,0 +1,123 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __STUTTER_H_INCLUDED__
+#define __STUTTER_H_INCLUDED__
+
+#include "audiobuffer.h"
+
+namespace Igorski {
+
+/**
+ * Stutter is a beat repeat effect. The incoming signal is recorded continuously into a
+ * history ring, once engaged, the last repeatLength samples are captured into an
+ * AudioBuffer which is repeated (read through AudioBuffer::read()) until disengaged
+ *
+ * The tail of the captured fragment is crossfaded with the signal that preceded it, so
+ * the loop point is seamless. Engaging and disengaging crossfade with the incoming signal
+ * and can be scheduled at a sample offset within the next process cycle
+ *
+ * All buffers are allocated upon construction, their size bounded by MAX_CAPTURE_DURATION
+ * at the current sample rate (up to MAX_SAMPLE_RATE), so capturing does not allocate.
+ * The history and captured fragment are stored as half floats (see AudioBuffer::HALF)
+ */
+class Stutter
+{
+    public:
+        static constexpr float MAX_CAPTURE_DURATION = 4.f;       // in seconds, a 4/4 measure at 60 BPM
+        static constexpr float MAX_SAMPLE_RATE      = 192000.f;
+        static constexpr float FADE_TIME            = .005f;     // in seconds
+        static constexpr int MAX_TRANSITIONS        = 16;        // engage/disengage changes per process cycle
+
+        Stutter( int amountOfChannels );
+        ~Stutter();
+
+        // the length of the repeated fragment in samples (e.g. a beat at the current tempo)
+        // clamped to the capture capacity, changes apply upon the next capture
+
+        int getRepeatLength();
+        void setRepeatLength( int samples );
+
+        // engaging captures the most recently recorded repeatLength samples and repeats them
+        // the change applies at given sample offset within the next process cycle (changes are
+        // to be scheduled in ascending order of offset), isEngaged() reflects the last scheduled state
+
+        bool isEngaged();
+        void setEngaged( bool value, int sampleOffset = 0 );
+
+        // (re)capture the most recently recorded repeatLength samples at given sample offset
+        // within the next process cycle, engaging the stutter when it wasn't already
+
+        void retrigger( int sampleOffset );
+
+        // whether the output is (partially) replaced by the repeated fragment
+
+        bool isActive();
+
+        // records given buffer into the history and (when active) replaces its
+        // contents with the repeated fragment. bufferSize cannot exceed VST::BUFFER_SIZE
+
+        void process( AudioBuffer* buffer, int bufferSize );
+
+    private:
+        int _amountOfChannels;
+        int _capacity;   // size of the history (in samples per channel)
+        int _maxRepeat;  // largest fragment that fits in the history, including its crossfade
+        int _fadeLength; // in samples
+
+        AudioBuffer* _history; // ring of the recorded input (HALF storage)
+        AudioBuffer* _loop;    // captured fragment, allocated at the maximum fragment length (HALF storage)
+        AudioBuffer* _output;  // the repeated fragment for the current process cycle
+        AudioBuffer* _tail;    // continuation of the previous fragment, faded out when recapturing during playback
+
+        int _tailRemaining; // samples of the tail left to fade out
+
+        int _writeIndex;   // write position within the history
+        int _readIndex;    // read position within the loop
+        int _loopLength;   // length of the captured fragment
+        int _repeatLength;
+
+        bool _engaged;   // the last scheduled state
+        bool _isLooping; // the state at the current position within the process cycle
+        float _gain;     // crossfade position between the input (0) and the repeated fragment (1)
+
+        struct Transition {
+            int offset;
+            bool engage; // true (re)captures the fragment
+        };
+        Transition _transitions[ MAX_TRANSITIONS ];
+        int _amountOfTransitions;
+
+        void schedule( int sampleOffset, bool engage );
+        void record( AudioBuffer* buffer, int bufferSize );
+        void capture( int endIndex );
+        void renderSegment( AudioBuffer* buffer, int start, int end );
+
+        // read length samples of the captured fragment from given offset, wrapping at the fragment length
+
+        void readLoop( int channel, int offset, float* output, int length );
+
+        static constexpr int FADE_CHUNK_SIZE = 64; // size of the float chunks used when crossfading the loop point
+};
+}
+
+#endif
@@ -24,6 +24,7 @@
 #include "controller.h"
 #include "uimessagecontroller.h"
 #include "../paramids.h"
+#include "../stft.h"
 
 #include "pluginterfaces/base/ibstream.h"
 #include "pluginterfaces/base/ustring.h"
@@ -40,6 +41,21 @@
 namespace Steinberg {
 namespace Vst {
 
+// names of the LFO waveforms, in order of Igorski::WaveTable::Waveform
+static const char* LFO_WAVEFORM_NAMES[] = { "Sine", "Triangle", "Sawtooth", "Square", "Sample & hold" };
+
+// names of the delay times, in order of Igorski::PluginProcess::DelayTime
+static const char* DELAY_TIME_NAMES[] = { "10 ms", "1/16", "Beat", "1/2 measure", "Measure" };
+
+// names of the stutter lengths, in order of Igorski::PluginProcess::StutterLength
+static const char* STUTTER_LENGTH_NAMES[] = { "1/16", "1/8", "Beat", "1/2 measure", "Measure" };
+
+// names of the delay interpolation modes, in order of Igorski::DelayLine::Interpolation
+static const char* DELAY_INTERPOLATION_NAMES[] = { "Linear", "Cubic", "Allpass" };
+
+// names of the saturation curves, in order of Igorski::Waveshaper::Curve
+static const char* SATURATION_CURVE_NAMES[] = { "Tanh", "Cubic", "Tube" };
+
 //------------------------------------------------------------------------
 // PluginController Implementation
 //------------------------------------------------------------------------
@@ -111,70 +127,692 @@ tresult PLUGIN_API PluginController::initialize( FUnknown* context )
     );
     parameters.addParameter( wetMixParam );
 
-    RangeParameter* dryMixParam = new RangeParameter(
-        USTRING( "Dry mix" ), kDryMixId, USTRING( "%" ),
-        0.f, 1.f, 0.f,
-        0, ParameterInfo::kCanAutomate, unitId
-    );
-    parameters.addParameter( dryMixParam );
+    RangeParameter* dryMixParam = new RangeParameter(
+        USTRING( "Dry mix" ), kDryMixId, USTRING( "%" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( dryMixParam );
+
+    RangeParameter* decimationParam = new RangeParameter(
+        USTRING( "Downsampling" ), kDecimationId, USTRING( "%" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( decimationParam );
+
+    RangeParameter* decimationLfoDepthParam = new RangeParameter(
+        USTRING( "Downsampling LFO depth" ), kDecimationLfoDepthId, USTRING( "%" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( decimationLfoDepthParam );
+
+
+    parameters.addParameter(
+        USTRING( "Dither" ), 0, 1, 0, ParameterInfo::kCanAutomate, kDitherId, unitId
+    );
+
+
+    parameters.addParameter(
+        USTRING( "Noise shaping" ), 0, 1, 0, ParameterInfo::kCanAutomate, kNoiseShapingId, unitId
+    );
+
+
+    parameters.addParameter(
+        USTRING( "16-bit output" ), 0, 1, 0, ParameterInfo::kCanAutomate, kOutputWordLengthId, unitId
+    );
+
+
+    parameters.addParameter(
+        USTRING( "Anti-aliasing" ), 0, 1, 0, ParameterInfo::kCanAutomate, kAntiAliasingId, unitId
+    );
+
+    RangeParameter* bitCrushLfoWaveformParam = new RangeParameter(
+        USTRING( "Bit crush LFO waveform" ), kBitCrushLfoWaveformId, USTRING( "" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( bitCrushLfoWaveformParam );
+
+    RangeParameter* modLfoRateParam = new RangeParameter(
+        USTRING( "Mod LFO rate" ), kModLfoRateId, USTRING( "Hz" ),
+        0.f, 10.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( modLfoRateParam );
+
+    RangeParameter* modLfoDepthParam = new RangeParameter(
+        USTRING( "Mod LFO to downsampling" ), kModLfoDepthId, USTRING( "%" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( modLfoDepthParam );
+
+    RangeParameter* envelopeDepthParam = new RangeParameter(
+        USTRING( "Envelope to resolution" ), kEnvelopeDepthId, USTRING( "%" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( envelopeDepthParam );
+
+    RangeParameter* oversamplingParam = new RangeParameter(
+        USTRING( "Oversampling" ), kOversamplingId, USTRING( "" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( oversamplingParam );
+
+
+    parameters.addParameter(
+        USTRING( "Linear phase" ), 0, 1, 1, ParameterInfo::kCanAutomate, kLinearPhaseId, unitId
+    );
+
+
+    parameters.addParameter(
+        USTRING( "Eco mode" ), 0, 1, 0, ParameterInfo::kCanAutomate, kEcoModeId, unitId
+    );
+
+    RangeParameter* convolutionMixParam = new RangeParameter(
+        USTRING( "Convolution mix" ), kConvolutionMixId, USTRING( "%" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( convolutionMixParam );
+
+    RangeParameter* delayTimeParam = new RangeParameter(
+        USTRING( "Delay time" ), kDelayTimeId, USTRING( "" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( delayTimeParam );
+
+    RangeParameter* delayFeedbackParam = new RangeParameter(
+        USTRING( "Delay feedback" ), kDelayFeedbackId, USTRING( "%" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( delayFeedbackParam );
+
+    RangeParameter* delayMixParam = new RangeParameter(
+        USTRING( "Delay mix" ), kDelayMixId, USTRING( "%" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( delayMixParam );
+
+    RangeParameter* chorusRateParam = new RangeParameter(
+        USTRING( "Delay modulation rate" ), kChorusRateId, USTRING( "Hz" ),
+        0.f, 10.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( chorusRateParam );
+
+    RangeParameter* chorusDepthParam = new RangeParameter(
+        USTRING( "Delay modulation depth" ), kChorusDepthId, USTRING( "%" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( chorusDepthParam );
+
+    RangeParameter* delayInterpolationParam = new RangeParameter(
+        USTRING( "Delay interpolation" ), kDelayInterpolationId, USTRING( "" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( delayInterpolationParam );
+
+    RangeParameter* lowCutParam = new RangeParameter(
+        USTRING( "Low cut" ), kLowCutId, USTRING( "Hz" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( lowCutParam );
+
+    RangeParameter* highCutParam = new RangeParameter(
+        USTRING( "High cut" ), kHighCutId, USTRING( "Hz" ),
+        0.f, 1.f, 1.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( highCutParam );
+
+    RangeParameter* saturationParam = new RangeParameter(
+        USTRING( "Saturation" ), kSaturationId, USTRING( "dB" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( saturationParam );
+
+    RangeParameter* saturationCurveParam = new RangeParameter(
+        USTRING( "Saturation curve" ), kSaturationCurveId, USTRING( "" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( saturationCurveParam );
+
+    RangeParameter* bandsParam = new RangeParameter(
+        USTRING( "Crusher bands" ), kBandsId, USTRING( "" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( bandsParam );
+
+    RangeParameter* crossover1Param = new RangeParameter(
+        USTRING( "Crossover 1" ), kCrossover1Id, USTRING( "Hz" ),
+        0.f, 1.f, 0.27f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( crossover1Param );
+
+    RangeParameter* crossover2Param = new RangeParameter(
+        USTRING( "Crossover 2" ), kCrossover2Id, USTRING( "Hz" ),
+        0.f, 1.f, 0.54f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( crossover2Param );
+
+    RangeParameter* crossover3Param = new RangeParameter(
+        USTRING( "Crossover 3" ), kCrossover3Id, USTRING( "Hz" ),
+        0.f, 1.f, 0.81f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( crossover3Param );
+
+    RangeParameter* band1ResolutionParam = new RangeParameter(
+        USTRING( "Band 1 resolution" ), kBand1ResolutionId, USTRING( "%" ),
+        0.f, 1.f, 1.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( band1ResolutionParam );
+
+    RangeParameter* band2ResolutionParam = new RangeParameter(
+        USTRING( "Band 2 resolution" ), kBand2ResolutionId, USTRING( "%" ),
+        0.f, 1.f, 1.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( band2ResolutionParam );
+
+    RangeParameter* band3ResolutionParam = new RangeParameter(
+        USTRING( "Band 3 resolution" ), kBand3ResolutionId, USTRING( "%" ),
+        0.f, 1.f, 1.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( band3ResolutionParam );
+
+    RangeParameter* band4ResolutionParam = new RangeParameter(
+        USTRING( "Band 4 resolution" ), kBand4ResolutionId, USTRING( "%" ),
+        0.f, 1.f, 1.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( band4ResolutionParam );
+
+    RangeParameter* band1DecimationParam = new RangeParameter(
+        USTRING( "Band 1 downsampling" ), kBand1DecimationId, USTRING( "%" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( band1DecimationParam );
+
+    RangeParameter* band2DecimationParam = new RangeParameter(
+        USTRING( "Band 2 downsampling" ), kBand2DecimationId, USTRING( "%" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( band2DecimationParam );
+
+    RangeParameter* band3DecimationParam = new RangeParameter(
+        USTRING( "Band 3 downsampling" ), kBand3DecimationId, USTRING( "%" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( band3DecimationParam );
+
+    RangeParameter* band4DecimationParam = new RangeParameter(
+        USTRING( "Band 4 downsampling" ), kBand4DecimationId, USTRING( "%" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( band4DecimationParam );
+
+    RangeParameter* reverbMixParam = new RangeParameter(
+        USTRING( "Reverb mix" ), kReverbMixId, USTRING( "%" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( reverbMixParam );
+
+    RangeParameter* reverbSizeParam = new RangeParameter(
+        USTRING( "Reverb size" ), kReverbSizeId, USTRING( "%" ),
+        0.f, 1.f, 0.5f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( reverbSizeParam );
+
+    RangeParameter* reverbDecayParam = new RangeParameter(
+        USTRING( "Reverb decay" ), kReverbDecayId, USTRING( "s" ),
+        0.f, 1.f, 0.5f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( reverbDecayParam );
+
+    RangeParameter* reverbDampingParam = new RangeParameter(
+        USTRING( "Reverb damping" ), kReverbDampingId, USTRING( "%" ),
+        0.f, 1.f, 0.5f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( reverbDampingParam );
+
+    RangeParameter* spectralMagnitudeParam = new RangeParameter(
+        USTRING( "Spectral magnitude resolution" ), kSpectralMagnitudeId, USTRING( "bits" ),
+        0.f, 1.f, 1.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( spectralMagnitudeParam );
+
+    RangeParameter* spectralPhaseParam = new RangeParameter(
+        USTRING( "Spectral phase resolution" ), kSpectralPhaseId, USTRING( "bits" ),
+        0.f, 1.f, 1.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( spectralPhaseParam );
+
+    RangeParameter* spectralMixParam = new RangeParameter(
+        USTRING( "Spectral crusher mix" ), kSpectralMixId, USTRING( "%" ),
+        0.f, 1.f, 1.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( spectralMixParam );
+
+    RangeParameter* spectralSizeParam = new RangeParameter(
+        USTRING( "Spectral frame size" ), kSpectralSizeId, USTRING( "samples" ),
+        0.f, 1.f, 0.75f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( spectralSizeParam );
+
+    RangeParameter* sidechainDuckingParam = new RangeParameter(
+        USTRING( "Sidechain ducking" ), kSidechainDuckingId, USTRING( "%" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( sidechainDuckingParam );
+
+    RangeParameter* sidechainCrushParam = new RangeParameter(
+        USTRING( "Sidechain to resolution" ), kSidechainCrushId, USTRING( "%" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( sidechainCrushParam );
+
+    RangeParameter* sequencerCrushParam = new RangeParameter(
+        USTRING( "Sequencer to resolution" ), kSequencerCrushId, USTRING( "%" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( sequencerCrushParam );
+
+    RangeParameter* sequencerMixParam = new RangeParameter(
+        USTRING( "Sequencer to mix" ), kSequencerMixId, USTRING( "%" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( sequencerMixParam );
+
+    RangeParameter* sequencerStepsParam = new RangeParameter(
+        USTRING( "Sequencer steps" ), kSequencerStepsId, USTRING( "steps" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( sequencerStepsParam );
+
+    RangeParameter* sequencerPatternParam = new RangeParameter(
+        USTRING( "Sequencer pattern" ), kSequencerPatternId, USTRING( "" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( sequencerPatternParam );
+
+    RangeParameter* sequencerGlideParam = new RangeParameter(
+        USTRING( "Sequencer glide" ), kSequencerGlideId, USTRING( "%" ),
+        0.f, 1.f, 0.f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( sequencerGlideParam );
+
+
+    parameters.addParameter(
+        USTRING( "Stutter" ), 0, 1, 0, ParameterInfo::kCanAutomate, kStutterId, unitId
+    );
+
+    RangeParameter* stutterLengthParam = new RangeParameter(
+        USTRING( "Stutter length" ), kStutterLengthId, USTRING( "" ),
+        0.f, 1.f, 0.5f,
+        0, ParameterInfo::kCanAutomate, unitId
+    );
+    parameters.addParameter( stutterLengthParam );
+
+
+// --- AUTO-GENERATED END
+
+    // initialization
+
+    String str( "__PLUGIN_NAME__" );
+    str.copyTo16( defaultMessageText, 0, 127 );
+
+    return result;
+}
+
+//------------------------------------------------------------------------
+tresult PLUGIN_API PluginController::terminate()
+{
+    return EditControllerEx1::terminate ();
+}
+
+//------------------------------------------------------------------------
+tresult PLUGIN_API PluginController::setComponentState( IBStream* state )
+{
+    // we receive the current state of the component (processor part)
+    if ( !state )
+        return kResultFalse;
+
+    IBStreamer streamer( state, kLittleEndian );
+
+    int32 savedBypass = 0;
+    if ( streamer.readInt32( savedBypass ) == false )
+        return kResultFalse;
+    setParamNormalized( kBypassId, savedBypass ? 1 : 0 );
+
+// --- AUTO-GENERATED SETCOMPONENTSTATE START
+
+    float savedBitDepth = 1.f;
+    if ( streamer.readFloat( savedBitDepth ) == false )
+        return kResultFalse;
+    setParamNormalized( kBitDepthId, savedBitDepth );
+
+    float savedBitCrushLfo = 0.f;
+    if ( streamer.readFloat( savedBitCrushLfo ) == false )
+        return kResultFalse;
+    setParamNormalized( kBitCrushLfoId, savedBitCrushLfo );
+
+    float savedBitCrushLfoDepth = 0.f;
+    if ( streamer.readFloat( savedBitCrushLfoDepth ) == false )
+        return kResultFalse;
+    setParamNormalized( kBitCrushLfoDepthId, savedBitCrushLfoDepth );
+
+    float savedWetMix = 1.f;
+    if ( streamer.readFloat( savedWetMix ) == false )
+        return kResultFalse;
+    setParamNormalized( kWetMixId, savedWetMix );
+
+    float savedDryMix = 0.f;
+    if ( streamer.readFloat( savedDryMix ) == false )
+        return kResultFalse;
+    setParamNormalized( kDryMixId, savedDryMix );
+
+    float savedDecimation = 0.f;
+    if ( streamer.readFloat( savedDecimation ) == false )
+        return kResultFalse;
+    setParamNormalized( kDecimationId, savedDecimation );
+
+    float savedDecimationLfoDepth = 0.f;
+    if ( streamer.readFloat( savedDecimationLfoDepth ) == false )
+        return kResultFalse;
+    setParamNormalized( kDecimationLfoDepthId, savedDecimationLfoDepth );
+
+    int32 savedDither = 0;
+    if ( streamer.readInt32( savedDither ) == false )
+        return kResultFalse;
+    setParamNormalized( kDitherId, savedDither ? 1 : 0 );
+
+    int32 savedNoiseShaping = 0;
+    if ( streamer.readInt32( savedNoiseShaping ) == false )
+        return kResultFalse;
+    setParamNormalized( kNoiseShapingId, savedNoiseShaping ? 1 : 0 );
+
+    int32 savedOutputWordLength = 0;
+    if ( streamer.readInt32( savedOutputWordLength ) == false )
+        return kResultFalse;
+    setParamNormalized( kOutputWordLengthId, savedOutputWordLength ? 1 : 0 );
+
+    int32 savedAntiAliasing = 0;
+    if ( streamer.readInt32( savedAntiAliasing ) == false )
+        return kResultFalse;
+    setParamNormalized( kAntiAliasingId, savedAntiAliasing ? 1 : 0 );
+
+    float savedBitCrushLfoWaveform = 0.f;
+    if ( streamer.readFloat( savedBitCrushLfoWaveform ) == false )
+        return kResultFalse;
+    setParamNormalized( kBitCrushLfoWaveformId, savedBitCrushLfoWaveform );
+
+    float savedModLfoRate = 0.f;
+    if ( streamer.readFloat( savedModLfoRate ) == false )
+        return kResultFalse;
+    setParamNormalized( kModLfoRateId, savedModLfoRate );
+
+    float savedModLfoDepth = 0.f;
+    if ( streamer.readFloat( savedModLfoDepth ) == false )
+        return kResultFalse;
+    setParamNormalized( kModLfoDepthId, savedModLfoDepth );
+
+    float savedEnvelopeDepth = 0.f;
+    if ( streamer.readFloat( savedEnvelopeDepth ) == false )
+        return kResultFalse;
+    setParamNormalized( kEnvelopeDepthId, savedEnvelopeDepth );
+
+    float savedOversampling = 0.f;
+    if ( streamer.readFloat( savedOversampling ) == false )
+        return kResultFalse;
+    setParamNormalized( kOversamplingId, savedOversampling );
+
+    int32 savedLinearPhase = 1;
+    if ( streamer.readInt32( savedLinearPhase ) == false )
+        return kResultFalse;
+    setParamNormalized( kLinearPhaseId, savedLinearPhase ? 1 : 0 );
+
+    int32 savedEcoMode = 0;
+    if ( streamer.readInt32( savedEcoMode ) == false )
+        return kResultFalse;
+    setParamNormalized( kEcoModeId, savedEcoMode ? 1 : 0 );
+
+    float savedConvolutionMix = 0.f;
+    if ( streamer.readFloat( savedConvolutionMix ) == false )
+        return kResultFalse;
+    setParamNormalized( kConvolutionMixId, savedConvolutionMix );
+
+    float savedDelayTime = 0.f;
+    if ( streamer.readFloat( savedDelayTime ) == false )
+        return kResultFalse;
+    setParamNormalized( kDelayTimeId, savedDelayTime );
+
+    float savedDelayFeedback = 0.f;
+    if ( streamer.readFloat( savedDelayFeedback ) == false )
+        return kResultFalse;
+    setParamNormalized( kDelayFeedbackId, savedDelayFeedback );
+
+    float savedDelayMix = 0.f;
+    if ( streamer.readFloat( savedDelayMix ) == false )
+        return kResultFalse;
+    setParamNormalized( kDelayMixId, savedDelayMix );
+
+    float savedChorusRate = 0.f;
+    if ( streamer.readFloat( savedChorusRate ) == false )
+        return kResultFalse;
+    setParamNormalized( kChorusRateId, savedChorusRate );
+
+    float savedChorusDepth = 0.f;
+    if ( streamer.readFloat( savedChorusDepth ) == false )
+        return kResultFalse;
+    setParamNormalized( kChorusDepthId, savedChorusDepth );
+
+    float savedDelayInterpolation = 0.f;
+    if ( streamer.readFloat( savedDelayInterpolation ) == false )
+        return kResultFalse;
+    setParamNormalized( kDelayInterpolationId, savedDelayInterpolation );
+
+    float savedLowCut = 0.f;
+    if ( streamer.readFloat( savedLowCut ) == false )
+        return kResultFalse;
+    setParamNormalized( kLowCutId, savedLowCut );
+
+    float savedHighCut = 1.f;
+    if ( streamer.readFloat( savedHighCut ) == false )
+        return kResultFalse;
+    setParamNormalized( kHighCutId, savedHighCut );
+
+    float savedSaturation = 0.f;
+    if ( streamer.readFloat( savedSaturation ) == false )
+        return kResultFalse;
+    setParamNormalized( kSaturationId, savedSaturation );
+
+    float savedSaturationCurve = 0.f;
+    if ( streamer.readFloat( savedSaturationCurve ) == false )
+        return kResultFalse;
+    setParamNormalized( kSaturationCurveId, savedSaturationCurve );
+
+    float savedBands = 0.f;
+    if ( streamer.readFloat( savedBands ) == false )
+        return kResultFalse;
+    setParamNormalized( kBandsId, savedBands );
+
+    float savedCrossover1 = 0.27f;
+    if ( streamer.readFloat( savedCrossover1 ) == false )
+        return kResultFalse;
+    setParamNormalized( kCrossover1Id, savedCrossover1 );
+
+    float savedCrossover2 = 0.54f;
+    if ( streamer.readFloat( savedCrossover2 ) == false )
+        return kResultFalse;
+    setParamNormalized( kCrossover2Id, savedCrossover2 );
+
+    float savedCrossover3 = 0.81f;
+    if ( streamer.readFloat( savedCrossover3 ) == false )
+        return kResultFalse;
+    setParamNormalized( kCrossover3Id, savedCrossover3 );
+
+    float savedBand1Resolution = 1.f;
+    if ( streamer.readFloat( savedBand1Resolution ) == false )
+        return kResultFalse;
+    setParamNormalized( kBand1ResolutionId, savedBand1Resolution );
+
+    float savedBand2Resolution = 1.f;
+    if ( streamer.readFloat( savedBand2Resolution ) == false )
+        return kResultFalse;
+    setParamNormalized( kBand2ResolutionId, savedBand2Resolution );
+
+    float savedBand3Resolution = 1.f;
+    if ( streamer.readFloat( savedBand3Resolution ) == false )
+        return kResultFalse;
+    setParamNormalized( kBand3ResolutionId, savedBand3Resolution );
+
+    float savedBand4Resolution = 1.f;
+    if ( streamer.readFloat( savedBand4Resolution ) == false )
+        return kResultFalse;
+    setParamNormalized( kBand4ResolutionId, savedBand4Resolution );
+
+    float savedBand1Decimation = 0.f;
+    if ( streamer.readFloat( savedBand1Decimation ) == false )
+        return kResultFalse;
+    setParamNormalized( kBand1DecimationId, savedBand1Decimation );
+
+    float savedBand2Decimation = 0.f;
+    if ( streamer.readFloat( savedBand2Decimation ) == false )
+        return kResultFalse;
+    setParamNormalized( kBand2DecimationId, savedBand2Decimation );
+
+    float savedBand3Decimation = 0.f;
+    if ( streamer.readFloat( savedBand3Decimation ) == false )
+        return kResultFalse;
+    setParamNormalized( kBand3DecimationId, savedBand3Decimation );
+
+    float savedBand4Decimation = 0.f;
+    if ( streamer.readFloat( savedBand4Decimation ) == false )
+        return kResultFalse;
+    setParamNormalized( kBand4DecimationId, savedBand4Decimation );
+
+    float savedReverbMix = 0.f;
+    if ( streamer.readFloat( savedReverbMix ) == false )
+        return kResultFalse;
+    setParamNormalized( kReverbMixId, savedReverbMix );
 
+    float savedReverbSize = 0.5f;
+    if ( streamer.readFloat( savedReverbSize ) == false )
+        return kResultFalse;
+    setParamNormalized( kReverbSizeId, savedReverbSize );
 
-// --- AUTO-GENERATED END
+    float savedReverbDecay = 0.5f;
+    if ( streamer.readFloat( savedReverbDecay ) == false )
+        return kResultFalse;
+    setParamNormalized( kReverbDecayId, savedReverbDecay );
 
-    // initialization
+    float savedReverbDamping = 0.5f;
+    if ( streamer.readFloat( savedReverbDamping ) == false )
+        return kResultFalse;
+    setParamNormalized( kReverbDampingId, savedReverbDamping );
 
-    String str( "__PLUGIN_NAME__" );
-    str.copyTo16( defaultMessageText, 0, 127 );
+    float savedSpectralMagnitude = 1.f;
+    if ( streamer.readFloat( savedSpectralMagnitude ) == false )
+        return kResultFalse;
+    setParamNormalized( kSpectralMagnitudeId, savedSpectralMagnitude );
 
-    return result;
-}
+    float savedSpectralPhase = 1.f;
+    if ( streamer.readFloat( savedSpectralPhase ) == false )
+        return kResultFalse;
+    setParamNormalized( kSpectralPhaseId, savedSpectralPhase );
 
-//------------------------------------------------------------------------
-tresult PLUGIN_API PluginController::terminate()
-{
-    return EditControllerEx1::terminate ();
-}
+    float savedSpectralMix = 1.f;
+    if ( streamer.readFloat( savedSpectralMix ) == false )
+        return kResultFalse;
+    setParamNormalized( kSpectralMixId, savedSpectralMix );
 
-//------------------------------------------------------------------------
-tresult PLUGIN_API PluginController::setComponentState( IBStream* state )
-{
-    // we receive the current state of the component (processor part)
-    if ( !state )
+    float savedSpectralSize = 0.75f;
+    if ( streamer.readFloat( savedSpectralSize ) == false )
         return kResultFalse;
+    setParamNormalized( kSpectralSizeId, savedSpectralSize );
 
-    IBStreamer streamer( state, kLittleEndian );
+    float savedSidechainDucking = 0.f;
+    if ( streamer.readFloat( savedSidechainDucking ) == false )
+        return kResultFalse;
+    setParamNormalized( kSidechainDuckingId, savedSidechainDucking );
 
-    int32 savedBypass = 0;
-    if ( streamer.readInt32( savedBypass ) == false )
+    float savedSidechainCrush = 0.f;
+    if ( streamer.readFloat( savedSidechainCrush ) == false )
         return kResultFalse;
-    setParamNormalized( kBypassId, savedBypass ? 1 : 0 );
+    setParamNormalized( kSidechainCrushId, savedSidechainCrush );
 
-// --- AUTO-GENERATED SETCOMPONENTSTATE START
+    float savedSequencerCrush = 0.f;
+    if ( streamer.readFloat( savedSequencerCrush ) == false )
+        return kResultFalse;
+    setParamNormalized( kSequencerCrushId, savedSequencerCrush );
 
-    float savedBitDepth = 1.f;
-    if ( streamer.readFloat( savedBitDepth ) == false )
+    float savedSequencerMix = 0.f;
+    if ( streamer.readFloat( savedSequencerMix ) == false )
         return kResultFalse;
-    setParamNormalized( kBitDepthId, savedBitDepth );
+    setParamNormalized( kSequencerMixId, savedSequencerMix );
 
-    float savedBitCrushLfo = 0.f;
-    if ( streamer.readFloat( savedBitCrushLfo ) == false )
+    float savedSequencerSteps = 0.f;
+    if ( streamer.readFloat( savedSequencerSteps ) == false )
         return kResultFalse;
-    setParamNormalized( kBitCrushLfoId, savedBitCrushLfo );
+    setParamNormalized( kSequencerStepsId, savedSequencerSteps );
 
-    float savedBitCrushLfoDepth = 0.f;
-    if ( streamer.readFloat( savedBitCrushLfoDepth ) == false )
+    float savedSequencerPattern = 0.f;
+    if ( streamer.readFloat( savedSequencerPattern ) == false )
         return kResultFalse;
-    setParamNormalized( kBitCrushLfoDepthId, savedBitCrushLfoDepth );
+    setParamNormalized( kSequencerPatternId, savedSequencerPattern );
 
-    float savedWetMix = 1.f;
-    if ( streamer.readFloat( savedWetMix ) == false )
+    float savedSequencerGlide = 0.f;
+    if ( streamer.readFloat( savedSequencerGlide ) == false )
         return kResultFalse;
-    setParamNormalized( kWetMixId, savedWetMix );
+    setParamNormalized( kSequencerGlideId, savedSequencerGlide );
 
-    float savedDryMix = 0.f;
-    if ( streamer.readFloat( savedDryMix ) == false )
+    int32 savedStutter = 0;
+    if ( streamer.readInt32( savedStutter ) == false )
         return kResultFalse;
-    setParamNormalized( kDryMixId, savedDryMix );
+    setParamNormalized( kStutterId, savedStutter ? 1 : 0 );
+
+    float savedStutterLength = 0.5f;
+    if ( streamer.readFloat( savedStutterLength ) == false )
+        return kResultFalse;
+    setParamNormalized( kStutterLengthId, savedStutterLength );
 
 
 // --- AUTO-GENERATED SETCOMPONENTSTATE END
@@ -268,10 +906,34 @@ tresult PluginController::receiveText( const char* text )
 tresult PLUGIN_API PluginController::setParamNormalized( ParamID tag, ParamValue value )
 {
     // called from host to update our parameters state
+    bool affectsLatency = ( tag == kOversamplingId || tag == kLinearPhaseId || tag == kEcoModeId ) && getParamNormalized( tag ) != value;
+
+    // the spectral crusher only introduces latency while it affects the signal, compare the resulting latency
+    bool affectsSpectralLatency = tag == kSpectralMagnitudeId || tag == kSpectralPhaseId || tag == kSpectralMixId || tag == kSpectralSizeId;
+    int spectralLatency = affectsSpectralLatency ? getSpectralLatency() : 0;
+
     tresult result = EditControllerEx1::setParamNormalized( tag, value );
+
+    if ( affectsSpectralLatency ) {
+        affectsLatency = getSpectralLatency() != spectralLatency;
+    }
+
+    // oversampling, eco mode and spectral crushing introduce latency, request the host to query the processor anew
+    if ( affectsLatency && result == kResultOk && componentHandler != nullptr ) {
+        componentHandler->restartComponent( kLatencyChanged );
+    }
     return result;
 }
 
+//------------------------------------------------------------------------
+int PluginController::getSpectralLatency()
+{
+    bool isActive = getParamNormalized( kSpectralMixId ) > 0.0 && (
+        getParamNormalized( kSpectralMagnitudeId ) < 1.0 || getParamNormalized( kSpectralPhaseId ) < 1.0
+    );
+    return isActive ? Igorski::STFT::MIN_SIZE << ( int ) round( getParamNormalized( kSpectralSizeId ) * 4.0 ) : 0;
+}
+
 //------------------------------------------------------------------------
 tresult PLUGIN_API PluginController::getParamStringByValue( ParamID tag, ParamValue valueNormalized, String128 string )
 {
@@ -283,7 +945,7 @@ tresult PLUGIN_API PluginController::getParamStringByValue( ParamID tag, ParamVa
 // --- AUTO-GENERATED GETPARAM START
 
         case kBitDepthId:
-            sprintf( text, "%.d Bits", ( int ) ( 15 * valueNormalized ) + 1 );
+            sprintf( text, "%.1f Bits", ( float ) ( 15 * valueNormalized ) + 1.f );
             Steinberg::UString( string, 128 ).fromAscii( text );
             return kResultTrue;
 
@@ -307,6 +969,271 @@ tresult PLUGIN_API PluginController::getParamStringByValue( ParamID tag, ParamVa
             Steinberg::UString( string, 128 ).fromAscii( text );
             return kResultTrue;
 
+        case kDecimationId:
+            sprintf( text, "%.2d %%", ( int ) ( valueNormalized * 100.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kDecimationLfoDepthId:
+            sprintf( text, "%.2d %%", ( int ) ( valueNormalized * 100.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kDitherId:
+            sprintf( text, "%s", ( valueNormalized == 0 ) ? "Off" : "On" );
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kNoiseShapingId:
+            sprintf( text, "%s", ( valueNormalized == 0 ) ? "Off" : "On" );
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kOutputWordLengthId:
+            sprintf( text, "%s", ( valueNormalized == 0 ) ? "Off" : "On" );
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kAntiAliasingId:
+            sprintf( text, "%s", ( valueNormalized == 0 ) ? "Off" : "On" );
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kBitCrushLfoWaveformId:
+            sprintf( text, "%s", LFO_WAVEFORM_NAMES[ ( int ) round( valueNormalized * 4.f ) ] );
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kModLfoRateId:
+            sprintf( text, "%.2f Hz", normalizedParamToPlain( tag, valueNormalized ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kModLfoDepthId:
+            sprintf( text, "%.2d %%", ( int ) ( valueNormalized * 100.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kEnvelopeDepthId:
+            sprintf( text, "%.2d %%", ( int ) ( valueNormalized * 100.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kOversamplingId:
+            sprintf( text, "%dx", 1 << ( int ) round( valueNormalized * 3.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kLinearPhaseId:
+            sprintf( text, "%s", ( valueNormalized == 0 ) ? "Off" : "On" );
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kEcoModeId:
+            sprintf( text, "%s", ( valueNormalized == 0 ) ? "Off" : "On" );
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kConvolutionMixId:
+            sprintf( text, "%.2d %%", ( int ) ( valueNormalized * 100.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kDelayTimeId:
+            sprintf( text, "%s", DELAY_TIME_NAMES[ ( int ) round( valueNormalized * 4.f ) ] );
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kDelayFeedbackId:
+            sprintf( text, "%.2d %%", ( int ) ( valueNormalized * 100.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kDelayMixId:
+            sprintf( text, "%.2d %%", ( int ) ( valueNormalized * 100.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kChorusRateId:
+            sprintf( text, "%.2f Hz", normalizedParamToPlain( tag, valueNormalized ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kChorusDepthId:
+            sprintf( text, "%.2d %%", ( int ) ( valueNormalized * 100.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kDelayInterpolationId:
+            sprintf( text, "%s", DELAY_INTERPOLATION_NAMES[ ( int ) round( valueNormalized * 2.f ) ] );
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kLowCutId:
+            sprintf( text, "%.0f Hz", 20.f * pow( 100.f, valueNormalized ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kHighCutId:
+            sprintf( text, "%.0f Hz", 1000.f * pow( 20.f, valueNormalized ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kSaturationId:
+            sprintf( text, "%.1f dB", valueNormalized * 24.f );
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kSaturationCurveId:
+            sprintf( text, "%s", SATURATION_CURVE_NAMES[ ( int ) round( valueNormalized * 2.f ) ] );
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kBandsId:
+            sprintf( text, "%d", 1 + ( int ) round( valueNormalized * 3.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kCrossover1Id:
+            sprintf( text, "%.0f Hz", 40.f * pow( 400.f, valueNormalized ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kCrossover2Id:
+            sprintf( text, "%.0f Hz", 40.f * pow( 400.f, valueNormalized ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kCrossover3Id:
+            sprintf( text, "%.0f Hz", 40.f * pow( 400.f, valueNormalized ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kBand1ResolutionId:
+            sprintf( text, "%.2d %%", ( int ) ( valueNormalized * 100.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kBand2ResolutionId:
+            sprintf( text, "%.2d %%", ( int ) ( valueNormalized * 100.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kBand3ResolutionId:
+            sprintf( text, "%.2d %%", ( int ) ( valueNormalized * 100.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kBand4ResolutionId:
+            sprintf( text, "%.2d %%", ( int ) ( valueNormalized * 100.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kBand1DecimationId:
+            sprintf( text, "%.2d %%", ( int ) ( valueNormalized * 100.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kBand2DecimationId:
+            sprintf( text, "%.2d %%", ( int ) ( valueNormalized * 100.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kBand3DecimationId:
+            sprintf( text, "%.2d %%", ( int ) ( valueNormalized * 100.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kBand4DecimationId:
+            sprintf( text, "%.2d %%", ( int ) ( valueNormalized * 100.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kReverbMixId:
+            sprintf( text, "%.2d %%", ( int ) ( valueNormalized * 100.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kReverbSizeId:
+            sprintf( text, "%.2d %%", ( int ) ( valueNormalized * 100.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kReverbDecayId:
+            sprintf( text, "%.1f s", 0.2f * pow( 50.f, valueNormalized ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kReverbDampingId:
+            sprintf( text, "%.2d %%", ( int ) ( valueNormalized * 100.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kSpectralMagnitudeId:
+            sprintf( text, "%.1f bits", 1.f + valueNormalized * 15.f );
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kSpectralPhaseId:
+            sprintf( text, "%.1f bits", 1.f + valueNormalized * 15.f );
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kSpectralMixId:
+            sprintf( text, "%.2d %%", ( int ) ( valueNormalized * 100.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kSpectralSizeId:
+            sprintf( text, "%d", 256 << ( int ) round( valueNormalized * 4.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kSidechainDuckingId:
+            sprintf( text, "%.2d %%", ( int ) ( valueNormalized * 100.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kSidechainCrushId:
+            sprintf( text, "%.2d %%", ( int ) ( valueNormalized * 100.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kSequencerCrushId:
+            sprintf( text, "%.2d %%", ( int ) ( valueNormalized * 100.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kSequencerMixId:
+            sprintf( text, "%.2d %%", ( int ) ( valueNormalized * 100.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kSequencerStepsId:
+            sprintf( text, "%d steps", 16 * ( 1 + ( int ) round( valueNormalized * 3.f )));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kSequencerPatternId:
+            sprintf( text, "%d", 1 + ( int ) round( valueNormalized * 63.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kSequencerGlideId:
+            sprintf( text, "%.2d %%", ( int ) ( valueNormalized * 100.f ));
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kStutterId:
+            sprintf( text, "%s", ( valueNormalized == 0 ) ? "Off" : "On" );
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
+        case kStutterLengthId:
+            sprintf( text, "%s", STUTTER_LENGTH_NAMES[ ( int ) round( valueNormalized * 4.f ) ] );
+            Steinberg::UString( string, 128 ).fromAscii( text );
+            return kResultTrue;
+
 
 // --- AUTO-GENERATED GETPARAM END
 
@@ -377,14 +1304,24 @@ tresult PLUGIN_API PluginController::queryInterface( const char* iid, void** obj
 tresult PLUGIN_API PluginController::getMidiControllerAssignment( int32 busIndex, int16 /*midiChannel*/,
     CtrlNumber midiControllerNumber, ParamID& tag )
 {
-    // we support for the Gain parameter all MIDI Channel but only first bus (there is only one!)
-/*
-    if ( busIndex == 0 && midiControllerNumber == kCtrlVolume )
+    // MIDI CC's arrive as parameter changes, sharing their timeline with automation and notes (see
+    // __PLUGIN_NAME__::process()). We support all MIDI channels but only the first bus (there is only one!)
+
+    if ( busIndex != 0 )
+        return kResultFalse;
+
+    switch ( midiControllerNumber )
     {
-        tag = kDelayTimeId;
-        return kResultTrue;
+        // the sustain pedal engages the stutter
+        case kCtrlSustainOnOff:
+            tag = kStutterId;
+            return kResultTrue;
+
+        // the modulation wheel sets the depth of the step sequencer onto the resolution
+        case kCtrlModWheel:
+            tag = kSequencerCrushId;
+            return kResultTrue;
     }
-*/
     return kResultFalse;
 }
 
@@ -91,6 +91,11 @@ class PluginController : public EditControllerEx1, public IMidiMapping, public V
         UIMessageControllerList uiMessageControllers;
 
         String128 defaultMessageText;
+
+        // the latency the spectral crusher introduces for the current parameter values
+        // (mirrors Igorski::SpectralCrusher::getLatencySamples())
+
+        int getSpectralLatency();
 };
 
 //------------------------------------------------------------------------
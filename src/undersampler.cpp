@@ -0,0 +1,228 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "undersampler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Igorski {
+
+/* constructor / destructor */
+
+Undersampler::Undersampler( int amountOfChannels, int maxBufferSize )
+{
+    _amountOfChannels = amountOfChannels;
+    _factor           = 1;
+    _amountOfStages   = 0;
+    _phase            = HalfBandFilter::LINEAR_PHASE;
+
+    // the queues can hold up to ( factor - 1 ) samples in addition to a full block
+
+    int maxQueueSize = maxBufferSize + MAX_FACTOR * 2;
+
+    for ( int c = 0; c < amountOfChannels; ++c )
+    {
+        for ( int stage = 0; stage < MAX_STAGES; ++stage )
+        {
+            HalfBandFilter::Response response = ( stage == 0 ) ? HalfBandFilter::STEEP : HalfBandFilter::RELAXED;
+
+            _downsamplers.push_back( new HalfBandFilter( response, _phase, maxQueueSize ));
+            _upsamplers.push_back  ( new HalfBandFilter( response, _phase, maxQueueSize ));
+        }
+    }
+    _input   = new AudioBuffer( amountOfChannels, maxQueueSize );
+    _reduced = new AudioBuffer( amountOfChannels, maxQueueSize );
+    _output  = new AudioBuffer( amountOfChannels, maxQueueSize );
+
+    reset();
+}
+
+Undersampler::~Undersampler()
+{
+    for ( size_t i = 0; i < _downsamplers.size(); ++i ) {
+        delete _downsamplers[ i ];
+        delete _upsamplers[ i ];
+    }
+    delete _input;
+    delete _reduced;
+    delete _output;
+}
+
+/* public methods */
+
+int Undersampler::getFactor()
+{
+    return _factor;
+}
+
+void Undersampler::setFactor( int factor )
+{
+    int amountOfStages = 0;
+    while (( 1 << amountOfStages ) < factor && amountOfStages < MAX_STAGES ) {
+        ++amountOfStages;
+    }
+
+    if ( amountOfStages == _amountOfStages ) {
+        return;
+    }
+    _amountOfStages = amountOfStages;
+    _factor         = 1 << amountOfStages;
+
+    reset();
+}
+
+int Undersampler::getFactorForRate( float sampleRate, float internalRate )
+{
+    int factor = 1;
+    while ( factor < MAX_FACTOR && sampleRate / ( factor * 2 ) >= internalRate ) {
+        factor *= 2;
+    }
+    return factor;
+}
+
+HalfBandFilter::Phase Undersampler::getPhase()
+{
+    return _phase;
+}
+
+void Undersampler::setPhase( HalfBandFilter::Phase phase )
+{
+    if ( phase == _phase ) {
+        return;
+    }
+    _phase = phase;
+
+    for ( size_t i = 0; i < _downsamplers.size(); ++i ) {
+        _downsamplers[ i ]->setPhase( phase );
+        _upsamplers[ i ]->setPhase( phase );
+    }
+}
+
+int Undersampler::getLatencySamples()
+{
+    if ( _factor == 1 ) {
+        return 0;
+    }
+
+    // each stage delays the signal twice (once for down- and once for upsampling)
+    // at its own (higher) rate, which is expressed in samples at the host rate
+
+    float latency = ( float ) ( _factor - 1 );
+
+    for ( int stage = 0; stage < _amountOfStages; ++stage ) {
+        float delay = _downsamplers[ stage ]->getLatency() + _upsamplers[ stage ]->getLatency();
+        latency += delay / ( float ) ( 1 << stage ) * ( _factor / 2 );
+    }
+    return ( int ) round( latency );
+}
+
+/* private methods */
+
+int Undersampler::reduce( AudioBuffer* buffer, int bufferSize )
+{
+    int amountOfChannels = std::min( buffer->amountOfChannels, _amountOfChannels );
+
+    // only whole multiples of the factor can be decimated, the remainder is queued for the next cycle
+
+    int queuedSize  = _queuedInput + bufferSize;
+    int reducedSize = queuedSize / _factor;
+    int consumed    = reducedSize * _factor;
+
+    for ( int c = 0; c < amountOfChannels; ++c )
+    {
+        float* inputBuffer   = _input->getBufferForChannel( c );
+        float* reducedBuffer = _reduced->getBufferForChannel( c );
+        HalfBandFilter** filters = &_downsamplers[ c * MAX_STAGES ];
+
+        std::memcpy( inputBuffer + _queuedInput, buffer->getBufferForChannel( c ), bufferSize * sizeof( float ));
+
+        if ( reducedSize > 0 )
+        {
+            // traverse the cascade from the host rate downwards, halving the contents with each stage
+
+            int stage = _amountOfStages - 1;
+            int size  = consumed / 2;
+
+            filters[ stage ]->downsample( inputBuffer, reducedBuffer, size );
+
+            while ( --stage >= 0 ) {
+                size /= 2;
+                filters[ stage ]->downsample( reducedBuffer, reducedBuffer, size );
+            }
+        }
+        std::memmove( inputBuffer, inputBuffer + consumed, ( queuedSize - consumed ) * sizeof( float ));
+    }
+    _queuedInput = queuedSize - consumed;
+
+    return reducedSize;
+}
+
+void Undersampler::restore( AudioBuffer* buffer, int bufferSize, int reducedSize )
+{
+    int amountOfChannels = std::min( buffer->amountOfChannels, _amountOfChannels );
+    int restoredSize     = reducedSize * _factor;
+
+    for ( int c = 0; c < amountOfChannels; ++c )
+    {
+        float* outputBuffer  = _output->getBufferForChannel( c );
+        float* reducedBuffer = _reduced->getBufferForChannel( c );
+        HalfBandFilter** filters = &_upsamplers[ c * MAX_STAGES ];
+
+        if ( reducedSize > 0 )
+        {
+            // traverse the cascade upwards, doubling the contents with each stage
+            // the final stage appends the restored signal to the output queue
+
+            int size = reducedSize;
+            for ( int stage = 0; stage < _amountOfStages - 1; ++stage, size *= 2 ) {
+                filters[ stage ]->upsample( reducedBuffer, reducedBuffer, size );
+            }
+            filters[ _amountOfStages - 1 ]->upsample( reducedBuffer, outputBuffer + _queuedOutput, size );
+        }
+
+        int remaining = _queuedOutput + restoredSize - bufferSize;
+
+        std::memcpy( buffer->getBufferForChannel( c ), outputBuffer, bufferSize * sizeof( float ));
+        std::memmove( outputBuffer, outputBuffer + bufferSize, remaining * sizeof( float ));
+    }
+    _queuedOutput += restoredSize - bufferSize;
+}
+
+void Undersampler::reset()
+{
+    for ( size_t i = 0; i < _downsamplers.size(); ++i ) {
+        _downsamplers[ i ]->reset();
+        _upsamplers[ i ]->reset();
+    }
+
+    // the output queue is primed with silence so a full block can be provided
+    // on each cycle (the sum of both queues remains constant at ( factor - 1 ))
+
+    _input->silenceBuffers();
+    _output->silenceBuffers();
+
+    _queuedInput  = 0;
+    _queuedOutput = _factor - 1;
+}
+
+}
@@ -0,0 +1,109 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __UNDERSAMPLER_H_INCLUDED__
+#define __UNDERSAMPLER_H_INCLUDED__
+
+#include "audiobuffer.h"
+#include "halfbandfilter.h"
+#include <vector>
+
+namespace Igorski {
+/**
+ * The counterpart of the Oversampler: runs a processing stage at a fraction (1/2, 1/4 or 1/8)
+ * of the host rate by band-limiting and decimating the signal through a cascade of
+ * half-band filters, processing it at the reduced rate and restoring it to the host rate.
+ * This saves processing on high rate sessions for material that doesn't benefit from the bandwidth.
+ *
+ * The stage adjacent to the reduced rate uses a steep filter, the stages operating at the
+ * higher rates a relaxed (shorter) one. As host block sizes need not be a multiple of the factor,
+ * the signal is queued, adding ( factor - 1 ) samples of latency.
+ *
+ * All memory is allocated upon construction (which happens in setupProcessing).
+ */
+class Undersampler
+{
+    public:
+        static constexpr int MAX_FACTOR = 8;
+        static constexpr int MAX_STAGES = 3; // log2( MAX_FACTOR )
+
+        Undersampler( int amountOfChannels, int maxBufferSize );
+        ~Undersampler();
+
+        // factor is either 1 (disables the reduction), 2, 4 or 8
+
+        int getFactor();
+        void setFactor( int factor );
+
+        // retrieve the factor that brings given sample rate closest to (but not below) given internal rate
+
+        static int getFactorForRate( float sampleRate, float internalRate );
+
+        HalfBandFilter::Phase getPhase();
+        void setPhase( HalfBandFilter::Phase phase );
+
+        // the delay introduced by the filters and the queue, in samples at the host rate
+
+        int getLatencySamples();
+
+        /**
+         * run given stage (a callable accepting an AudioBuffer* and the amount of
+         * samples to process) at the reduced rate, the contents of given buffer
+         * are replaced by the stage's output
+         */
+        template <typename Stage>
+        void process( AudioBuffer* buffer, int bufferSize, Stage stage );
+
+    private:
+        int _amountOfChannels;
+        int _factor;
+        int _amountOfStages;
+        HalfBandFilter::Phase _phase;
+
+        // for each channel the filters of each stage, in [ channel * MAX_STAGES + stage ] order
+        // where stage 0 operates adjacent to the reduced rate
+
+        std::vector<HalfBandFilter*> _downsamplers;
+        std::vector<HalfBandFilter*> _upsamplers;
+
+        AudioBuffer* _input;   // queued input at the host rate
+        AudioBuffer* _reduced; // the signal at the reduced rate
+        AudioBuffer* _output;  // queued output at the host rate
+
+        int _queuedInput;      // amount of input samples awaiting reduction (always below the factor)
+        int _queuedOutput;     // amount of output samples available for the next process cycle
+
+        // decimate the input (together with the queue) and return the amount of reduced samples
+
+        int reduce( AudioBuffer* buffer, int bufferSize );
+
+        // restore given amount of reduced samples to the host rate and write the next bufferSize samples into buffer
+
+        void restore( AudioBuffer* buffer, int bufferSize, int reducedSize );
+
+        void reset();
+};
+}
+
+#include "undersampler.tcc"
+
+#endif
@@ -35,11 +35,13 @@
 
 #include "base/source/fstreamer.h"
 
+#include <algorithm>
 #include <stdio.h>
 
 namespace Igorski {
 
 float VST::SAMPLE_RATE = 44100.f; // updated in setupProcessing()
+int VST::BUFFER_SIZE   = 8192;    // updated in setupProcessing()
 
 //------------------------------------------------------------------------
 // Plugin Implementation
@@ -53,6 +55,10 @@ __PLUGIN_NAME__::__PLUGIN_NAME__()
 
     // should be created on setupProcessing, this however doesn't fire for Audio Unit using auval?
     pluginProcess = new PluginProcess( 2 );
+
+    // the timeline is preallocated as it is populated on the audio thread
+    _timeline.reserve( MAX_TIMELINE_EVENTS );
+    _mergeBuffer.reserve( MAX_TIMELINE_EVENTS );
 }
 
 //------------------------------------------------------------------------
@@ -74,6 +80,8 @@ tresult PLUGIN_API __PLUGIN_NAME__::initialize( FUnknown* context )
     //---create Audio In/Out buses------
     addAudioInput ( STR16( "Stereo In" ),  SpeakerArr::kStereo );
     addAudioOutput( STR16( "Stereo Out" ), SpeakerArr::kStereo );
+    addSidechainInput( SpeakerArr::kStereo );
+    addAuxiliaryOutputs( SpeakerArr::kStereo );
 
     //---create Event In/Out buses (1 bus with only 1 channel)------
     addEventInput( STR16( "Event In" ), 1 );
@@ -103,31 +111,27 @@ tresult PLUGIN_API __PLUGIN_NAME__::setActive (TBool state)
 //------------------------------------------------------------------------
 tresult PLUGIN_API __PLUGIN_NAME__::process( ProcessData& data )
 {
-    // In this example there are 4 steps:
-    // 1) Read inputs parameters coming from host (in order to adapt our model values)
-    // 2) Read inputs events coming from host (note on/off events)
+    // In this example there are 3 steps:
+    // 1) Read input parameters and events (note on/off) coming from host into a single timeline
+    // 2) Apply the timeline in order (adapting our model values and retriggering modulation at exact sample offsets)
     // 3) Apply the effect using the input buffer into the output buffer
 
-    //---1) Read input parameter changes-----------
-    IParameterChanges* paramChanges = data.inputParameterChanges;
-    if ( paramChanges )
+    //---1) Read input parameter changes and events-----------
+    collectTimeline( data );
+
+    //---2) Apply the timeline (a single pass over the ordered parameter changes and events)
+    uint32 changedGroups = 0;
+
+    for ( const TimelineEvent& event : _timeline )
     {
-        int32 numParamsChanged = paramChanges->getParameterCount();
-        // for each parameter which are some changes in this audio block:
-        for ( int32 i = 0; i < numParamsChanged; i++ )
+        switch ( event.type )
         {
-            IParamValueQueue* paramQueue = paramChanges->getParameterData( i );
-            if ( paramQueue )
+            case TimelineEvent::PARAMETER:
             {
-                ParamValue value;
-                int32 sampleOffset;
-                int32 numPoints = paramQueue->getPointCount();
-
-                if ( paramQueue->getPoint( numPoints - 1, sampleOffset, value ) != kResultTrue ) {
-                    continue;
-                }
+                ParamValue value = event.value;
+                changedGroups   |= getModelGroups( event.id );
 
-                switch ( paramQueue->getParameterId())
+                switch ( event.id )
                 {
 // --- AUTO-GENERATED PROCESS START
 
@@ -152,33 +156,268 @@ tresult PLUGIN_API __PLUGIN_NAME__::process( ProcessData& data )
                         fDryMix = ( float ) value;
                         break;
 
+                    case kDecimationId:
+                        fDecimation = ( float ) value;
+                        break;
+
+                    case kDecimationLfoDepthId:
+                        fDecimationLfoDepth = ( float ) value;
+                        break;
+
+                    case kDitherId:
+                        fDither = ( value > 0.5f );
+                        break;
+
+                    case kNoiseShapingId:
+                        fNoiseShaping = ( value > 0.5f );
+                        break;
+
+                    case kOutputWordLengthId:
+                        fOutputWordLength = ( value > 0.5f );
+                        break;
+
+                    case kAntiAliasingId:
+                        fAntiAliasing = ( value > 0.5f );
+                        break;
+
+                    case kBitCrushLfoWaveformId:
+                        fBitCrushLfoWaveform = ( float ) value;
+                        break;
+
+                    case kModLfoRateId:
+                        fModLfoRate = ( float ) value;
+                        break;
+
+                    case kModLfoDepthId:
+                        fModLfoDepth = ( float ) value;
+                        break;
+
+                    case kEnvelopeDepthId:
+                        fEnvelopeDepth = ( float ) value;
+                        break;
+
+                    case kOversamplingId:
+                        fOversampling = ( float ) value;
+                        break;
+
+                    case kLinearPhaseId:
+                        fLinearPhase = ( value > 0.5f );
+                        break;
+
+                    case kEcoModeId:
+                        fEcoMode = ( value > 0.5f );
+                        break;
+
+                    case kConvolutionMixId:
+                        fConvolutionMix = ( float ) value;
+                        break;
+
+                    case kDelayTimeId:
+                        fDelayTime = ( float ) value;
+                        break;
+
+                    case kDelayFeedbackId:
+                        fDelayFeedback = ( float ) value;
+                        break;
+
+                    case kDelayMixId:
+                        fDelayMix = ( float ) value;
+                        break;
+
+                    case kChorusRateId:
+                        fChorusRate = ( float ) value;
+                        break;
+
+                    case kChorusDepthId:
+                        fChorusDepth = ( float ) value;
+                        break;
+
+                    case kDelayInterpolationId:
+                        fDelayInterpolation = ( float ) value;
+                        break;
+
+                    case kLowCutId:
+                        fLowCut = ( float ) value;
+                        break;
+
+                    case kHighCutId:
+                        fHighCut = ( float ) value;
+                        break;
+
+                    case kSaturationId:
+                        fSaturation = ( float ) value;
+                        break;
+
+                    case kSaturationCurveId:
+                        fSaturationCurve = ( float ) value;
+                        break;
+
+                    case kBandsId:
+                        fBands = ( float ) value;
+                        break;
+
+                    case kCrossover1Id:
+                        fCrossover1 = ( float ) value;
+                        break;
+
+                    case kCrossover2Id:
+                        fCrossover2 = ( float ) value;
+                        break;
+
+                    case kCrossover3Id:
+                        fCrossover3 = ( float ) value;
+                        break;
+
+                    case kBand1ResolutionId:
+                        fBand1Resolution = ( float ) value;
+                        break;
+
+                    case kBand2ResolutionId:
+                        fBand2Resolution = ( float ) value;
+                        break;
+
+                    case kBand3ResolutionId:
+                        fBand3Resolution = ( float ) value;
+                        break;
+
+                    case kBand4ResolutionId:
+                        fBand4Resolution = ( float ) value;
+                        break;
+
+                    case kBand1DecimationId:
+                        fBand1Decimation = ( float ) value;
+                        break;
+
+                    case kBand2DecimationId:
+                        fBand2Decimation = ( float ) value;
+                        break;
+
+                    case kBand3DecimationId:
+                        fBand3Decimation = ( float ) value;
+                        break;
+
+                    case kBand4DecimationId:
+                        fBand4Decimation = ( float ) value;
+                        break;
+
+                    case kReverbMixId:
+                        fReverbMix = ( float ) value;
+                        break;
+
+                    case kReverbSizeId:
+                        fReverbSize = ( float ) value;
+                        break;
+
+                    case kReverbDecayId:
+                        fReverbDecay = ( float ) value;
+                        break;
+
+                    case kReverbDampingId:
+                        fReverbDamping = ( float ) value;
+                        break;
+
+                    case kSpectralMagnitudeId:
+                        fSpectralMagnitude = ( float ) value;
+                        break;
+
+                    case kSpectralPhaseId:
+                        fSpectralPhase = ( float ) value;
+                        break;
+
+                    case kSpectralMixId:
+                        fSpectralMix = ( float ) value;
+                        break;
+
+                    case kSpectralSizeId:
+                        fSpectralSize = ( float ) value;
+                        break;
+
+                    case kSidechainDuckingId:
+                        fSidechainDucking = ( float ) value;
+                        break;
+
+                    case kSidechainCrushId:
+                        fSidechainCrush = ( float ) value;
+                        break;
+
+                    case kSequencerCrushId:
+                        fSequencerCrush = ( float ) value;
+                        break;
+
+                    case kSequencerMixId:
+                        fSequencerMix = ( float ) value;
+                        break;
+
+                    case kSequencerStepsId:
+                        fSequencerSteps = ( float ) value;
+                        break;
+
+                    case kSequencerPatternId:
+                        fSequencerPattern = ( float ) value;
+                        break;
+
+                    case kSequencerGlideId:
+                        fSequencerGlide = ( float ) value;
+                        break;
+
+                    case kStutterId:
+                        fStutter = ( value > 0.5f );
+                        break;
+
+                    case kStutterLengthId:
+                        fStutterLength = ( float ) value;
+                        break;
+
 // --- AUTO-GENERATED PROCESS END
 
                     case kBypassId:
-                        if ( paramQueue->getPoint( numPoints - 1, sampleOffset, value ) == kResultTrue )
-                            _bypass = ( value > 0.5f );
+                        _bypass = ( value > 0.5f );
                         break;
                 }
-                syncModel();
+                // automation (and the MIDI CC mapped onto it) engages the stutter at its exact position
+                if ( event.id == kStutterId ) {
+                    pluginProcess->stutter->setEngaged( fStutter || _heldNotes > 0, event.sampleOffset );
+                }
+                break;
             }
+            case TimelineEvent::NOTE_ON:
+                // notes restart the modulation sources and (re)capture the stutter at their exact position
+                ++_heldNotes;
+                pluginProcess->modulationMatrix->retrigger( event.sampleOffset );
+                pluginProcess->stutter->retrigger( event.sampleOffset );
+                break;
+
+            case TimelineEvent::NOTE_OFF:
+                // the stutter is released once all notes are released (unless engaged by its parameter)
+                _heldNotes = std::max( 0, _heldNotes - 1 );
+                pluginProcess->stutter->setEngaged( fStutter || _heldNotes > 0, event.sampleOffset );
+                break;
         }
     }
 
+    if ( changedGroups != 0 ) {
+        syncModel( changedGroups );
+    }
+
     // according to docs: processing context (optional, but most welcome)
 
     if ( data.processContext != nullptr ) {
-        // in case you want to do tempo synchronization with the host
-        /*
-        pluginProcess->setTempo(
-            data.processContext->tempo, data.processContext->timeSigNumerator, data.processContext->timeSigDenominator
-        );
-        */
-        // also run synchronization on properties that are tempo dependant here...
-    }
+        // tempo synchronization with the host (updates the tempo synced delay times)
+        // note the tempo and time signature are only valid when flagged so by the host
 
-    //---2) Read input events-------------
-//    IEventList* eventList = data.inputEvents;
+        if (( data.processContext->state & ProcessContext::kTempoValid ) &&
+            ( data.processContext->state & ProcessContext::kTimeSigValid )) {
+            pluginProcess->setTempo(
+                data.processContext->tempo, data.processContext->timeSigNumerator, data.processContext->timeSigDenominator
+            );
+        }
 
+        // keep the step sequencer in step with the song position while the transport is running
+
+        if ( data.processContext->state & ProcessContext::kPlaying ) {
+            pluginProcess->setTransportPosition( data.processContext->projectTimeSamples );
+        }
+    }
 
     //-------------------------------------
     //---3) Process Audio---------------------
@@ -200,18 +439,54 @@ tresult PLUGIN_API __PLUGIN_NAME__::process( ProcessData& data )
 
     // process the incoming sound!
 
+    // the sidechain is only provided when its bus is activated and connected by the host
+    // (its buffers are read in place)
+
+    int32 numSidechainChannels = 0;
+    void** sidechain = nullptr;
+
+    if ( data.numInputs > 1 && data.inputs[ 1 ].numChannels > 0 ) {
+        sidechain = getChannelBuffersPointer( processSetup, data.inputs[ 1 ] );
+        if ( sidechain != nullptr && sidechain[ 0 ] != nullptr ) {
+            numSidechainChannels = data.inputs[ 1 ].numChannels;
+        } else {
+            sidechain = nullptr;
+        }
+    }
+
+    // the wet and dry outputs are only provided when their buses are activated by the host
+    // (written in place by the mixing stage, these follow the arrangement of the main output)
+
+    void** wetOut = nullptr;
+    void** dryOut = nullptr;
+
+    if ( data.numOutputs > 1 && data.outputs[ 1 ].numChannels >= numOutChannels ) {
+        wetOut = getChannelBuffersPointer( processSetup, data.outputs[ 1 ] );
+    }
+    if ( data.numOutputs > 2 && data.outputs[ 2 ].numChannels >= numOutChannels ) {
+        dryOut = getChannelBuffersPointer( processSetup, data.outputs[ 2 ] );
+    }
+
     bool isSilentInput  = data.inputs[ 0 ].silenceFlags != 0;
     bool isSilentOutput = false;
 
     if ( _bypass )
     {
-        // bypass mode, write the input unchanged into the output
-        for ( int32 i = 0, l = std::min( numInChannels, numOutChannels ); i < l; i++ )
-        {
-            if ( in[ i ] != out[ i ] ) {
-                memcpy( out[ i ], in[ i ], sampleFramesSize );
+        // bypass mode, write the input unchanged into the output (delayed by the reported latency)
+        if ( data.symbolicSampleSize == kSample64 ) {
+            pluginProcess->bypass<double>(( double** ) in, ( double** ) out, numInChannels, numOutChannels, data.numSamples );
+        } else {
+            pluginProcess->bypass<float>(( float** ) in, ( float** ) out, numInChannels, numOutChannels, data.numSamples );
+        }
+        // the delayed signal can still sound when the input has become silent
+        isSilentOutput = isSilentInput && pluginProcess->getLatencySamples() == 0;
+        // the wet and dry outputs carry no signal while bypassed
+        for ( int32 b = 1; b < data.numOutputs; b++ ) {
+            void** auxOut = getChannelBuffersPointer( processSetup, data.outputs[ b ] );
+            for ( int32 i = 0; i < data.outputs[ b ].numChannels && auxOut != nullptr; i++ ) {
+                memset( auxOut[ i ], 0, sampleFramesSize );
             }
-            isSilentOutput = isSilentInput;
+            data.outputs[ b ].silenceFlags = (( uint64 ) 1 << data.outputs[ b ].numChannels ) - 1;
         }
     }
     else {
@@ -222,17 +497,23 @@ tresult PLUGIN_API __PLUGIN_NAME__::process( ProcessData& data )
             // 64-bit samples, e.g. Reaper64
             pluginProcess->process<double>(
                 ( double** ) in, ( double** ) out, numInChannels, numOutChannels,
-                data.numSamples, sampleFramesSize
+                data.numSamples, sampleFramesSize, ( double** ) sidechain, numSidechainChannels,
+                ( double** ) wetOut, ( double** ) dryOut
             );
         }
         else {
             // 32-bit samples, e.g. Ableton Live, Bitwig Studio... (oddly enough also when 64-bit?)
             pluginProcess->process<float>(
                 ( float** ) in, ( float** ) out, numInChannels, numOutChannels,
-                data.numSamples, sampleFramesSize
+                data.numSamples, sampleFramesSize, ( float** ) sidechain, numSidechainChannels,
+                ( float** ) wetOut, ( float** ) dryOut
             );
         }
         // update isSilentOutput accordingly
+
+        for ( int32 b = 1; b < data.numOutputs; b++ ) {
+            data.outputs[ b ].silenceFlags = 0;
+        }
     }
 
     // output flags
@@ -244,6 +525,102 @@ tresult PLUGIN_API __PLUGIN_NAME__::process( ProcessData& data )
     return kResultOk;
 }
 
+//------------------------------------------------------------------------
+void __PLUGIN_NAME__::collectTimeline( ProcessData& data )
+{
+    _timeline.clear(); // retains its capacity (see MAX_TIMELINE_EVENTS), no allocation takes place
+
+    // all points of each parameter change queue
+
+    IParameterChanges* paramChanges = data.inputParameterChanges;
+    if ( paramChanges )
+    {
+        int32 numParamsChanged = paramChanges->getParameterCount();
+        for ( int32 i = 0; i < numParamsChanged; i++ )
+        {
+            IParamValueQueue* paramQueue = paramChanges->getParameterData( i );
+            if ( !paramQueue ) {
+                continue;
+            }
+            ParamID id = paramQueue->getParameterId();
+
+            for ( int32 p = 0, numPoints = paramQueue->getPointCount(); p < numPoints; p++ )
+            {
+                ParamValue value;
+                int32 sampleOffset;
+
+                if ( paramQueue->getPoint( p, sampleOffset, value ) == kResultTrue && _timeline.size() < MAX_TIMELINE_EVENTS ) {
+                    _timeline.push_back({ sampleOffset, TimelineEvent::PARAMETER, ( int32 ) id, ( float ) value });
+                }
+            }
+        }
+    }
+
+    // note on and off events
+
+    IEventList* eventList = data.inputEvents;
+    if ( eventList )
+    {
+        Event event;
+        for ( int32 i = 0, numEvents = eventList->getEventCount(); i < numEvents; i++ )
+        {
+            if ( eventList->getEvent( i, event ) != kResultTrue || _timeline.size() >= MAX_TIMELINE_EVENTS ) {
+                continue;
+            }
+            switch ( event.type )
+            {
+                case Event::kNoteOnEvent:
+                    // a note on without velocity equals a note off
+                    _timeline.push_back({
+                        event.sampleOffset, event.noteOn.velocity > 0.f ? TimelineEvent::NOTE_ON : TimelineEvent::NOTE_OFF,
+                        event.noteOn.pitch, event.noteOn.velocity
+                    });
+                    break;
+
+                case Event::kNoteOffEvent:
+                    _timeline.push_back({ event.sampleOffset, TimelineEvent::NOTE_OFF, event.noteOff.pitch, event.noteOff.velocity });
+                    break;
+            }
+        }
+    }
+
+    // order by sample offset. Each queue and the event list are ordered already, so the timeline consists
+    // of k ordered runs which are merged pairwise (a natural merge sort) in O(n log k) without allocating
+    // (the merge buffer is preallocated). Merging is stable: at equal offsets, parameter changes precede
+    // events and points keep the order provided by the host
+
+    size_t size = _timeline.size();
+    _mergeBuffer.resize( size );
+
+    TimelineEvent* source = _timeline.data();
+    TimelineEvent* target = _mergeBuffer.data();
+
+    auto isEarlier = []( const TimelineEvent& a, const TimelineEvent& b ) {
+        return a.sampleOffset < b.sampleOffset;
+    };
+    auto getRunEnd = [ size, &isEarlier ]( const TimelineEvent* events, size_t start ) {
+        while ( ++start < size && !isEarlier( events[ start ], events[ start - 1 ])) {}
+        return start;
+    };
+
+    while ( size > 0 && getRunEnd( source, 0 ) < size )
+    {
+        for ( size_t start = 0; start < size; )
+        {
+            size_t middle = getRunEnd( source, start );
+            size_t end    = middle < size ? getRunEnd( source, middle ) : size;
+
+            std::merge( source + start, source + middle, source + middle, source + end, target + start, isEarlier );
+            start = end;
+        }
+        std::swap( source, target );
+    }
+
+    if ( source != _timeline.data() ) {
+        std::copy( source, source + size, _timeline.data() );
+    }
+}
+
 //------------------------------------------------------------------------
 tresult __PLUGIN_NAME__::receiveText( const char* text )
 {
@@ -288,6 +665,218 @@ tresult PLUGIN_API __PLUGIN_NAME__::setState( IBStream* state )
     if ( streamer.readFloat( savedDryMix ) == false )
         return kResultFalse;
 
+    float savedDecimation = 0.f;
+    if ( streamer.readFloat( savedDecimation ) == false )
+        return kResultFalse;
+
+    float savedDecimationLfoDepth = 0.f;
+    if ( streamer.readFloat( savedDecimationLfoDepth ) == false )
+        return kResultFalse;
+
+    int32 savedDither = 0;
+    if ( streamer.readInt32( savedDither ) == false )
+        return kResultFalse;
+
+    int32 savedNoiseShaping = 0;
+    if ( streamer.readInt32( savedNoiseShaping ) == false )
+        return kResultFalse;
+
+    int32 savedOutputWordLength = 0;
+    if ( streamer.readInt32( savedOutputWordLength ) == false )
+        return kResultFalse;
+
+    int32 savedAntiAliasing = 0;
+    if ( streamer.readInt32( savedAntiAliasing ) == false )
+        return kResultFalse;
+
+    float savedBitCrushLfoWaveform = 0.f;
+    if ( streamer.readFloat( savedBitCrushLfoWaveform ) == false )
+        return kResultFalse;
+
+    float savedModLfoRate = 0.f;
+    if ( streamer.readFloat( savedModLfoRate ) == false )
+        return kResultFalse;
+
+    float savedModLfoDepth = 0.f;
+    if ( streamer.readFloat( savedModLfoDepth ) == false )
+        return kResultFalse;
+
+    float savedEnvelopeDepth = 0.f;
+    if ( streamer.readFloat( savedEnvelopeDepth ) == false )
+        return kResultFalse;
+
+    float savedOversampling = 0.f;
+    if ( streamer.readFloat( savedOversampling ) == false )
+        return kResultFalse;
+
+    int32 savedLinearPhase = 0;
+    if ( streamer.readInt32( savedLinearPhase ) == false )
+        return kResultFalse;
+
+    int32 savedEcoMode = 0;
+    if ( streamer.readInt32( savedEcoMode ) == false )
+        return kResultFalse;
+
+    float savedConvolutionMix = 0.f;
+    if ( streamer.readFloat( savedConvolutionMix ) == false )
+        return kResultFalse;
+
+    float savedDelayTime = 0.f;
+    if ( streamer.readFloat( savedDelayTime ) == false )
+        return kResultFalse;
+
+    float savedDelayFeedback = 0.f;
+    if ( streamer.readFloat( savedDelayFeedback ) == false )
+        return kResultFalse;
+
+    float savedDelayMix = 0.f;
+    if ( streamer.readFloat( savedDelayMix ) == false )
+        return kResultFalse;
+
+    float savedChorusRate = 0.f;
+    if ( streamer.readFloat( savedChorusRate ) == false )
+        return kResultFalse;
+
+    float savedChorusDepth = 0.f;
+    if ( streamer.readFloat( savedChorusDepth ) == false )
+        return kResultFalse;
+
+    float savedDelayInterpolation = 0.f;
+    if ( streamer.readFloat( savedDelayInterpolation ) == false )
+        return kResultFalse;
+
+    float savedLowCut = 0.f;
+    if ( streamer.readFloat( savedLowCut ) == false )
+        return kResultFalse;
+
+    float savedHighCut = 0.f;
+    if ( streamer.readFloat( savedHighCut ) == false )
+        return kResultFalse;
+
+    float savedSaturation = 0.f;
+    if ( streamer.readFloat( savedSaturation ) == false )
+        return kResultFalse;
+
+    float savedSaturationCurve = 0.f;
+    if ( streamer.readFloat( savedSaturationCurve ) == false )
+        return kResultFalse;
+
+    float savedBands = 0.f;
+    if ( streamer.readFloat( savedBands ) == false )
+        return kResultFalse;
+
+    float savedCrossover1 = 0.f;
+    if ( streamer.readFloat( savedCrossover1 ) == false )
+        return kResultFalse;
+
+    float savedCrossover2 = 0.f;
+    if ( streamer.readFloat( savedCrossover2 ) == false )
+        return kResultFalse;
+
+    float savedCrossover3 = 0.f;
+    if ( streamer.readFloat( savedCrossover3 ) == false )
+        return kResultFalse;
+
+    float savedBand1Resolution = 0.f;
+    if ( streamer.readFloat( savedBand1Resolution ) == false )
+        return kResultFalse;
+
+    float savedBand2Resolution = 0.f;
+    if ( streamer.readFloat( savedBand2Resolution ) == false )
+        return kResultFalse;
+
+    float savedBand3Resolution = 0.f;
+    if ( streamer.readFloat( savedBand3Resolution ) == false )
+        return kResultFalse;
+
+    float savedBand4Resolution = 0.f;
+    if ( streamer.readFloat( savedBand4Resolution ) == false )
+        return kResultFalse;
+
+    float savedBand1Decimation = 0.f;
+    if ( streamer.readFloat( savedBand1Decimation ) == false )
+        return kResultFalse;
+
+    float savedBand2Decimation = 0.f;
+    if ( streamer.readFloat( savedBand2Decimation ) == false )
+        return kResultFalse;
+
+    float savedBand3Decimation = 0.f;
+    if ( streamer.readFloat( savedBand3Decimation ) == false )
+        return kResultFalse;
+
+    float savedBand4Decimation = 0.f;
+    if ( streamer.readFloat( savedBand4Decimation ) == false )
+        return kResultFalse;
+
+    float savedReverbMix = 0.f;
+    if ( streamer.readFloat( savedReverbMix ) == false )
+        return kResultFalse;
+
+    float savedReverbSize = 0.f;
+    if ( streamer.readFloat( savedReverbSize ) == false )
+        return kResultFalse;
+
+    float savedReverbDecay = 0.f;
+    if ( streamer.readFloat( savedReverbDecay ) == false )
+        return kResultFalse;
+
+    float savedReverbDamping = 0.f;
+    if ( streamer.readFloat( savedReverbDamping ) == false )
+        return kResultFalse;
+
+    float savedSpectralMagnitude = 0.f;
+    if ( streamer.readFloat( savedSpectralMagnitude ) == false )
+        return kResultFalse;
+
+    float savedSpectralPhase = 0.f;
+    if ( streamer.readFloat( savedSpectralPhase ) == false )
+        return kResultFalse;
+
+    float savedSpectralMix = 0.f;
+    if ( streamer.readFloat( savedSpectralMix ) == false )
+        return kResultFalse;
+
+    float savedSpectralSize = 0.f;
+    if ( streamer.readFloat( savedSpectralSize ) == false )
+        return kResultFalse;
+
+    float savedSidechainDucking = 0.f;
+    if ( streamer.readFloat( savedSidechainDucking ) == false )
+        return kResultFalse;
+
+    float savedSidechainCrush = 0.f;
+    if ( streamer.readFloat( savedSidechainCrush ) == false )
+        return kResultFalse;
+
+    float savedSequencerCrush = 0.f;
+    if ( streamer.readFloat( savedSequencerCrush ) == false )
+        return kResultFalse;
+
+    float savedSequencerMix = 0.f;
+    if ( streamer.readFloat( savedSequencerMix ) == false )
+        return kResultFalse;
+
+    float savedSequencerSteps = 0.f;
+    if ( streamer.readFloat( savedSequencerSteps ) == false )
+        return kResultFalse;
+
+    float savedSequencerPattern = 0.f;
+    if ( streamer.readFloat( savedSequencerPattern ) == false )
+        return kResultFalse;
+
+    float savedSequencerGlide = 0.f;
+    if ( streamer.readFloat( savedSequencerGlide ) == false )
+        return kResultFalse;
+
+    int32 savedStutter = 0;
+    if ( streamer.readInt32( savedStutter ) == false )
+        return kResultFalse;
+
+    float savedStutterLength = 0.f;
+    if ( streamer.readFloat( savedStutterLength ) == false )
+        return kResultFalse;
+
 
 // --- AUTO-GENERATED SETSTATE END
 
@@ -300,6 +889,59 @@ tresult PLUGIN_API __PLUGIN_NAME__::setState( IBStream* state )
     fBitCrushLfoDepth = savedBitCrushLfoDepth;
     fWetMix = savedWetMix;
     fDryMix = savedDryMix;
+    fDecimation = savedDecimation;
+    fDecimationLfoDepth = savedDecimationLfoDepth;
+    fDither = savedDither > 0;
+    fNoiseShaping = savedNoiseShaping > 0;
+    fOutputWordLength = savedOutputWordLength > 0;
+    fAntiAliasing = savedAntiAliasing > 0;
+    fBitCrushLfoWaveform = savedBitCrushLfoWaveform;
+    fModLfoRate = savedModLfoRate;
+    fModLfoDepth = savedModLfoDepth;
+    fEnvelopeDepth = savedEnvelopeDepth;
+    fOversampling = savedOversampling;
+    fLinearPhase = savedLinearPhase > 0;
+    fEcoMode = savedEcoMode > 0;
+    fConvolutionMix = savedConvolutionMix;
+    fDelayTime = savedDelayTime;
+    fDelayFeedback = savedDelayFeedback;
+    fDelayMix = savedDelayMix;
+    fChorusRate = savedChorusRate;
+    fChorusDepth = savedChorusDepth;
+    fDelayInterpolation = savedDelayInterpolation;
+    fLowCut = savedLowCut;
+    fHighCut = savedHighCut;
+    fSaturation = savedSaturation;
+    fSaturationCurve = savedSaturationCurve;
+    fBands = savedBands;
+    fCrossover1 = savedCrossover1;
+    fCrossover2 = savedCrossover2;
+    fCrossover3 = savedCrossover3;
+    fBand1Resolution = savedBand1Resolution;
+    fBand2Resolution = savedBand2Resolution;
+    fBand3Resolution = savedBand3Resolution;
+    fBand4Resolution = savedBand4Resolution;
+    fBand1Decimation = savedBand1Decimation;
+    fBand2Decimation = savedBand2Decimation;
+    fBand3Decimation = savedBand3Decimation;
+    fBand4Decimation = savedBand4Decimation;
+    fReverbMix = savedReverbMix;
+    fReverbSize = savedReverbSize;
+    fReverbDecay = savedReverbDecay;
+    fReverbDamping = savedReverbDamping;
+    fSpectralMagnitude = savedSpectralMagnitude;
+    fSpectralPhase = savedSpectralPhase;
+    fSpectralMix = savedSpectralMix;
+    fSpectralSize = savedSpectralSize;
+    fSidechainDucking = savedSidechainDucking;
+    fSidechainCrush = savedSidechainCrush;
+    fSequencerCrush = savedSequencerCrush;
+    fSequencerMix = savedSequencerMix;
+    fSequencerSteps = savedSequencerSteps;
+    fSequencerPattern = savedSequencerPattern;
+    fSequencerGlide = savedSequencerGlide;
+    fStutter = savedStutter > 0;
+    fStutterLength = savedStutterLength;
 
 // --- AUTO-GENERATED SETSTATE APPLY END
 
@@ -354,6 +996,59 @@ tresult PLUGIN_API __PLUGIN_NAME__::getState( IBStream* state )
     streamer.writeFloat( fBitCrushLfoDepth );
     streamer.writeFloat( fWetMix );
     streamer.writeFloat( fDryMix );
+    streamer.writeFloat( fDecimation );
+    streamer.writeFloat( fDecimationLfoDepth );
+    streamer.writeInt32( fDither ? 1 : 0 );
+    streamer.writeInt32( fNoiseShaping ? 1 : 0 );
+    streamer.writeInt32( fOutputWordLength ? 1 : 0 );
+    streamer.writeInt32( fAntiAliasing ? 1 : 0 );
+    streamer.writeFloat( fBitCrushLfoWaveform );
+    streamer.writeFloat( fModLfoRate );
+    streamer.writeFloat( fModLfoDepth );
+    streamer.writeFloat( fEnvelopeDepth );
+    streamer.writeFloat( fOversampling );
+    streamer.writeInt32( fLinearPhase ? 1 : 0 );
+    streamer.writeInt32( fEcoMode ? 1 : 0 );
+    streamer.writeFloat( fConvolutionMix );
+    streamer.writeFloat( fDelayTime );
+    streamer.writeFloat( fDelayFeedback );
+    streamer.writeFloat( fDelayMix );
+    streamer.writeFloat( fChorusRate );
+    streamer.writeFloat( fChorusDepth );
+    streamer.writeFloat( fDelayInterpolation );
+    streamer.writeFloat( fLowCut );
+    streamer.writeFloat( fHighCut );
+    streamer.writeFloat( fSaturation );
+    streamer.writeFloat( fSaturationCurve );
+    streamer.writeFloat( fBands );
+    streamer.writeFloat( fCrossover1 );
+    streamer.writeFloat( fCrossover2 );
+    streamer.writeFloat( fCrossover3 );
+    streamer.writeFloat( fBand1Resolution );
+    streamer.writeFloat( fBand2Resolution );
+    streamer.writeFloat( fBand3Resolution );
+    streamer.writeFloat( fBand4Resolution );
+    streamer.writeFloat( fBand1Decimation );
+    streamer.writeFloat( fBand2Decimation );
+    streamer.writeFloat( fBand3Decimation );
+    streamer.writeFloat( fBand4Decimation );
+    streamer.writeFloat( fReverbMix );
+    streamer.writeFloat( fReverbSize );
+    streamer.writeFloat( fReverbDecay );
+    streamer.writeFloat( fReverbDamping );
+    streamer.writeFloat( fSpectralMagnitude );
+    streamer.writeFloat( fSpectralPhase );
+    streamer.writeFloat( fSpectralMix );
+    streamer.writeFloat( fSpectralSize );
+    streamer.writeFloat( fSidechainDucking );
+    streamer.writeFloat( fSidechainCrush );
+    streamer.writeFloat( fSequencerCrush );
+    streamer.writeFloat( fSequencerMix );
+    streamer.writeFloat( fSequencerSteps );
+    streamer.writeFloat( fSequencerPattern );
+    streamer.writeFloat( fSequencerGlide );
+    streamer.writeInt32( fStutter ? 1 : 0 );
+    streamer.writeFloat( fStutterLength );
 
 // --- AUTO-GENERATED GETSTATE END
 
@@ -369,16 +1064,26 @@ tresult PLUGIN_API __PLUGIN_NAME__::setupProcessing( ProcessSetup& newSetup )
     currentProcessMode = newSetup.processMode;
 
     VST::SAMPLE_RATE = newSetup.sampleRate;
+    VST::BUFFER_SIZE = newSetup.maxSamplesPerBlock;
 
     // spotted to fire multiple times...
 
     if ( pluginProcess != nullptr )
         delete pluginProcess;
 
-    // TODO: creating a bunch of extra channels for no apparent reason?
-    // get the correct channel amount and don't allocate more than necessary...
-    pluginProcess = new PluginProcess( 6 );
+    // size the processors for the negotiated arrangement of the main bus (see setBusArrangements())
+
+    int32 amountOfChannels = 2;
+    AudioBus* bus = FCast<AudioBus>( audioInputs.at( 0 ));
+    if ( bus ) {
+        amountOfChannels = std::max( 1, SpeakerArr::getChannelCount( bus->getArrangement() ));
+    }
+    pluginProcess = new PluginProcess( amountOfChannels );
 
+    // restore the impulse response (resampled to the new sample rate)
+    if ( !impulseResponsePath.empty() ) {
+        pluginProcess->convolver->loadImpulseResponse( impulseResponsePath.c_str() );
+    }
     syncModel();
 
     return AudioEffect::setupProcessing( newSetup );
@@ -388,57 +1093,92 @@ tresult PLUGIN_API __PLUGIN_NAME__::setupProcessing( ProcessSetup& newSetup )
 tresult PLUGIN_API __PLUGIN_NAME__::setBusArrangements( SpeakerArrangement* inputs,  int32 numIns,
                                                  SpeakerArrangement* outputs, int32 numOuts )
 {
-    bool isMonoInOut   = SpeakerArr::getChannelCount( inputs[ 0 ]) == 1 && SpeakerArr::getChannelCount( outputs[ 0 ]) == 1;
-    bool isStereoInOut = SpeakerArr::getChannelCount( inputs[ 0 ]) == 2 && SpeakerArr::getChannelCount( outputs[ 0 ]) == 2;
+    if ( numIns < 1 || numOuts < 1 ) {
+        return kResultFalse;
+    }
+    int32 amountOfChannels = SpeakerArr::getChannelCount( inputs[ 0 ]);
+
+    bool isMonoInOut   = amountOfChannels == 1 && SpeakerArr::getChannelCount( outputs[ 0 ]) == 1;
+    bool isStereoInOut = amountOfChannels == 2 && SpeakerArr::getChannelCount( outputs[ 0 ]) == 2;
 #ifdef BUILD_AUDIO_UNIT
     if ( !isMonoInOut && !isStereoInOut ) {
         return AudioEffect::setBusArrangements( inputs, numIns, outputs, numOuts ); // solves auval 4099 error
     }
 #endif
-    if ( numIns == 1 && numOuts == 1 )
+    // the second input (when requested) is the sidechain, which can be mono or stereo
+
+    SpeakerArrangement sidechain = SpeakerArr::kStereo;
+    if ( numIns == 2 && SpeakerArr::getChannelCount( inputs[ 1 ]) <= 2 ) {
+        sidechain = inputs[ 1 ];
+    }
+    AudioBus* sidechainBus = audioInputs.size() > 1 ? FCast<AudioBus>( audioInputs.at( 1 )) : nullptr;
+    bool isSidechainChanged = sidechainBus == nullptr || sidechainBus->getArrangement() != sidechain;
+
+    // any layout up to VST::MAX_CHANNELS (e.g. 7.1.4) is supported, as long as input and output match
+    // the optional wet and dry outputs (when requested) follow the main output
+
+    bool isMatchingLayout = inputs[ 0 ] == outputs[ 0 ] && amountOfChannels > 0 && amountOfChannels <= VST::MAX_CHANNELS;
+    for ( int32 i = 1; i < numOuts; ++i ) {
+        isMatchingLayout = isMatchingLayout && outputs[ i ] == outputs[ 0 ];
+    }
+
+    AudioBus* bus = FCast<AudioBus>( audioInputs.at( 0 ));
+    if ( !bus ) {
+        return kResultFalse;
+    }
+
+    if (( numIns == 1 || numIns == 2 ) && numOuts >= 1 && numOuts <= 3 && isMatchingLayout )
     {
-        if ( isMonoInOut ) {
-            AudioBus* bus = FCast<AudioBus>( audioInputs.at( 0 ));
-            if ( bus ) {
-                // check if we are Mono => Mono, if not we need to recreate the buses
-                if ( bus->getArrangement() != inputs[ 0 ])
-                {
-                    removeAudioBusses();
-                    addAudioInput ( STR16( "Mono In" ),  inputs[ 0 ] );
-                    addAudioOutput( STR16( "Mono Out" ), outputs[ 0 ] );
-                }
-                return kResultOk;
-            }
-        }
-        // the host wants something else than Mono => Mono, in this case we are always Stereo => Stereo
-        else
+        // recreate the buses when the arrangement differs from the current one
+        if ( bus->getArrangement() != inputs[ 0 ] || isSidechainChanged )
         {
-            AudioBus* bus = FCast<AudioBus>( audioInputs.at( 0 ));
-            if ( bus ) {
-                // the host wants 2->2 (could be LsRs -> LsRs)
-                if ( isStereoInOut )
-                {
-                    removeAudioBusses();
-                    addAudioInput  ( STR16( "Stereo In"),  inputs[ 0 ] );
-                    addAudioOutput ( STR16( "Stereo Out"), outputs[ 0 ]);
-                    
-                    return kResultTrue;
-                }
-                // the host want something different than 1->1 or 2->2 : in this case we want stereo
-                // (and return false to indicate that the host request could not be satisfied)
-                else if ( bus->getArrangement() != SpeakerArr::kStereo )
-                {
-                    removeAudioBusses();
-                    addAudioInput ( STR16( "Stereo In"),  SpeakerArr::kStereo );
-                    addAudioOutput( STR16( "Stereo Out"), SpeakerArr::kStereo );
-                }
-                return kResultFalse;
+            removeAudioBusses();
+            if ( isMonoInOut ) {
+                addAudioInput ( STR16( "Mono In" ),  inputs[ 0 ] );
+                addAudioOutput( STR16( "Mono Out" ), outputs[ 0 ] );
+            } else if ( isStereoInOut ) {
+                addAudioInput ( STR16( "Stereo In" ),  inputs[ 0 ] );
+                addAudioOutput( STR16( "Stereo Out" ), outputs[ 0 ] );
+            } else {
+                addAudioInput ( STR16( "Multichannel In" ),  inputs[ 0 ] );
+                addAudioOutput( STR16( "Multichannel Out" ), outputs[ 0 ] );
             }
+            addSidechainInput( sidechain );
+            addAuxiliaryOutputs( outputs[ 0 ] );
         }
+        return kResultTrue;
+    }
+
+    // the host wants something we can't provide (e.g. differing in- and output layouts) : in this case
+    // we want stereo (and return false to indicate that the host request could not be satisfied)
+
+    if ( bus->getArrangement() != SpeakerArr::kStereo )
+    {
+        removeAudioBusses();
+        addAudioInput ( STR16( "Stereo In"),  SpeakerArr::kStereo );
+        addAudioOutput( STR16( "Stereo Out"), SpeakerArr::kStereo );
+        addSidechainInput( SpeakerArr::kStereo );
+        addAuxiliaryOutputs( SpeakerArr::kStereo );
     }
     return kResultFalse;
 }
 
+//------------------------------------------------------------------------
+void __PLUGIN_NAME__::addSidechainInput( SpeakerArrangement arrangement )
+{
+    // auxiliary bus, not active by default (the host activates it once it is routed)
+    addAudioInput( STR16( "Sidechain In" ), arrangement, kAux, 0 );
+}
+
+//------------------------------------------------------------------------
+void __PLUGIN_NAME__::addAuxiliaryOutputs( SpeakerArrangement arrangement )
+{
+    // auxiliary buses carrying the wet signal and the (latency compensated) dry signal at unity gain separately,
+    // not active by default (the host activates them once they are routed)
+    addAudioOutput( STR16( "Wet Out" ), arrangement, kAux, 0 );
+    addAudioOutput( STR16( "Dry Out" ), arrangement, kAux, 0 );
+}
+
 //------------------------------------------------------------------------
 tresult PLUGIN_API __PLUGIN_NAME__::canProcessSampleSize( int32 symbolicSampleSize )
 {
@@ -452,6 +1192,15 @@ tresult PLUGIN_API __PLUGIN_NAME__::canProcessSampleSize( int32 symbolicSampleSi
     return kResultFalse;
 }
 
+//------------------------------------------------------------------------
+uint32 PLUGIN_API __PLUGIN_NAME__::getLatencySamples()
+{
+    if ( pluginProcess == nullptr )
+        return 0;
+
+    return ( uint32 ) pluginProcess->getLatencySamples();
+}
+
 //------------------------------------------------------------------------
 tresult PLUGIN_API __PLUGIN_NAME__::notify( IMessage* message )
 {
@@ -474,18 +1223,244 @@ tresult PLUGIN_API __PLUGIN_NAME__::notify( IMessage* message )
         }
     }
 
+    if ( !strcmp( message->getMessageID(), "ImpulseResponse" ))
+    {
+        // the UI requests loading of an impulse response file (attribute holds the UTF-8 encoded path)
+        // we are in UI thread, the impulse response is picked up by the convolver in the next process cycle
+        const void* data;
+        uint32 size;
+        if ( message->getAttributes()->getBinary( "path", data, size ) == kResultOk )
+        {
+            impulseResponsePath.assign(( const char* ) data, size );
+
+            if ( pluginProcess != nullptr ) {
+                pluginProcess->convolver->loadImpulseResponse( impulseResponsePath.c_str() );
+            }
+            return kResultOk;
+        }
+    }
+
     return AudioEffect::notify( message );
 }
 
-void __PLUGIN_NAME__::syncModel()
+uint32 __PLUGIN_NAME__::getModelGroups( ParamID id )
+{
+    // the groups of processors that are affected by a change of given parameter
+    switch ( id )
+    {
+        case kBitDepthId:
+        case kBitCrushLfoId:
+        case kBitCrushLfoDepthId:
+        case kBitCrushLfoWaveformId:
+        case kDecimationId:
+        case kDecimationLfoDepthId:
+        case kDitherId:
+        case kNoiseShapingId:
+        case kAntiAliasingId:
+            return GROUP_CRUSHER;
+
+        case kBand1ResolutionId:
+        case kBand2ResolutionId:
+        case kBand3ResolutionId:
+        case kBand4ResolutionId:
+        case kBand1DecimationId:
+        case kBand2DecimationId:
+        case kBand3DecimationId:
+        case kBand4DecimationId:
+            return GROUP_BANDS;
+
+        case kBandsId:
+        case kCrossover1Id:
+        case kCrossover2Id:
+        case kCrossover3Id:
+            return GROUP_CROSSOVER;
+
+        case kModLfoRateId:
+        case kModLfoDepthId:
+        case kEnvelopeDepthId:
+        case kSidechainCrushId:
+        case kSequencerCrushId:
+        case kSequencerMixId:
+        case kSequencerGlideId:
+            return GROUP_MODULATION;
+
+        case kSequencerStepsId:
+        case kSequencerPatternId:
+            return GROUP_SEQUENCER;
+
+        case kStutterLengthId:
+            return GROUP_STUTTER;
+
+        case kSidechainDuckingId:
+            return GROUP_DUCKING;
+
+        case kOutputWordLengthId:
+            return GROUP_OUTPUT;
+
+        case kOversamplingId:
+        case kLinearPhaseId:
+        case kEcoModeId:
+            return GROUP_OVERSAMPLING;
+
+        case kSaturationId:
+        case kSaturationCurveId:
+            return GROUP_SATURATION;
+
+        case kSpectralMagnitudeId:
+        case kSpectralPhaseId:
+        case kSpectralMixId:
+        case kSpectralSizeId:
+            return GROUP_SPECTRAL;
+
+        case kLowCutId:
+        case kHighCutId:
+            return GROUP_TONE;
+
+        case kDelayTimeId:
+        case kDelayFeedbackId:
+        case kDelayMixId:
+        case kChorusRateId:
+        case kChorusDepthId:
+        case kDelayInterpolationId:
+            return GROUP_DELAY;
+
+        case kConvolutionMixId:
+            return GROUP_CONVOLUTION;
+
+        case kReverbMixId:
+        case kReverbSizeId:
+        case kReverbDecayId:
+        case kReverbDampingId:
+            return GROUP_REVERB;
+
+        case kWetMixId:
+        case kDryMixId:
+            return GROUP_MIX;
+
+        // the bypass and stutter engagement are applied at their sample offset in process()
+        default:
+            return 0;
+    }
+}
+
+void __PLUGIN_NAME__::syncModel( uint32 groups )
 {
     // forward the protected model values onto the plugin process and related processors
     // NOTE: when dealing with "bool"-types, use Calc::toBool() to determine on/off
-    pluginProcess->bitCrusher->setAmount( fBitDepth );
-    pluginProcess->bitCrusher->setLFO( fBitCrushLfo, fBitCrushLfoDepth );
+    MultibandCrusher* multibandCrusher = pluginProcess->multibandCrusher;
+    if ( groups & GROUP_CRUSHER ) {
+        pluginProcess->bitCrusher->setAmount( fBitDepth );
+        pluginProcess->bitCrusher->setLFO( fBitCrushLfo, fBitCrushLfoDepth );
+        pluginProcess->bitCrusher->lfo->setWaveform(( WaveTable::Waveform ) round( fBitCrushLfoWaveform * ( WaveTable::AMOUNT_OF_WAVEFORMS - 1 )));
+        pluginProcess->bitCrusher->setDecimation( fDecimation );
+        pluginProcess->bitCrusher->setDecimationLFO( fDecimationLfoDepth );
+        pluginProcess->bitCrusher->setDither( fNoiseShaping ? Dither::NOISE_SHAPED : fDither ? Dither::TPDF : Dither::OFF );
+        pluginProcess->bitCrusher->setAntiAliasing( fAntiAliasing );
+        // multiband crushing: the bands share the settings of the full band crusher
+        // apart from their resolution and downsampling, which are set per band
+        multibandCrusher->setLFO( fBitCrushLfo, fBitCrushLfoDepth );
+        multibandCrusher->lfo->setWaveform( pluginProcess->bitCrusher->lfo->getWaveform() );
+        multibandCrusher->setDecimationLFO( fDecimationLfoDepth );
+        multibandCrusher->setDither( fNoiseShaping ? Dither::NOISE_SHAPED : fDither ? Dither::TPDF : Dither::OFF );
+        multibandCrusher->setAntiAliasing( fAntiAliasing );
+    }
+    if ( groups & GROUP_BANDS ) {
+        const float bandResolutions[] = { fBand1Resolution, fBand2Resolution, fBand3Resolution, fBand4Resolution };
+        const float bandDecimations[] = { fBand1Decimation, fBand2Decimation, fBand3Decimation, fBand4Decimation };
+        for ( int b = 0; b < Crossover::MAX_BANDS; ++b ) {
+            multibandCrusher->setAmount( b, bandResolutions[ b ]);
+            multibandCrusher->setDecimation( b, bandDecimations[ b ]);
+        }
+    }
+    if ( groups & GROUP_CROSSOVER ) {
+        pluginProcess->crossover->setFrequency( 0, 40.f * powf( 400.f, fCrossover1 ));
+        pluginProcess->crossover->setFrequency( 1, 40.f * powf( 400.f, fCrossover2 ));
+        pluginProcess->crossover->setFrequency( 2, 40.f * powf( 400.f, fCrossover3 ));
+        pluginProcess->setAmountOfBands( 1 + ( int ) round( fBands * 3.f ));
+    }
+    // modulation matrix: the mod LFO moves the downsampling, the input envelope reduces the resolution
+    ModulationMatrix* matrix    = pluginProcess->modulationMatrix;
+    StepSequencer*    sequencer = matrix->getSequencer();
+    if ( groups & GROUP_MODULATION ) {
+        matrix->getLFO( 0 )->setRate( VST::MIN_LFO_RATE() + fModLfoRate * ( VST::MAX_LFO_RATE() - VST::MIN_LFO_RATE() ));
+        matrix->setRoute( 0, ModulationMatrix::LFO_1, kDecimationId, fModLfoRate > 0.f ? fModLfoDepth : 0.f );
+        matrix->setRoute( 1, ModulationMatrix::ENVELOPE_1, kBitDepthId, -fEnvelopeDepth );
+        // sidechain: its envelope reduces the resolution (keyed crushing) and the limiter ducks the wet signal
+        matrix->setRoute( 2, ModulationMatrix::ENVELOPE_2, kBitDepthId, -fSidechainCrush );
+        // step sequencer: lowers the resolution and crossfades between the wet and dry signal
+        sequencer->setGlide( fSequencerGlide );
+        matrix->setRoute( 3, ModulationMatrix::SEQUENCER, kBitDepthId, -fSequencerCrush );
+        matrix->setRoute( 4, ModulationMatrix::SEQUENCER, kWetMixId, fSequencerMix );
+        matrix->setRoute( 5, ModulationMatrix::SEQUENCER, kDryMixId, -fSequencerMix );
+    }
+    if ( groups & GROUP_SEQUENCER ) {
+        sequencer->setAmountOfSteps( StepSequencer::MIN_STEPS * ( 1 + ( int ) round( fSequencerSteps * 3.f )));
+        sequencer->generatePattern( 1 + ( uint32 ) round( fSequencerPattern * 63.f ));
+    }
+    // beat repeat
+    if ( groups & GROUP_STUTTER ) {
+        pluginProcess->setStutterLength(( PluginProcess::StutterLength ) round( fStutterLength * ( PluginProcess::AMOUNT_OF_STUTTER_LENGTHS - 1 )));
+        pluginProcess->stutter->setEngaged( fStutter || _heldNotes > 0 ); // notes engage the stutter as well (see process())
+    }
+    if ( groups & GROUP_DUCKING ) {
+        pluginProcess->setSidechainDucking( fSidechainDucking );
+    }
+    // final word length reduction (noise shaped dither down to 16-bits)
+    if ( groups & GROUP_OUTPUT ) {
+        pluginProcess->outputDither->setMode( Dither::NOISE_SHAPED );
+        pluginProcess->setOutputBitDepth( fOutputWordLength ? 16 : 0 );
+    }
+    if ( groups & GROUP_OVERSAMPLING ) {
+        // oversampling of the bit crusher (1x, 2x, 4x or 8x)
+        pluginProcess->setOversampling(
+            1 << ( int ) round( fOversampling * 3.f ),
+            fLinearPhase ? HalfBandFilter::LINEAR_PHASE : HalfBandFilter::MINIMUM_PHASE
+        );
+        // reduced internal rate for the wet chain on high rate sessions
+        pluginProcess->setEcoMode( fEcoMode );
+    }
+    // saturation prior to the bit crusher
+    if ( groups & GROUP_SATURATION ) {
+        pluginProcess->waveshaper->setCurve(( Waveshaper::Curve ) round( fSaturationCurve * ( Waveshaper::AMOUNT_OF_CURVES - 1 )));
+        pluginProcess->waveshaper->setDrive( fSaturation );
+    }
+    // spectral bit reduction
+    if ( groups & GROUP_SPECTRAL ) {
+        pluginProcess->spectralCrusher->setFrameSize( STFT::MIN_SIZE << ( int ) round( fSpectralSize * 4.f ));
+        pluginProcess->spectralCrusher->setMagnitudeResolution( fSpectralMagnitude );
+        pluginProcess->spectralCrusher->setPhaseResolution( fSpectralPhase );
+        pluginProcess->spectralCrusher->setMix( fSpectralMix );
+    }
+    // tone shaping
+    if ( groups & GROUP_TONE ) {
+        pluginProcess->setToneFilter( fLowCut, fHighCut );
+    }
+    // delay line
+    if ( groups & GROUP_DELAY ) {
+        pluginProcess->setDelayTime(( PluginProcess::DelayTime ) round( fDelayTime * ( PluginProcess::AMOUNT_OF_DELAY_TIMES - 1 )));
+        pluginProcess->delayLine->setFeedback( fDelayFeedback );
+        pluginProcess->delayLine->setMix( fDelayMix );
+        pluginProcess->delayLine->setModulation(
+            VST::MIN_LFO_RATE() + fChorusRate * ( VST::MAX_LFO_RATE() - VST::MIN_LFO_RATE() ), fChorusDepth * DelayLine::MAX_MODULATION_TIME
+        );
+        pluginProcess->delayLine->setInterpolation(( DelayLine::Interpolation ) round( fDelayInterpolation * 2.f ));
+    }
+    // post mix convolution
+    if ( groups & GROUP_CONVOLUTION ) {
+        pluginProcess->convolver->setMix( fConvolutionMix );
+    }
+    // post mix reverb
+    if ( groups & GROUP_REVERB ) {
+        pluginProcess->reverb->setSize( fReverbSize );
+        pluginProcess->reverb->setDecay( fReverbDecay );
+        pluginProcess->reverb->setDamping( fReverbDamping );
+        pluginProcess->reverb->setMix( fReverbMix );
+    }
     // output mix
-    pluginProcess->setDryMix( fDryMix );
-    pluginProcess->setWetMix( fWetMix );
+    if ( groups & GROUP_MIX ) {
+        pluginProcess->setDryMix( fDryMix );
+        pluginProcess->setWetMix( fWetMix );
+    }
 }
 
 }
@@ -26,6 +26,8 @@
 #include "public.sdk/source/vst/vstaudioeffect.h"
 #include "plugin_process.h"
 #include "global.h"
+#include <string>
+#include <vector>
 
 using namespace Steinberg::Vst;
 
@@ -79,6 +81,9 @@ class __PLUGIN_NAME__ : public AudioEffect
         /** Asks if a given sample size is supported see \ref SymbolicSampleSizes. */
         tresult PLUGIN_API canProcessSampleSize( int32 symbolicSampleSize ) SMTG_OVERRIDE;
 
+        /** Reports the delay introduced by the processing (e.g. oversampling) */
+        uint32 PLUGIN_API getLatencySamples() SMTG_OVERRIDE;
+
         /** We want to receive message. */
         tresult PLUGIN_API notify( IMessage* message ) SMTG_OVERRIDE;
 
@@ -94,6 +99,59 @@ class __PLUGIN_NAME__ : public AudioEffect
         float fBitCrushLfoDepth = 0.f;    // Bit crush LFO depth
         float fWetMix = 1.f;    // Wet mix
         float fDryMix = 0.f;    // Dry mix
+        float fDecimation = 0.f;    // Downsampling
+        float fDecimationLfoDepth = 0.f;    // Downsampling LFO depth
+        bool fDither = false;    // Dither
+        bool fNoiseShaping = false;    // Noise shaping
+        bool fOutputWordLength = false;    // 16-bit output
+        bool fAntiAliasing = false;    // Anti-aliasing
+        float fBitCrushLfoWaveform = 0.f;    // Bit crush LFO waveform
+        float fModLfoRate = 0.f;    // Mod LFO rate
+        float fModLfoDepth = 0.f;    // Mod LFO to downsampling
+        float fEnvelopeDepth = 0.f;    // Envelope to resolution
+        float fOversampling = 0.f;    // Oversampling
+        bool fLinearPhase = true;    // Linear phase
+        bool fEcoMode = false;    // Eco mode
+        float fConvolutionMix = 0.f;    // Convolution mix
+        float fDelayTime = 0.f;    // Delay time
+        float fDelayFeedback = 0.f;    // Delay feedback
+        float fDelayMix = 0.f;    // Delay mix
+        float fChorusRate = 0.f;    // Delay modulation rate
+        float fChorusDepth = 0.f;    // Delay modulation depth
+        float fDelayInterpolation = 0.f;    // Delay interpolation
+        float fLowCut = 0.f;    // Low cut
+        float fHighCut = 1.f;    // High cut
+        float fSaturation = 0.f;    // Saturation
+        float fSaturationCurve = 0.f;    // Saturation curve
+        float fBands = 0.f;    // Crusher bands
+        float fCrossover1 = 0.27f;    // Crossover 1
+        float fCrossover2 = 0.54f;    // Crossover 2
+        float fCrossover3 = 0.81f;    // Crossover 3
+        float fBand1Resolution = 1.f;    // Band 1 resolution
+        float fBand2Resolution = 1.f;    // Band 2 resolution
+        float fBand3Resolution = 1.f;    // Band 3 resolution
+        float fBand4Resolution = 1.f;    // Band 4 resolution
+        float fBand1Decimation = 0.f;    // Band 1 downsampling
+        float fBand2Decimation = 0.f;    // Band 2 downsampling
+        float fBand3Decimation = 0.f;    // Band 3 downsampling
+        float fBand4Decimation = 0.f;    // Band 4 downsampling
+        float fReverbMix = 0.f;    // Reverb mix
+        float fReverbSize = 0.5f;    // Reverb size
+        float fReverbDecay = 0.5f;    // Reverb decay
+        float fReverbDamping = 0.5f;    // Reverb damping
+        float fSpectralMagnitude = 1.f;    // Spectral magnitude resolution
+        float fSpectralPhase = 1.f;    // Spectral phase resolution
+        float fSpectralMix = 1.f;    // Spectral crusher mix
+        float fSpectralSize = 0.75f;    // Spectral frame size
+        float fSidechainDucking = 0.f;    // Sidechain ducking
+        float fSidechainCrush = 0.f;    // Sidechain to resolution
+        float fSequencerCrush = 0.f;    // Sequencer to resolution
+        float fSequencerMix = 0.f;    // Sequencer to mix
+        float fSequencerSteps = 0.f;    // Sequencer steps
+        float fSequencerPattern = 0.f;    // Sequencer pattern
+        float fSequencerGlide = 0.f;    // Sequencer glide
+        bool fStutter = false;    // Stutter
+        float fStutterLength = 0.5f;    // Stutter length
 
 // --- AUTO-GENERATED END
 
@@ -102,9 +160,64 @@ class __PLUGIN_NAME__ : public AudioEffect
         int32 currentProcessMode;
         Igorski::PluginProcess* pluginProcess;
 
-        // synchronize the processors model with UI led changes
-
-        void syncModel();
+        std::string impulseResponsePath; // last impulse response requested by the UI
+
+        // parameter changes and events (note on/off) of the current process cycle, merged into
+        // a single timeline ordered by sample offset (see collectTimeline())
+
+        struct TimelineEvent {
+            enum Type {
+                PARAMETER = 0,
+                NOTE_ON,
+                NOTE_OFF
+            };
+            int32 sampleOffset;
+            Type type;
+            int32 id;    // ParamID for PARAMETER, pitch for notes
+            float value; // normalized value for PARAMETER, velocity for notes
+        };
+        static constexpr size_t MAX_TIMELINE_EVENTS = 1024; // further changes within a single cycle are dropped
+
+        std::vector<TimelineEvent> _timeline;
+        std::vector<TimelineEvent> _mergeBuffer; // scratch space for ordering the timeline
+        int32 _heldNotes = 0; // notes engage the stutter for as long as they are held
+
+        void collectTimeline( ProcessData& data );
+
+        // synchronize the processors model with UI led changes. As a single automated parameter
+        // can change every process cycle, the model is divided into groups of related processors
+        // so only the groups affected by the changed parameters are updated (see getModelGroups())
+
+        enum ModelGroup {
+            GROUP_CRUSHER      = 1 << 0,  // full band and multiband crusher (shared settings)
+            GROUP_BANDS        = 1 << 1,  // per band resolution and downsampling
+            GROUP_CROSSOVER    = 1 << 2,  // crossover frequencies and amount of bands
+            GROUP_MODULATION   = 1 << 3,  // modulation routes, mod LFO rate and sequencer glide
+            GROUP_SEQUENCER    = 1 << 4,  // sequencer steps and pattern
+            GROUP_STUTTER      = 1 << 5,
+            GROUP_DUCKING      = 1 << 6,
+            GROUP_OUTPUT       = 1 << 7,  // output word length
+            GROUP_OVERSAMPLING = 1 << 8,  // oversampling factor, filter phase and eco mode
+            GROUP_SATURATION   = 1 << 9,
+            GROUP_SPECTRAL     = 1 << 10,
+            GROUP_TONE         = 1 << 11,
+            GROUP_DELAY        = 1 << 12,
+            GROUP_CONVOLUTION  = 1 << 13,
+            GROUP_REVERB       = 1 << 14,
+            GROUP_MIX          = 1 << 15,
+            ALL_GROUPS         = ( 1 << 16 ) - 1
+        };
+        static uint32 getModelGroups( ParamID id );
+
+        void syncModel( uint32 groups = ALL_GROUPS );
+
+        // (re)create the optional sidechain input bus (inactive by default) for given arrangement
+
+        void addSidechainInput( SpeakerArrangement arrangement );
+
+        // (re)create the optional wet and dry output buses (inactive by default) for given arrangement
+
+        void addAuxiliaryOutputs( SpeakerArrangement arrangement );
 };
 
 }
@@ -0,0 +1,328 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "wavefile.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Igorski {
+
+/* MappedFile */
+
+#ifdef _WIN32
+
+MappedFile::MappedFile( const char* path )
+{
+    _data    = nullptr;
+    _size    = 0;
+    _mapping = nullptr;
+    _file    = CreateFileA( path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+
+    if ( _file == INVALID_HANDLE_VALUE ) {
+        _file = nullptr;
+        return;
+    }
+
+    LARGE_INTEGER size;
+    if ( !GetFileSizeEx( _file, &size ) || size.QuadPart == 0 ) {
+        return;
+    }
+    _mapping = CreateFileMappingA( _file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+
+    if ( _mapping != nullptr ) {
+        _data = ( const uint8_t* ) MapViewOfFile( _mapping, FILE_MAP_READ, 0, 0, 0 );
+        _size = _data != nullptr ? ( size_t ) size.QuadPart : 0;
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if ( _data != nullptr ) {
+        UnmapViewOfFile( _data );
+    }
+    if ( _mapping != nullptr ) {
+        CloseHandle( _mapping );
+    }
+    if ( _file != nullptr ) {
+        CloseHandle( _file );
+    }
+}
+
+#else
+
+MappedFile::MappedFile( const char* path )
+{
+    _data = nullptr;
+    _size = 0;
+
+    int file = open( path, O_RDONLY );
+    if ( file < 0 ) {
+        return;
+    }
+
+    struct stat info;
+    if ( fstat( file, &info ) == 0 && info.st_size > 0 )
+    {
+        void* data = mmap( nullptr, ( size_t ) info.st_size, PROT_READ, MAP_PRIVATE, file, 0 );
+        if ( data != MAP_FAILED ) {
+            _data = ( const uint8_t* ) data;
+            _size = ( size_t ) info.st_size;
+        }
+    }
+    close( file ); // the mapping remains valid after closing the descriptor
+}
+
+MappedFile::~MappedFile()
+{
+    if ( _data != nullptr ) {
+        munmap(( void* ) _data, _size );
+    }
+}
+
+#endif
+
+bool MappedFile::isOpen()
+{
+    return _data != nullptr;
+}
+
+const uint8_t* MappedFile::getData()
+{
+    return _data;
+}
+
+size_t MappedFile::getSize()
+{
+    return _size;
+}
+
+/* WaveFile */
+
+namespace WaveFile {
+
+    static const uint16_t FORMAT_PCM        = 1;
+    static const uint16_t FORMAT_FLOAT      = 3;
+    static const uint16_t FORMAT_EXTENSIBLE = 0xFFFE;
+
+    // RIFF is little endian, read byte-wise to remain independent of alignment and host endianness
+
+    static inline uint32_t readUInt32( const uint8_t* data )
+    {
+        return ( uint32_t ) data[ 0 ] | (( uint32_t ) data[ 1 ] << 8 ) | (( uint32_t ) data[ 2 ] << 16 ) | (( uint32_t ) data[ 3 ] << 24 );
+    }
+
+    static inline uint16_t readUInt16( const uint8_t* data )
+    {
+        return ( uint16_t ) ( data[ 0 ] | ( data[ 1 ] << 8 ));
+    }
+
+    static inline uint32_t readUInt24( const uint8_t* data )
+    {
+        return ( uint32_t ) data[ 0 ] | (( uint32_t ) data[ 1 ] << 8 ) | (( uint32_t ) data[ 2 ] << 16 );
+    }
+
+    static inline float readSample( const uint8_t* data, uint16_t format, int bytesPerSample )
+    {
+        if ( format == FORMAT_FLOAT ) {
+            uint32_t bits = readUInt32( data );
+            float value;
+            std::memcpy( &value, &bits, sizeof( float ));
+            return value;
+        }
+
+        switch ( bytesPerSample ) {
+            default:
+            case 2:
+                return ( float ) ( int16_t ) readUInt16( data ) / 32768.f;
+            case 3:
+                // shift the 24-bit value into the upper bits of a 32-bit integer to preserve the sign
+                return ( float ) ( int32_t ) ( readUInt24( data ) << 8 ) / 2147483648.f;
+            case 4:
+                return ( float ) ( int32_t ) readUInt32( data ) / 2147483648.f;
+        }
+    }
+
+    // windowed sinc interpolation, the kernel (a Blackman windowed sinc spanning SINC_ZERO_CROSSINGS
+    // on either side of its center) is tabulated at SINC_RESOLUTION points per zero crossing
+
+    static constexpr int SINC_ZERO_CROSSINGS = 16;
+    static constexpr int SINC_RESOLUTION     = 512;
+
+    static const float* getSincTable()
+    {
+        // created once (thread safe as per C++11 static initialization), has a guard entry for the interpolation
+
+        static const std::vector<float> table = []() {
+            int size = SINC_ZERO_CROSSINGS * SINC_RESOLUTION;
+            std::vector<float> values( size + 2, 0.f );
+
+            for ( int i = 0; i <= size; ++i ) {
+                double x      = ( double ) i / SINC_RESOLUTION;
+                double sinc   = ( i == 0 ) ? 1.0 : sin( M_PI * x ) / ( M_PI * x );
+                double phase  = M_PI * ( 1.0 + x / SINC_ZERO_CROSSINGS ); // the window is centered on the kernel
+                double window = .42 - .5 * cos( phase ) + .08 * cos( 2.0 * phase );
+
+                values[ i ] = ( float ) ( sinc * window );
+            }
+            return values;
+        }();
+        return table.data();
+    }
+
+    /**
+     * resample given source (spanning sourceLength samples) into given output (spanning outputLength samples)
+     * where ratio is the amount of source samples per output sample. When decimating, the kernel is widened
+     * so its cutoff lies at the output's Nyquist frequency, preventing aliasing. The output is scaled by the
+     * ratio so the sum of its samples is preserved (e.g. an impulse response retains its level when
+     * convolving at the output rate)
+     */
+    static void resample( const float* source, int sourceLength, float* output, int outputLength, double ratio )
+    {
+        const float* table = getSincTable();
+
+        double cutoff     = std::min( 1.0, 1.0 / ratio ); // relative to the source's Nyquist frequency
+        double halfWidth  = SINC_ZERO_CROSSINGS / cutoff; // in source samples
+        double tableScale = cutoff * SINC_RESOLUTION;     // table entries per source sample
+        double tableEnd   = SINC_ZERO_CROSSINGS * SINC_RESOLUTION;
+        float gain        = ( float ) ( cutoff * ratio );
+
+        for ( int i = 0; i < outputLength; ++i )
+        {
+            double position = i * ratio;
+            int first       = std::max( 0, ( int ) ceil( position - halfWidth ));
+            int last        = std::min( sourceLength - 1, ( int ) floor( position + halfWidth ));
+
+            float sum = 0.f;
+
+            for ( int k = first; k <= last; ++k )
+            {
+                double tablePosition = fabs( k - position ) * tableScale;
+
+                if ( tablePosition >= tableEnd ) {
+                    continue;
+                }
+                int index      = ( int ) tablePosition;
+                float fraction = ( float ) ( tablePosition - index );
+                float weight   = table[ index ] + ( table[ index + 1 ] - table[ index ]) * fraction;
+
+                sum += source[ k ] * weight;
+            }
+            output[ i ] = sum * gain;
+        }
+    }
+
+    AudioBuffer* load( const char* path, float sampleRate, int maxLength )
+    {
+        MappedFile file( path );
+
+        if ( !file.isOpen() || file.getSize() < 12 ) {
+            return nullptr;
+        }
+
+        const uint8_t* data = file.getData();
+        size_t size         = file.getSize();
+
+        if ( std::memcmp( data, "RIFF", 4 ) != 0 || std::memcmp( data + 8, "WAVE", 4 ) != 0 ) {
+            return nullptr;
+        }
+
+        // traverse the chunks for the format and sample data
+
+        uint16_t format = 0, amountOfChannels = 0, bitsPerSample = 0;
+        uint32_t fileSampleRate = 0;
+        const uint8_t* samples  = nullptr;
+        size_t samplesSize      = 0;
+
+        for ( size_t offset = 12; offset + 8 <= size; )
+        {
+            const uint8_t* chunk = data + offset;
+            size_t chunkSize     = std::min(( size_t ) readUInt32( chunk + 4 ), size - offset - 8 );
+
+            if ( std::memcmp( chunk, "fmt ", 4 ) == 0 && chunkSize >= 16 ) {
+                format           = readUInt16( chunk + 8 );
+                amountOfChannels = readUInt16( chunk + 10 );
+                fileSampleRate   = readUInt32( chunk + 12 );
+                bitsPerSample    = readUInt16( chunk + 22 );
+
+                // the actual format of an extensible file is described by the first two bytes of its sub format GUID
+                if ( format == FORMAT_EXTENSIBLE && chunkSize >= 40 ) {
+                    format = readUInt16( chunk + 32 );
+                }
+            }
+            else if ( std::memcmp( chunk, "data", 4 ) == 0 ) {
+                samples     = chunk + 8;
+                samplesSize = chunkSize;
+            }
+            offset += 8 + chunkSize + ( chunkSize & 1 ); // chunks are word aligned
+        }
+
+        int bytesPerSample = bitsPerSample / 8;
+        bool isSupported   = ( format == FORMAT_PCM   && bytesPerSample >= 2 && bytesPerSample <= 4 ) ||
+                             ( format == FORMAT_FLOAT && bytesPerSample == 4 );
+
+        if ( samples == nullptr || !isSupported || amountOfChannels == 0 || fileSampleRate == 0 ) {
+            return nullptr;
+        }
+
+        int frameSize        = bytesPerSample * amountOfChannels;
+        int amountOfFrames   = ( int ) ( samplesSize / frameSize );
+        double ratio         = ( double ) fileSampleRate / sampleRate; // source frames per output sample
+        int length           = std::min( maxLength, ( int ) floor(( amountOfFrames - 1 ) / ratio ) + 1 );
+
+        if ( amountOfFrames == 0 || length <= 0 ) {
+            return nullptr;
+        }
+
+        AudioBuffer* buffer = new AudioBuffer( amountOfChannels, length );
+        std::vector<float> source( amountOfFrames );
+
+        for ( int c = 0; c < amountOfChannels; ++c )
+        {
+            float* channelBuffer = buffer->getBufferForChannel( c );
+            const uint8_t* channelSamples = samples + c * bytesPerSample;
+
+            for ( int i = 0; i < amountOfFrames; ++i ) {
+                source[ i ] = readSample( channelSamples + ( size_t ) i * frameSize, format, bytesPerSample );
+            }
+
+            if ( ratio == 1.0 ) {
+                std::copy( source.begin(), source.begin() + length, channelBuffer );
+            } else {
+                resample( source.data(), amountOfFrames, channelBuffer, length, ratio );
+            }
+        }
+        return buffer;
+    }
+}
+
+}
@@ -0,0 +1,71 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __WAVEFILE_H_INCLUDED__
+#define __WAVEFILE_H_INCLUDED__
+
+#include "audiobuffer.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Igorski {
+/**
+ * Read-only memory mapping of a file, the mapping is released upon destruction
+ */
+class MappedFile
+{
+    public:
+        MappedFile( const char* path );
+        ~MappedFile();
+
+        bool isOpen();
+        const uint8_t* getData();
+        size_t getSize();
+
+    private:
+        const uint8_t* _data;
+        size_t _size;
+#ifdef _WIN32
+        void* _file;
+        void* _mapping;
+#endif
+};
+
+/**
+ * Reads RIFF WAVE files (16, 24 and 32-bit integer PCM and 32-bit floating point,
+ * including WAVE_FORMAT_EXTENSIBLE) through a memory mapping. As this allocates
+ * memory and performs file I/O, it must not be used on the audio thread.
+ */
+namespace WaveFile {
+
+    /**
+     * read the file at given path into a newly allocated AudioBuffer (ownership passes to the caller)
+     * the contents are resampled (windowed sinc interpolation) when the file's sample rate differs from
+     * given sampleRate and truncated to maxLength samples. As the file is expected to hold an impulse
+     * response, resampled contents are scaled by the ratio of the rates to retain their level when
+     * convolved. Returns nullptr when the file could not be read.
+     */
+    AudioBuffer* load( const char* path, float sampleRate, int maxLength );
+}
+}
+
+#endif
@@ -0,0 +1,215 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#include "waveshaper.h"
+#include "calc.h"
+#include "fastmath.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Igorski {
+
+// linearly interpolated table lookup, input beyond the table range is clamped onto its outer values
+// (the table has a guard entry so index + 1 is valid at the upper bound)
+
+static inline float lookup( const float* table, float value )
+{
+    const float scale = ( float ) ( Waveshaper::TABLE_SIZE - 1 ) / ( 2.f * Waveshaper::TABLE_RANGE );
+    const float max   = ( float ) ( Waveshaper::TABLE_SIZE - 1 );
+
+    float position = std::min( max, std::max( 0.f, ( value + Waveshaper::TABLE_RANGE ) * scale ));
+    int index      = ( int ) position;
+    float fraction = position - ( float ) index;
+
+    return table[ index ] + ( table[ index + 1 ] - table[ index ]) * fraction;
+}
+
+/* constructor / destructor */
+
+Waveshaper::Waveshaper( int amountOfChannels )
+{
+    _dcInput.resize( amountOfChannels, 0.f );
+    _dcOutput.resize( amountOfChannels, 0.f );
+
+    _curve = TANH;
+    _drive = 0.f;
+
+    _rateRatio = 0.f;
+    setProcessingRate( 1.f );
+
+    cacheGain();
+}
+
+Waveshaper::~Waveshaper()
+{
+
+}
+
+/* public methods */
+
+Waveshaper::Curve Waveshaper::getCurve()
+{
+    return _curve;
+}
+
+void Waveshaper::setCurve( Curve value )
+{
+    if ( value == _curve ) {
+        return;
+    }
+    _curve = value;
+
+    cacheGain();
+}
+
+float Waveshaper::getDrive()
+{
+    return _drive;
+}
+
+void Waveshaper::setDrive( float value )
+{
+    if ( value == _drive ) {
+        return;
+    }
+    _drive = Calc::cap( value );
+
+    cacheGain();
+}
+
+bool Waveshaper::isActive()
+{
+    return _drive > 0.f;
+}
+
+void Waveshaper::setProcessingRate( float ratio )
+{
+    if ( ratio == _rateRatio ) {
+        return;
+    }
+    _rateRatio   = ratio;
+    _dcBlockPole = expf( -VST::TWO_PI * DC_BLOCK_FREQUENCY / ( VST::SAMPLE_RATE * ratio ));
+}
+
+void Waveshaper::process( AudioBuffer* buffer, int bufferSize )
+{
+    int amountOfChannels = std::min( buffer->amountOfChannels, ( int ) _dcInput.size() );
+
+    float inputGain  = _inputGain;
+    float outputGain = _outputGain;
+
+    for ( int c = 0; c < amountOfChannels; ++c )
+    {
+        float* channelBuffer = buffer->getBufferForChannel( c );
+
+        if ( _curve == CUBIC )
+        {
+            // f( x ) = 1.5x - 0.5x^3 for |x| <= 1 (the clamped input yields +-1 beyond)
+
+            for ( int i = 0; i < bufferSize; ++i ) {
+                float x = std::min( 1.f, std::max( -1.f, channelBuffer[ i ] * inputGain ));
+                channelBuffer[ i ] = ( 1.5f * x - .5f * x * x * x ) * outputGain;
+            }
+            continue;
+        }
+
+        const float* table = getTable( _curve );
+
+        for ( int i = 0; i < bufferSize; ++i ) {
+            channelBuffer[ i ] = lookup( table, channelBuffer[ i ] * inputGain ) * outputGain;
+        }
+
+        if ( _curve == TUBE )
+        {
+            float pole       = _dcBlockPole;
+            float lastInput  = _dcInput[ c ];
+            float lastOutput = _dcOutput[ c ];
+
+            for ( int i = 0; i < bufferSize; ++i ) {
+                float input = channelBuffer[ i ];
+                lastOutput  = input - lastInput + pole * lastOutput;
+                lastInput   = input;
+                channelBuffer[ i ] = lastOutput;
+            }
+            _dcInput[ c ]  = lastInput;
+            _dcOutput[ c ] = lastOutput;
+        }
+    }
+}
+
+/* private methods */
+
+const float* Waveshaper::getTable( Curve curve )
+{
+    // the tables are created once (thread safe as per C++11 static initialization)
+
+    static const std::vector<float> tables = []()
+    {
+        std::vector<float> data( AMOUNT_OF_CURVES * ( TABLE_SIZE + 1 ), 0.f );
+
+        double tubeOffset = tanh( TUBE_BIAS );
+
+        for ( int i = 0; i <= TABLE_SIZE; ++i )
+        {
+            int index = std::min( i, TABLE_SIZE - 1 ); // guard entry repeats the last value
+            double x  = -TABLE_RANGE + 2.0 * TABLE_RANGE * index / ( TABLE_SIZE - 1 );
+
+            data[ TANH * ( TABLE_SIZE + 1 ) + i ] = ( float ) tanh( x );
+            data[ TUBE * ( TABLE_SIZE + 1 ) + i ] = ( float ) ( tanh( x + TUBE_BIAS ) - tubeOffset );
+        }
+        return data;
+    }();
+
+    return &tables[ curve * ( TABLE_SIZE + 1 )];
+}
+
+float Waveshaper::shape( float value )
+{
+    if ( _curve == CUBIC ) {
+        float x = std::min( 1.f, std::max( -1.f, value ));
+        return 1.5f * x - .5f * x * x * x;
+    }
+    return lookup( getTable( _curve ), value );
+}
+
+void Waveshaper::cacheGain()
+{
+    _inputGain = Calc::dbToLinear( _drive * MAX_DRIVE );
+
+    // normalize onto the largest output for a full scale input (either polarity for the asymmetrical curve)
+
+    float peak      = std::max( fabsf( shape( _inputGain )), fabsf( shape( -_inputGain )));
+    float peakGain  = peak > 0.f ? 1.f / peak : 1.f;
+
+    // normalize onto the slope of the curve around zero (measured across a table step), e.g. unity small-signal gain
+
+    float step      = TABLE_RANGE / ( float ) ( TABLE_SIZE - 1 );
+    float slope     = ( shape( step ) - shape( -step )) / ( 2.f * step ) * _inputGain;
+    float slopeGain = slope > 0.f ? 1.f / slope : 1.f;
+
+    // as the stage is bypassed without drive, low drive amounts keep the small-signal gain at unity, moving
+    // (in the dB domain) towards the full scale normalization as the drive increases
+
+    _outputGain = slopeGain * powf( peakGain / slopeGain, _drive );
+}
+
+}
@@ -0,0 +1,100 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __WAVESHAPER_H_INCLUDED__
+#define __WAVESHAPER_H_INCLUDED__
+
+#include "audiobuffer.h"
+#include <vector>
+
+namespace Igorski {
+/**
+ * Saturation by means of a static transfer curve, a softer alternative to Calc::capSample().
+ *
+ * The tanh and tube curves are baked into a lookup table (shared by all instances) which is
+ * read with linear interpolation, the cubic curve is a polynomial evaluated directly. Both are
+ * evaluated per block in branchless loops the compiler can vectorize. The drive boosts the
+ * input into the curve while the output is normalized so a full scale input remains at full scale.
+ * At low drive the normalization keeps the small-signal gain at unity instead, so engaging the
+ * stage doesn't jump in level (the normalization moves from one to the other as the drive increases).
+ */
+class Waveshaper
+{
+    public:
+        enum Curve {
+            TANH = 0, // symmetrical, odd harmonics
+            CUBIC,    // symmetrical soft clip, hard knee at full scale
+            TUBE      // asymmetrical, adds even harmonics
+        };
+
+        static constexpr int AMOUNT_OF_CURVES = 3;
+        static constexpr int TABLE_SIZE       = 2048;
+        static constexpr float TABLE_RANGE    = 4.f;  // the tables span the -TABLE_RANGE to +TABLE_RANGE input range
+        static constexpr float MAX_DRIVE      = 24.f; // in dB
+
+        Waveshaper( int amountOfChannels );
+        ~Waveshaper();
+
+        Curve getCurve();
+        void setCurve( Curve value );
+
+        // drive in the 0 - 1 range (0 being 0 dB and bypassing the stage, 1 being MAX_DRIVE)
+
+        float getDrive();
+        void setDrive( float value );
+
+        bool isActive();
+
+        // ratio of the processing rate to the host rate (see BitCrusher::setProcessingRate())
+
+        void setProcessingRate( float ratio );
+
+        void process( AudioBuffer* buffer, int bufferSize );
+
+    private:
+        Curve _curve;
+        float _drive;
+        float _inputGain;
+        float _outputGain;
+
+        // the tube curve is biased, its DC offset is removed per channel
+
+        std::vector<float> _dcInput;
+        std::vector<float> _dcOutput;
+
+        static constexpr float TUBE_BIAS          = .3f;
+        static constexpr float DC_BLOCK_FREQUENCY = 30.f; // in Hz
+
+        float _rateRatio;
+        float _dcBlockPole; // derived from DC_BLOCK_FREQUENCY for the processing rate
+
+        static const float* getTable( Curve curve );
+
+        // evaluate the transfer curve for a single value (used for normalization)
+
+        float shape( float value );
+
+        void cacheGain();
+};
+}
+
+#endif
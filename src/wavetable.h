@@ -0,0 +1,147 @@
+/**
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2024 Igor Zinken - https://www.igorski.nl
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+#ifndef __WAVETABLE_H_INCLUDED__
+#define __WAVETABLE_H_INCLUDED__
+
+#include <stdint.h>
+
+/**
+ * wave tables for the oscillators, the tables are generated at compile time
+ * (e.g. they are constant data within the binary and require no initialization)
+ */
+namespace Igorski {
+namespace WaveTable {
+
+    enum Waveform {
+        SINE = 0,
+        TRIANGLE,
+        SAWTOOTH,
+        SQUARE,
+        SAMPLE_AND_HOLD,
+        AMOUNT_OF_WAVEFORMS
+    };
+
+    // std::sin is not constexpr, this evaluates the Taylor series on the -PI to +PI range instead
+
+    constexpr double sine( double x )
+    {
+        const double pi = 3.14159265358979323846;
+
+        // wrap into the -PI to +PI range
+
+        long long periods = ( long long ) ( x / ( 2.0 * pi ));
+        x -= periods * 2.0 * pi;
+        if ( x > pi )  x -= 2.0 * pi;
+        if ( x < -pi ) x += 2.0 * pi;
+
+        double term   = x;
+        double result = x;
+
+        for ( int n = 1; n < 12; ++n ) {
+            term   *= -x * x / (( 2 * n ) * ( 2 * n + 1 ));
+            result += term;
+        }
+        return result;
+    }
+
+    constexpr int log2( int value )
+    {
+        int result = 0;
+        while ( value > 1 ) {
+            value >>= 1;
+            ++result;
+        }
+        return result;
+    }
+
+    /**
+     * A Bank holds a table of SIZE entries for each Waveform
+     * each table is padded with one leading and two trailing guard points which
+     * wrap around the cycle, so interpolation can read neighbouring points without masking
+     */
+    template <int SIZE>
+    class Bank
+    {
+        static_assert(( SIZE & ( SIZE - 1 )) == 0, "wave table size must be a power of two" );
+
+        public:
+            static constexpr int TABLE_SIZE     = SIZE;
+            static constexpr int TABLE_SIZE_LOG = log2( SIZE );
+            static constexpr int GUARD_POINTS   = 3;
+            static constexpr int STRIDE         = SIZE + GUARD_POINTS;
+
+            // amount of distinct steps within a cycle of the sample and hold waveform
+            static constexpr int SAMPLE_AND_HOLD_STEPS = 16;
+
+            constexpr Bank() : _tables()
+            {
+                uint32_t seed = 0x1234567; // LCG used to generate the sample and hold steps
+                float heldValue = 0.f;
+
+                for ( int i = 0; i < SIZE; ++i )
+                {
+                    double phase = ( double ) i / SIZE;
+
+                    _tables[ SINE * STRIDE + 1 + i ] = ( float ) sine( phase * 2.0 * 3.14159265358979323846 );
+
+                    _tables[ TRIANGLE * STRIDE + 1 + i ] = ( float ) (
+                        phase < .25 ? 4.0 * phase : phase < .75 ? 2.0 - 4.0 * phase : 4.0 * phase - 4.0
+                    );
+
+                    _tables[ SAWTOOTH * STRIDE + 1 + i ] = ( float ) ( 2.0 * phase - 1.0 );
+                    _tables[ SQUARE   * STRIDE + 1 + i ] = phase < .5 ? 1.f : -1.f;
+
+                    if (( i % ( SIZE / SAMPLE_AND_HOLD_STEPS )) == 0 ) {
+                        seed      = seed * 1664525u + 1013904223u;
+                        heldValue = ( float ) (( seed >> 8 ) / 8388608.0 - 1.0 ); // upper 24 bits to -1 to +1 range
+                    }
+                    _tables[ SAMPLE_AND_HOLD * STRIDE + 1 + i ] = heldValue;
+                }
+
+                // guard points
+
+                for ( int w = 0; w < AMOUNT_OF_WAVEFORMS; ++w )
+                {
+                    float* table = &_tables[ w * STRIDE + 1 ];
+
+                    table[ -1 ]       = table[ SIZE - 1 ];
+                    table[ SIZE ]     = table[ 0 ];
+                    table[ SIZE + 1 ] = table[ 1 ];
+                }
+            }
+
+            // retrieve the table for given waveform, the table can be
+            // read at indices -1 to SIZE + 1 (inclusive) for interpolation
+
+            constexpr const float* get( Waveform waveform ) const
+            {
+                return &_tables[ waveform * STRIDE + 1 ];
+            }
+
+        private:
+            float _tables[ AMOUNT_OF_WAVEFORMS * STRIDE ];
+    };
+}
+}
+
+#endif